@@ -6,6 +6,7 @@
  * - 1-factor full bandwidth test
  * - fcc Broadcast
  * - fcc PrefixSum
+ * - Dispatcher latency with many idle connections
  *
  * Part of Project Thrill - http://project-thrill.org
  *
@@ -23,6 +24,9 @@
 #include <thrill/common/stats_timer.hpp>
 #include <thrill/common/string.hpp>
 #include <thrill/net/dispatcher.hpp>
+#include <thrill/net/tcp/connection.hpp>
+#include <thrill/net/tcp/epoll_dispatcher.hpp>
+#include <thrill/net/tcp/select_dispatcher.hpp>
 
 #include <iostream>
 #include <string>
@@ -880,6 +884,114 @@ protected:
     unsigned int max_limit_active_ = 512;
 };
 
+/******************************************************************************/
+//! measure the latency of a single ready connection in a tcp::Dispatcher with
+//! many idle connections, comparing select() and epoll().
+
+class DispatchLatency
+{
+public:
+    int Run(int argc, char* argv[]) {
+
+        common::CmdlineParser clp;
+
+        clp.AddUInt('c', "connections", connections_,
+                    "Number of idle connections watched, default: 1000");
+
+        clp.AddUInt('r', "inner_repeats", inner_repeats_,
+                    "Number of ping messages per experiment, default: 10000");
+
+        clp.AddUInt('R', "outer_repeats", outer_repeats_,
+                    "Repeat whole experiment a number of times.");
+
+        if (!clp.Process(argc, argv)) return -1;
+
+        for (size_t outer = 0; outer < outer_repeats_; ++outer) {
+            if (2 * connections_ + 8 < FD_SETSIZE) {
+                net::tcp::SelectDispatcher dispatcher(mem_manager_);
+                Test(dispatcher, "select");
+            }
+            else {
+                LOG1 << "skipping select(), too many file descriptors";
+            }
+#if THRILL_HAVE_NET_EPOLL
+            {
+                net::tcp::EpollDispatcher dispatcher(mem_manager_);
+                Test(dispatcher, "epoll");
+            }
+#endif
+        }
+        return 0;
+    }
+
+    void Test(net::Dispatcher& dispatcher, const char* name) {
+
+        // create idle connections, each waiting for one byte.
+        std::vector<net::tcp::Connection> idle;
+        std::vector<net::tcp::Socket> idle_peers;
+        idle.reserve(connections_);
+
+        for (size_t i = 0; i < connections_; ++i) {
+            std::pair<net::tcp::Socket, net::tcp::Socket> sp =
+                net::tcp::Socket::CreatePair();
+            idle.emplace_back(std::move(sp.first));
+            idle_peers.emplace_back(std::move(sp.second));
+            dispatcher.AsyncRead(idle.back(), 1, net::AsyncReadBufferCallback());
+        }
+
+        // create one active connection for ping messages
+        std::pair<net::tcp::Socket, net::tcp::Socket> sp =
+            net::tcp::Socket::CreatePair();
+        net::tcp::Connection active(std::move(sp.first));
+        net::tcp::Socket sender = std::move(sp.second);
+
+        size_t received = 0;
+        common::StatsTimerStopped t;
+
+        t.Start();
+        for (size_t inner = 0; inner < inner_repeats_; ++inner) {
+            dispatcher.AsyncRead(
+                active, 1,
+                [&received](net::Connection&, net::Buffer&&) { ++received; });
+
+            char c = 0;
+            die_unless(sender.send(&c, 1) == 1);
+
+            while (received != inner + 1)
+                dispatcher.Dispatch();
+        }
+        t.Stop();
+
+        for (net::tcp::Connection& c : idle)
+            dispatcher.Cancel(c);
+        dispatcher.Cancel(active);
+
+        std::cout
+            << "RESULT"
+            << " benchmark=" << benchmark
+            << " dispatcher=" << name
+            << " connections=" << connections_
+            << " inner_repeats=" << inner_repeats_
+            << " time[us]=" << t.Microseconds()
+            << " latency[us]="
+            << static_cast<double>(t.Microseconds()) / inner_repeats_
+            << std::endl;
+    }
+
+private:
+    //! memory manager for dispatchers
+    mem::Manager mem_manager_ { nullptr, "DispatchLatency" };
+
+    //! number of idle connections
+    unsigned int connections_ = 1000;
+
+    //! whole experiment
+    unsigned int outer_repeats_ = 1;
+
+    //! inner repetitions
+    unsigned int inner_repeats_ = 10000;
+};
+
 /******************************************************************************/
 
 void Usage(const char* argv0) {
@@ -893,6 +1005,7 @@ void Usage(const char* argv0) {
         << "    allreduce  - FCC PrefixSum operation" << std::endl
         << "    rblocks    - random block transmissions" << std::endl
         << "    rblocks_series - series of rblocks experiments" << std::endl
+        << "    dispatch   - dispatcher latency with idle connections" << std::endl
         << std::endl;
 }
 
@@ -926,6 +1039,9 @@ int main(int argc, char** argv) {
     else if (benchmark == "rblocks_series") {
         return RandomBlocksSeries().Run(argc - 1, argv + 1);
     }
+    else if (benchmark == "dispatch") {
+        return DispatchLatency().Run(argc - 1, argv + 1);
+    }
     else {
         Usage(argv[0]);
         return -1;
@@ -31,6 +31,10 @@ struct Record {
     bool operator < (const Record& b) const {
         return std::lexicographical_compare(key, key + 10, b.key, b.key + 10);
     }
+
+    //! method and key length used by Sort() to select radix sort
+    static constexpr size_t radix_depth = 10;
+    const uint8_t& at_radix(size_t depth) const { return key[depth]; }
     friend std::ostream& operator << (std::ostream& os, const Record& c) {
         return os << common::Hexdump(c.key, 10);
     }
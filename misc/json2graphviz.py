@@ -57,6 +57,7 @@ for ni, n in nodes.items():
        label == "ReduceToIndex" or \
        label == "GroupByKey" or \
        label == "GroupToIndex" or \
+       label == "InnerJoin" or \
        label == "Merge" or \
        label == "Sort" or \
        label == "Window" or \
@@ -64,6 +65,7 @@ for ni, n in nodes.items():
         sys.stdout.write("colorscheme=accent5, style=filled, color=2, shape=box")
 
     if label == "AllGather" or \
+       label == "BroadcastHashTable" or \
        label == "Gather" or \
        label == "Size" or \
        label == "AllReduce" or \
@@ -21,6 +21,7 @@
 #include <cstdlib>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace thrill; // NOLINT
@@ -123,6 +124,103 @@ TEST(GroupByNode, Median) {
     api::RunLocalTests(start_func);
 }
 
+TEST(GroupByNode, HashGroupSum) {
+
+    auto start_func =
+        [](Context& ctx) {
+            size_t n = 100000;
+            static constexpr size_t m = 1000;
+
+            using IntPair = std::pair<size_t, size_t>;
+
+            auto sizets = Generate(ctx, n);
+
+            auto modulo_keyfn = [](size_t in) { return (in % m); };
+
+            auto sum_fn =
+                [](auto& r, size_t key) {
+                    size_t res = 0;
+                    while (r.HasNext()) {
+                        size_t n = r.Next();
+                        res += n;
+                    }
+                    return IntPair(key, res);
+                };
+
+            // group by hashing to compute sum and gather results
+            auto reduced = sizets.GroupByKey<IntPair>(
+                HashGroupTag, modulo_keyfn, sum_fn);
+            std::vector<IntPair> out_vec = reduced.AllGather();
+            std::sort(out_vec.begin(), out_vec.end());
+
+            // compute vector with expected results
+            std::vector<size_t> res_vec(m, 0);
+            for (size_t t = 0; t < n; ++t) {
+                res_vec[t % m] += t;
+            }
+
+            ASSERT_EQ(m, out_vec.size());
+            for (size_t i = 0; i < m; ++i) {
+                ASSERT_EQ(i, out_vec[i].first);
+                ASSERT_EQ(res_vec[i], out_vec[i].second);
+            }
+        };
+
+    api::RunLocalTests(start_func);
+
+    // run with little RAM for DIANodes such that the items are spilled
+    api::MemoryConfig mem_config;
+    mem_config.verbose_ = false;
+    mem_config.setup(4 * 1024 * 1024 * 1024llu);
+    mem_config.ram_workers_ = 2 * 1024 * 1024llu;
+
+    api::RunLocalMock(mem_config, 1, 1, start_func);
+    api::RunLocalMock(mem_config, 2, 3, start_func);
+}
+
+TEST(GroupByNode, HashGroupFrequentKey) {
+
+    auto start_func =
+        [](Context& ctx) {
+            size_t n = 200000;
+
+            using IntPair = std::pair<size_t, size_t>;
+
+            auto sizets = Generate(ctx, n);
+
+            // half of the items have key zero, which cannot be partitioned
+            auto skewed_keyfn = [](size_t in) { return in % 2 ? in : 0; };
+
+            auto count_fn =
+                [](auto& r, size_t key) {
+                    size_t count = 0;
+                    while (r.HasNext()) {
+                        r.Next();
+                        ++count;
+                    }
+                    return IntPair(key, count);
+                };
+
+            auto grouped = sizets.GroupByKey<IntPair>(
+                HashGroupTag, skewed_keyfn, count_fn);
+            std::vector<IntPair> out_vec = grouped.AllGather();
+            std::sort(out_vec.begin(), out_vec.end());
+
+            ASSERT_EQ(n / 2 + 1, out_vec.size());
+            ASSERT_EQ(IntPair(0, n / 2), out_vec[0]);
+            for (size_t i = 1; i < out_vec.size(); ++i)
+                ASSERT_EQ(IntPair(2 * i - 1, 1), out_vec[i]);
+        };
+
+    // run with little RAM for DIANodes such that the items are spilled
+    api::MemoryConfig mem_config;
+    mem_config.verbose_ = false;
+    mem_config.setup(4 * 1024 * 1024 * 1024llu);
+    mem_config.ram_workers_ = 2 * 1024 * 1024llu;
+
+    api::RunLocalMock(mem_config, 1, 2, start_func);
+}
+
 TEST(GroupByNode, GroupToIndexCorrectResults) {
 
     auto start_func =
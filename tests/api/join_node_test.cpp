@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * tests/api/join_node_test.cpp
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <thrill/api/all_gather.hpp>
+#include <thrill/api/broadcast_join.hpp>
+#include <thrill/api/generate.hpp>
+#include <thrill/api/inner_join.hpp>
+#include <thrill/api/semi_join_filter.hpp>
+#include <thrill/api/size.hpp>
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace thrill; // NOLINT
+
+using IntPair = std::pair<size_t, size_t>;
+using IntTriple = std::tuple<size_t, size_t, size_t>;
+
+//! Join (i % mod1, i) with (j % mod2, j) and compare against a nested loop join
+static void TestJoinModulo(Context& ctx, size_t n1, size_t mod1,
+                           size_t n2, size_t mod2) {
+
+    auto input1 = Generate(
+        ctx, n1, [mod1](size_t i) { return IntPair(i % mod1, i); });
+
+    auto input2 = Generate(
+        ctx, n2, [mod2](size_t j) { return IntPair(j % mod2, j); });
+
+    auto joined = input1.InnerJoin(
+        input2,
+        [](const IntPair& p) { return p.first; },
+        [](const IntPair& p) { return p.first; },
+        [](const IntPair& a, const IntPair& b) {
+            return IntTriple(a.first, a.second, b.second);
+        });
+
+    std::vector<IntTriple> out_vec = joined.AllGather();
+    std::sort(out_vec.begin(), out_vec.end());
+
+    // calculate correct result with a nested loop join
+    std::vector<IntTriple> check_vec;
+    for (size_t i = 0; i < n1; ++i) {
+        for (size_t j = 0; j < n2; ++j) {
+            if (i % mod1 == j % mod2)
+                check_vec.emplace_back(i % mod1, i, j);
+        }
+    }
+    std::sort(check_vec.begin(), check_vec.end());
+
+    ASSERT_EQ(check_vec.size(), out_vec.size());
+    ASSERT_EQ(check_vec, out_vec);
+}
+
+TEST(JoinNode, OneToOne) {
+
+    auto start_func =
+        [](Context& ctx) {
+            TestJoinModulo(ctx, 1000, 1000, 800, 800);
+        };
+
+    api::RunLocalTests(start_func);
+}
+
+TEST(JoinNode, ManyToMany) {
+
+    auto start_func =
+        [](Context& ctx) {
+            TestJoinModulo(ctx, 400, 37, 300, 50);
+        };
+
+    api::RunLocalTests(start_func);
+}
+
+TEST(JoinNode, EmptyInput) {
+
+    auto start_func =
+        [](Context& ctx) {
+            TestJoinModulo(ctx, 0, 1, 300, 50);
+            TestJoinModulo(ctx, 300, 50, 0, 1);
+        };
+
+    api::RunLocalTests(start_func);
+}
+
+TEST(JoinNode, SortMergeFallback) {
+
+    auto start_func =
+        [](Context& ctx) {
+            static constexpr size_t test_size = 100000;
+
+            auto input1 = Generate(
+                ctx, test_size,
+                [](size_t i) { return IntPair(i / 2, i); });
+
+            auto input2 = Generate(
+                ctx, test_size,
+                [](size_t i) { return IntPair(i, i); });
+
+            // each key of input2 in [0, test_size / 2) matches two items
+            auto joined = input1.InnerJoin(
+                input2,
+                [](const IntPair& p) { return p.first; },
+                [](const IntPair& p) { return p.first; },
+                [](const IntPair& a, const IntPair& b) {
+                    return IntPair(a.second, b.second);
+                });
+
+            std::vector<IntPair> out_vec = joined.AllGather();
+            std::sort(out_vec.begin(), out_vec.end());
+
+            ASSERT_EQ(test_size, out_vec.size());
+            for (size_t i = 0; i < out_vec.size(); ++i) {
+                ASSERT_EQ(IntPair(i, i / 2), out_vec[i]);
+            }
+        };
+
+    // run with little RAM for DIANodes such that the build side does not fit
+    api::MemoryConfig mem_config;
+    mem_config.verbose_ = false;
+    mem_config.setup(4 * 1024 * 1024 * 1024llu);
+    mem_config.ram_workers_ = 2 * 1024 * 1024llu;
+
+    api::RunLocalMock(mem_config, 1, 1, start_func);
+    api::RunLocalMock(mem_config, 2, 3, start_func);
+
+    // even less RAM, such that the runs are merged in several passes
+    mem_config.ram_workers_ = 512 * 1024llu;
+    api::RunLocalMock(mem_config, 1, 1, start_func);
+}
+
+TEST(JoinNode, Broadcast) {
+
+    auto start_func =
+        [](Context& ctx) {
+            static constexpr size_t test_size = 10000;
+            static constexpr size_t mod_size = 100;
+
+            auto facts = Generate(
+                ctx, test_size,
+                [](size_t i) { return IntPair(i % (2 * mod_size), i); });
+
+            // dimension table has two entries for all even keys < mod_size
+            auto dimension = Generate(
+                ctx, mod_size,
+                [](size_t i) { return IntPair(i - i % 2, i); });
+
+            auto joined = facts.InnerJoin(
+                BroadcastTag, dimension,
+                [](const IntPair& p) { return p.first; },
+                [](const IntPair& p) { return p.first; },
+                [](const IntPair& a, const IntPair& b) {
+                    return IntTriple(a.first, a.second, b.second);
+                });
+
+            std::vector<IntTriple> out_vec = joined.AllGather();
+            std::sort(out_vec.begin(), out_vec.end());
+
+            std::vector<IntTriple> check_vec;
+            for (size_t i = 0; i < test_size; ++i) {
+                size_t key = i % (2 * mod_size);
+                if (key < mod_size && key % 2 == 0) {
+                    check_vec.emplace_back(key, i, key);
+                    check_vec.emplace_back(key, i, key + 1);
+                }
+            }
+            std::sort(check_vec.begin(), check_vec.end());
+
+            ASSERT_EQ(check_vec.size(), out_vec.size());
+            ASSERT_EQ(check_vec, out_vec);
+        };
+
+    api::RunLocalTests(start_func);
+}
+
+TEST(JoinNode, SemiJoinFilter) {
+
+    auto start_func =
+        [](Context& ctx) {
+            static constexpr size_t test_size = 100000;
+            static constexpr size_t key_size = 1000;
+
+            auto facts = Generate(
+                ctx, test_size,
+                [](size_t i) { return IntPair(i % (10 * key_size), i); });
+
+            // only every tenth key of the facts occurs in the dimension
+            auto dimension = Generate(
+                ctx, key_size,
+                [](size_t i) { return IntPair(10 * i, i); });
+
+            auto filtered = facts.SemiJoinFilter(
+                dimension,
+                [](const IntPair& p) { return p.first; },
+                [](const IntPair& p) { return p.first; });
+
+            std::vector<IntPair> out_vec = filtered.AllGather();
+
+            // all matching items must remain
+            size_t matching = 0;
+            for (const IntPair& p : out_vec) {
+                if (p.first % 10 == 0) ++matching;
+            }
+            ASSERT_EQ(test_size / 10, matching);
+
+            // most non-matching items must have been dropped
+            ASSERT_LT(out_vec.size() - matching, test_size / 10);
+        };
+
+    api::RunLocalTests(start_func);
+}
+
+/******************************************************************************/
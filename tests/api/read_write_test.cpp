@@ -197,6 +197,67 @@ TEST(IO, GenerateIntegerWriteReadBinary) {
         });
 }
 
+#if THRILL_HAVE_MMAP_FILE
+
+TEST(IO, GenerateIntegerWriteReadBinaryMmap) {
+    vfs::TemporaryDirectory tmpdir;
+
+    auto start_func =
+        [&tmpdir](api::Context& ctx) {
+
+            // wipe directory from last test
+            if (ctx.my_rank() == 0) {
+                tmpdir.wipe();
+            }
+            ctx.net.Barrier();
+
+            // generate a dia of integers and write them to disk
+            size_t generate_size = 32000;
+            {
+                auto dia = Generate(
+                    ctx, generate_size,
+                    [](const size_t index) { return index + 42; });
+
+                dia.WriteBinary(tmpdir.get() + "/IntegerBinary",
+                                16 * 1024);
+            }
+            ctx.net.Barrier();
+
+            // read the integers from memory mapped files and compare
+            {
+                size_t total_bytes = ctx.block_pool().total_bytes();
+
+                auto dia = api::ReadBinary<size_t>(
+                    ctx,
+                    tmpdir.get() + "/IntegerBinary*");
+
+                // the mapped blocks are not counted as BlockPool memory
+                ASSERT_LT(0u, ctx.block_pool().mapped_bytes());
+                ASSERT_EQ(total_bytes, ctx.block_pool().total_bytes());
+
+                std::vector<size_t> vec = dia.AllGather();
+
+                ASSERT_EQ(generate_size, vec.size());
+                // read the mapped blocks a second time
+                ASSERT_EQ(generate_size, dia.Size());
+
+                for (size_t i = 0; i < vec.size(); ++i) {
+                    ASSERT_EQ(42 + i, vec[i]);
+                }
+            }
+        };
+
+    api::MemoryConfig mem_config;
+    mem_config.verbose_ = false;
+    mem_config.setup(4 * 1024 * 1024 * 1024llu);
+    mem_config.mmap_read_ = true;
+
+    api::RunLocalMock(mem_config, 1, 2, start_func);
+    api::RunLocalMock(mem_config, 2, 2, start_func);
+}
+
+#endif
+
 #if THRILL_HAVE_ZLIB
 
 TEST(IO, GenerateIntegerWriteReadBinaryCompressed) {
@@ -83,6 +83,8 @@ TEST(ReduceNode, ReduceModulo2CorrectResults) {
         TestReduceModulo2CorrectResults<ReduceTableImpl::BUCKET>());
     api::RunLocalTests(
         TestReduceModulo2CorrectResults<ReduceTableImpl::OLD_PROBING>());
+    api::RunLocalTests(
+        TestReduceModulo2CorrectResults<ReduceTableImpl::SWISS_PROBING>());
 }
 
 //! Test sums of integers 0..n-1 for n=100 in 1000 buckets in the reduce table
@@ -132,6 +134,155 @@ TEST(ReduceNode, ReduceModuloPairsCorrectResults) {
         TestReduceModuloPairsCorrectResults<ReduceTableImpl::BUCKET>());
     api::RunLocalTests(
         TestReduceModuloPairsCorrectResults<ReduceTableImpl::OLD_PROBING>());
+    api::RunLocalTests(
+        TestReduceModuloPairsCorrectResults<ReduceTableImpl::SWISS_PROBING>());
+}
+
+TEST(ReduceNode, ReduceModuloPairsCompressNet) {
+    api::MemoryConfig mem_config;
+    mem_config.verbose_ = false;
+    mem_config.setup(4 * 1024 * 1024 * 1024llu);
+    mem_config.compress_net_ = true;
+
+    auto start_func = [](Context& ctx) {
+                          // streams of DOps compress their network Blocks
+                          data::CatStreamPtr stream = ctx.GetNewCatStream(size_t(0));
+                          ASSERT_TRUE(stream->compress());
+                          stream->Close();
+
+                          TestReduceModuloPairsCorrectResults<
+                              ReduceTableImpl::PROBING>()(ctx);
+                      };
+
+    api::RunLocalMock(mem_config, 2, 2, start_func);
+}
+
+//! ReduceConfig combining the items of all workers on a host before the shuffle
+class HostCombineReduceConfig : public core::DefaultReduceConfig
+{
+public:
+    static constexpr bool use_host_combine_ = true;
+};
+
+TEST(ReduceNode, ReduceModuloPairsHostCombine) {
+    static constexpr size_t test_size = 100000u;
+    static constexpr size_t mod_size = 1000u;
+    static constexpr size_t div_size = test_size / mod_size;
+
+    using IntPair = std::pair<size_t, size_t>;
+
+    auto start_func =
+        [](Context& ctx) {
+            auto integers = Generate(
+                ctx, test_size,
+                [](const size_t& index) {
+                    return IntPair(index % mod_size, index / mod_size);
+                });
+
+            auto add_function = [](const size_t& in1, const size_t& in2) {
+                                    return in1 + in2;
+                                };
+
+            auto reduced = integers.ReducePair(
+                add_function, HostCombineReduceConfig());
+
+            std::vector<IntPair> out_vec = reduced.AllGather();
+            std::sort(out_vec.begin(), out_vec.end());
+
+            ASSERT_EQ(mod_size, out_vec.size());
+            for (size_t i = 0; i < out_vec.size(); ++i) {
+                ASSERT_EQ(i, out_vec[i].first);
+                ASSERT_EQ((div_size * (div_size - 1)) / 2u, out_vec[i].second);
+            }
+
+            // the same with a volatile key
+            auto modulo = Generate(ctx, test_size)
+                          .ReduceByKey(
+                VolatileKeyTag,
+                [](const size_t& in) { return in % mod_size; },
+                add_function, HostCombineReduceConfig());
+
+            std::vector<size_t> sums = modulo.AllGather();
+            std::sort(sums.begin(), sums.end());
+
+            ASSERT_EQ(mod_size, sums.size());
+            for (size_t i = 0; i < sums.size(); ++i) {
+                ASSERT_EQ(i * div_size
+                          + mod_size * (div_size * (div_size - 1)) / 2u,
+                          sums[i]);
+            }
+        };
+
+    api::RunLocalTests(start_func);
+}
+
+//! ReduceConfig spreading hot keys over all workers
+class SkewSplitReduceConfig : public core::DefaultReduceConfig
+{
+public:
+    static constexpr bool use_skew_split_ = true;
+};
+
+TEST(ReduceNode, ReduceModuloPairsSkewSplit) {
+    static constexpr size_t test_size = 100000u;
+    static constexpr size_t mod_size = 1000u;
+
+    using IntPair = std::pair<size_t, size_t>;
+
+    // half of the items have key zero
+    auto key_of = [](const size_t& index) {
+                      return index % 2 == 0 ? 0 : index % mod_size;
+                  };
+
+    std::vector<size_t> expected(mod_size), largest(mod_size);
+    for (size_t i = 0; i < test_size; ++i) {
+        expected[key_of(i)] += i;
+        largest[key_of(i)] = i;
+    }
+
+    auto start_func =
+        [&](Context& ctx) {
+            auto integers = Generate(
+                ctx, test_size,
+                [&](const size_t& index) {
+                    return IntPair(key_of(index), index);
+                });
+
+            auto add_function = [](const size_t& in1, const size_t& in2) {
+                                    return in1 + in2;
+                                };
+
+            auto reduced = integers.ReducePair(
+                add_function, SkewSplitReduceConfig()).Keep();
+
+            // push the data twice to check that hot keys are output once
+            for (size_t round = 0; round < 2; ++round) {
+                std::vector<IntPair> out_vec = reduced.AllGather();
+                std::sort(out_vec.begin(), out_vec.end());
+
+                ASSERT_EQ(mod_size / 2 + 1, out_vec.size());
+                for (const IntPair& p : out_vec)
+                    ASSERT_EQ(expected[p.first], p.second);
+            }
+
+            // the same with a volatile key, keeping the largest item per key
+            auto maxima = Generate(ctx, test_size)
+                          .ReduceByKey(
+                VolatileKeyTag, key_of,
+                [](const size_t& in1, const size_t& in2) {
+                    return std::max(in1, in2);
+                },
+                SkewSplitReduceConfig());
+
+            std::vector<size_t> max_vec = maxima.AllGather();
+            std::sort(max_vec.begin(), max_vec.end());
+
+            ASSERT_EQ(mod_size / 2 + 1, max_vec.size());
+            for (const size_t& m : max_vec)
+                ASSERT_EQ(largest[key_of(m)], m);
+        };
+
+    api::RunLocalTests(start_func);
 }
 
 template <ReduceTableImpl table_impl>
@@ -208,6 +359,8 @@ TEST(ReduceNode, ReduceToIndexCorrectResults) {
         TestReduceToIndexCorrectResults<ReduceTableImpl::BUCKET>());
     api::RunLocalTests(
         TestReduceToIndexCorrectResults<ReduceTableImpl::OLD_PROBING>());
+    api::RunLocalTests(
+        TestReduceToIndexCorrectResults<ReduceTableImpl::SWISS_PROBING>());
 }
 
 /******************************************************************************/
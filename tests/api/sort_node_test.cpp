@@ -11,12 +11,15 @@
 #include <thrill/api/all_gather.hpp>
 #include <thrill/api/generate.hpp>
 #include <thrill/api/read_binary.hpp>
+#include <thrill/api/size.hpp>
 #include <thrill/api/sort.hpp>
+#include <thrill/common/zipf_distribution.hpp>
 
 #include <gtest/gtest.h>
 
 #include <algorithm>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -112,6 +115,198 @@ TEST(Sort, SortRandomIntegersCustomCompareFunction) {
     api::RunLocalTests(start_func);
 }
 
+TEST(Sort, SortRandomIntegersParallel) {
+
+    auto start_func =
+        [](Context& ctx) {
+
+            std::default_random_engine generator(std::random_device { } ());
+            std::uniform_int_distribution<size_t> distribution(0, 10000);
+
+            auto integers = Generate(
+                ctx, 1000000,
+                [&distribution, &generator](const size_t&) -> size_t {
+                    return distribution(generator);
+                });
+
+            auto sorted = integers.Sort(
+                std::less<size_t>(), api::ParallelSortAlgorithm<>(4));
+
+            std::vector<size_t> out_vec = sorted.AllGather();
+
+            for (size_t i = 0; i < out_vec.size() - 1; i++) {
+                ASSERT_FALSE(out_vec[i + 1] < out_vec[i]);
+            }
+
+            ASSERT_EQ(1000000u, out_vec.size());
+        };
+
+    api::RunLocalTests(start_func);
+}
+
+TEST(Sort, ParallelSortAlgorithmThreads) {
+    const size_t cores = std::max<size_t>(
+        1, std::thread::hardware_concurrency());
+
+    // by default, the cores are divided among the workers of the host
+    api::ParallelSortAlgorithm<> automatic;
+    ASSERT_EQ(cores, automatic.num_threads());
+    automatic.set_workers_per_host(2 * cores);
+    ASSERT_EQ(1u, automatic.num_threads());
+
+    // an explicit number of threads is kept
+    api::ParallelSortAlgorithm<> fixed(4);
+    fixed.set_workers_per_host(2 * cores);
+    ASSERT_EQ(4u, fixed.num_threads());
+
+    // only merging the chunks of multiple threads needs a buffer
+    using String = std::string;
+    ASSERT_FALSE((api::SortAlgorithmBufferNeeded<String, std::less<String> >(
+                      automatic, 0)));
+    ASSERT_TRUE((api::SortAlgorithmBufferNeeded<String, std::less<String> >(
+                     fixed, 0)));
+
+    // the ThreadPool is reused for all runs
+    std::vector<size_t> v(4 * api::ParallelSortAlgorithm<>::min_chunk_size);
+    for (size_t r = 0; r < 3; ++r) {
+        for (size_t i = 0; i < v.size(); ++i)
+            v[i] = (i * 7919 + r) % 1000;
+        fixed(v.begin(), v.end(), std::less<size_t>());
+        ASSERT_TRUE(std::is_sorted(v.begin(), v.end()));
+    }
+}
+
+TEST(Sort, SortRandomIntegersMultipleRuns) {
+
+    auto start_func =
+        [](Context& ctx) {
+
+            std::default_random_engine generator(std::random_device { } ());
+            std::uniform_int_distribution<size_t> distribution(0, 100000);
+
+            auto integers = Generate(
+                ctx, 4000000,
+                [&distribution, &generator](const size_t&) -> size_t {
+                    return distribution(generator);
+                });
+
+            auto sorted = integers.Sort();
+
+            // push data twice to check merged runs are kept
+            ASSERT_EQ(4000000u, sorted.Keep().Size());
+
+            std::vector<size_t> out_vec = sorted.AllGather();
+
+            for (size_t i = 0; i < out_vec.size() - 1; i++) {
+                ASSERT_FALSE(out_vec[i + 1] < out_vec[i]);
+            }
+
+            ASSERT_EQ(4000000u, out_vec.size());
+        };
+
+    // run with little RAM for DIANodes such that multiple runs are merged
+    api::MemoryConfig mem_config;
+    mem_config.verbose_ = false;
+    mem_config.setup(4 * 1024 * 1024 * 1024llu);
+    mem_config.ram_workers_ = 16 * 1024 * 1024llu;
+
+    api::RunLocalMock(mem_config, 1, 1, start_func);
+    api::RunLocalMock(mem_config, 1, 2, start_func);
+}
+
+TEST(Sort, SortRandomIntegersDescending) {
+
+    // the radix sort's buffer is subtracted from the run capacity
+    static_assert(
+        api::SortAlgorithmUsesBuffer<
+            api::DefaultSortAlgorithm, int64_t, std::greater<int64_t> >::value,
+        "radix sort of integers should use a buffer");
+    static_assert(
+        api::SortAlgorithmUsesBuffer<
+            api::ParallelSortAlgorithm<>, int64_t, std::less<int64_t> >::value,
+        "parallel radix sort of integers should use a buffer");
+    static_assert(
+        api::SortAlgorithmUsesBuffer<
+            api::ParallelSortAlgorithm<>, std::string, std::less<std::string> >
+        ::value, "merging the parallel sort's chunks should use a buffer");
+    static_assert(
+        !api::SortAlgorithmUsesBuffer<
+            api::DefaultSortAlgorithm, std::string, std::less<std::string> >
+        ::value, "std::sort should not use a buffer");
+
+    auto start_func =
+        [](Context& ctx) {
+
+            std::default_random_engine generator(std::random_device { } ());
+            std::uniform_int_distribution<int64_t> distribution(
+                -1000000, 1000000);
+
+            auto integers = Generate(
+                ctx, 100000,
+                [&distribution, &generator](const size_t&) -> int64_t {
+                    return distribution(generator);
+                });
+
+            // std::greater on integers selects radix sort and reversal
+            auto sorted = integers.Sort(std::greater<int64_t>());
+
+            std::vector<int64_t> out_vec = sorted.AllGather();
+
+            for (size_t i = 0; i < out_vec.size() - 1; i++) {
+                ASSERT_FALSE(out_vec[i + 1] > out_vec[i]);
+            }
+
+            ASSERT_EQ(100000u, out_vec.size());
+        };
+
+    api::RunLocalTests(start_func);
+}
+
+TEST(Sort, SortZipfIntegersSkewAware) {
+
+    auto start_func =
+        [](Context& ctx) {
+
+            std::default_random_engine generator(std::random_device { } ());
+            common::ZipfDistribution zipf(1000, 1.5);
+
+            auto integers = Generate(
+                ctx, 200000,
+                [&zipf, &generator](const size_t&) -> size_t {
+                    return zipf(generator);
+                });
+
+            auto sorted = integers.Sort(SkewAwareTag);
+
+            // count the items each worker got
+            size_t local_size = 0;
+            sorted.Keep().Map(
+                [&local_size](const size_t& x) {
+                    ++local_size;
+                    return x;
+                }).Size();
+
+            std::vector<size_t> out_vec = sorted.AllGather();
+
+            for (size_t i = 0; i < out_vec.size() - 1; i++) {
+                ASSERT_FALSE(out_vec[i + 1] < out_vec[i]);
+            }
+
+            ASSERT_EQ(200000u, out_vec.size());
+
+            // the largest partition must be close to the average, despite
+            // the most frequent key occurring in about a third of all items.
+            size_t max_size = ctx.net.AllReduce(
+                local_size, common::maximum<size_t>());
+            double imbalance = static_cast<double>(max_size)
+                               * static_cast<double>(ctx.num_workers())
+                               / 200000.0;
+            ASSERT_LE(imbalance, 1.25);
+        };
+
+    api::RunLocalTests(start_func);
+}
+
 struct IntIntStruct {
     int a, b;
 
@@ -159,6 +354,56 @@ TEST(Sort, SortRandomIntIntStructs) {
     api::RunLocalTests(start_func);
 }
 
+struct FixedKeyStruct {
+    uint8_t key[6];
+    uint32_t value;
+
+    bool operator < (const FixedKeyStruct& b) const {
+        return std::lexicographical_compare(key, key + 6, b.key, b.key + 6);
+    }
+
+    // key accessors used by DefaultSortAlgorithm to select radix sort
+    static constexpr size_t radix_depth = 6;
+    const uint8_t& at_radix(size_t depth) const { return key[depth]; }
+};
+
+TEST(Sort, SortRadixKeyStructs) {
+
+    static_assert(common::has_radix_key<FixedKeyStruct>::value,
+                  "FixedKeyStruct should be radix sortable");
+
+    auto start_func =
+        [](Context& ctx) {
+
+            std::default_random_engine generator(std::random_device { } ());
+            std::uniform_int_distribution<int> distribution(0, 255);
+
+            auto items = Generate(
+                ctx, 100000,
+                [&distribution, &generator](const size_t& index) {
+                    FixedKeyStruct s;
+                    for (size_t i = 0; i < 6; ++i)
+                        s.key[i] = static_cast<uint8_t>(
+                            i < 2 ? distribution(generator) % 4
+                            : distribution(generator));
+                    s.value = static_cast<uint32_t>(index);
+                    return s;
+                });
+
+            auto sorted = items.Sort();
+
+            std::vector<FixedKeyStruct> out_vec = sorted.AllGather();
+
+            for (size_t i = 0; i < out_vec.size() - 1; i++) {
+                ASSERT_FALSE(out_vec[i + 1] < out_vec[i]);
+            }
+
+            ASSERT_EQ(100000u, out_vec.size());
+        };
+
+    api::RunLocalTests(start_func);
+}
+
 TEST(Sort, SortZeros) {
 
     auto start_func =
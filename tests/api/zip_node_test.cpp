@@ -21,6 +21,7 @@
 #include <random>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 using namespace thrill; // NOLINT
@@ -98,6 +99,44 @@ TEST(ZipNode, TwoBalancedIntegerArraysNoRebalance) {
     api::RunLocalTests(start_func);
 }
 
+TEST(ZipNode, TwoIntegerArraysOneAligned) {
+
+    auto start_func =
+        [](Context& ctx) {
+
+            // numbers 0..999, which are already distributed like the result
+            // and are zipped without scattering.
+            auto zip_input1 = Generate(
+                ctx, test_size,
+                [](size_t index) { return index; });
+
+            // even numbers 0..1998, which need to be scattered.
+            auto zip_input2 = Generate(
+                ctx, 2 * test_size,
+                [](size_t index) { return index; })
+                              .Filter([](size_t i) { return i % 2 == 0; });
+
+            // zip
+            auto zip_result = zip_input1.Zip(
+                zip_input2, [](size_t a, size_t b) {
+                    return std::make_pair(a, b);
+                });
+
+            // check result
+            std::vector<std::pair<size_t, size_t> > res =
+                zip_result.AllGather();
+
+            ASSERT_EQ(test_size, res.size());
+
+            for (size_t i = 0; i != res.size(); ++i) {
+                ASSERT_EQ(i, res[i].first);
+                ASSERT_EQ(2 * i, res[i].second);
+            }
+        };
+
+    api::RunLocalTests(start_func);
+}
+
 TEST(ZipNode, TwoDisbalancedIntegerArrays) {
 
     // first DIA is heavily balanced to the first workers, second DIA is
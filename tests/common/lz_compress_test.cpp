@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * tests/common/lz_compress_test.cpp
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <thrill/common/lz_compress.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace thrill;
+
+//! compress data, check the compressed size is below max_size, decompress it
+//! and compare.
+static void TestRoundTrip(const std::vector<uint8_t>& data, size_t max_size) {
+    std::vector<uint8_t> comp(data.size() + data.size() / 8 + 16);
+    size_t comp_size = common::LzCompress(
+        data.data(), data.size(), comp.data(), comp.size());
+
+    ASSERT_GT(comp_size, 0u);
+    ASSERT_LE(comp_size, max_size);
+
+    std::vector<uint8_t> output(data.size());
+    ASSERT_TRUE(common::LzDecompress(
+                    comp.data(), comp_size, output.data(), output.size()));
+    ASSERT_EQ(data, output);
+
+    // decompressing into a buffer of the wrong size must fail
+    std::vector<uint8_t> short_output(data.size() + 1);
+    ASSERT_FALSE(common::LzDecompress(
+                     comp.data(), comp_size,
+                     short_output.data(), short_output.size()));
+}
+
+TEST(LzCompress, SmallInputs) {
+    for (size_t size = 0; size < 64; ++size) {
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < size; ++i) data[i] = static_cast<uint8_t>(i % 3);
+        TestRoundTrip(data, size + 2);
+    }
+}
+
+TEST(LzCompress, Repetitive) {
+    std::string text;
+    for (size_t i = 0; i < 100000; ++i)
+        text += "item" + std::to_string(i % 1000) + ",";
+
+    std::vector<uint8_t> data(text.begin(), text.end());
+    TestRoundTrip(data, data.size() / 4);
+
+    // long runs of a single byte create overlapping back-references
+    std::vector<uint8_t> zeros(1000000, 0);
+    TestRoundTrip(zeros, zeros.size() / 100);
+}
+
+TEST(LzCompress, Random) {
+    std::default_random_engine rng(std::random_device { } ());
+
+    std::vector<uint8_t> data(1000000);
+    for (uint8_t& d : data) d = static_cast<uint8_t>(rng());
+
+    TestRoundTrip(data, data.size() + data.size() / 8 + 16);
+
+    // random data does not fit into a smaller buffer
+    std::vector<uint8_t> comp(data.size());
+    ASSERT_EQ(0u, common::LzCompress(
+                  data.data(), data.size(), comp.data(), comp.size()));
+}
+
+/******************************************************************************/
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * tests/common/numa_test.cpp
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <thrill/common/numa.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace thrill;
+
+TEST(NumaTopology, ParseCpuList) {
+    using Cpus = std::vector<size_t>;
+    ASSERT_EQ(Cpus({ 0 }), common::NumaTopology::ParseCpuList("0"));
+    ASSERT_EQ(Cpus({ 0, 1, 2, 3 }), common::NumaTopology::ParseCpuList("0-3\n"));
+    ASSERT_EQ(Cpus({ 0, 1, 8, 10, 11 }),
+              common::NumaTopology::ParseCpuList("0-1,8,10-11"));
+    ASSERT_EQ(Cpus(), common::NumaTopology::ParseCpuList(""));
+}
+
+TEST(NumaTopology, WorkerPlacement) {
+    // two nodes with interleaved cpu numbers, and a gap in the node ids
+    common::NumaTopology numa({ 0, 2 }, { { 0, 2, 4 }, { 1, 3, 5 } });
+
+    ASSERT_EQ(2u, numa.num_nodes());
+    ASSERT_EQ(6u, numa.num_cpus());
+    ASSERT_EQ(2u, numa.node_id(1));
+
+    // consecutive workers fill one node before the next
+    std::vector<size_t> cpus, nodes;
+    for (size_t i = 0; i < 8; ++i) {
+        cpus.push_back(numa.WorkerCpu(i));
+        nodes.push_back(numa.WorkerNode(i));
+    }
+    ASSERT_EQ(std::vector<size_t>({ 0, 2, 4, 1, 3, 5, 0, 2 }), cpus);
+    ASSERT_EQ(std::vector<size_t>({ 0, 0, 0, 1, 1, 1, 0, 0 }), nodes);
+}
+
+TEST(NumaTopology, Machine) {
+    const common::NumaTopology& numa = common::NumaTopology::Machine();
+    ASSERT_GE(numa.num_nodes(), 1u);
+    ASSERT_GE(numa.num_cpus(), numa.num_nodes());
+    ASSERT_LT(numa.WorkerNode(0), numa.num_nodes());
+}
+
+TEST(NumaTopology, MemoryNode) {
+    const common::NumaTopology& numa = common::NumaTopology::Machine();
+
+    // touched pages are placed on some node, if the query is supported
+    std::vector<char> data(1024 * 1024, 1);
+    size_t node = numa.MemoryNode(data.data(), data.size());
+    ASSERT_TRUE(node == size_t(-1) || node < numa.num_nodes());
+}
+
+/******************************************************************************/
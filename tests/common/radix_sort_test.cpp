@@ -13,6 +13,8 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <random>
 #include <vector>
 
@@ -51,4 +53,49 @@ TEST(RadixSort, RandomStrings) {
     ASSERT_TRUE(std::is_sorted(vec.begin(), vec.end()));
 }
 
+template <typename Integer>
+static void TestIntegers(size_t test_size) {
+
+    std::default_random_engine rng(std::random_device { } ());
+    std::uniform_int_distribution<Integer> dist(
+        std::numeric_limits<Integer>::min(),
+        std::numeric_limits<Integer>::max());
+
+    std::vector<Integer> vec;
+    vec.reserve(test_size);
+
+    for (size_t i = 0; i < test_size; ++i)
+        vec.emplace_back(dist(rng));
+
+    std::vector<Integer> check = vec;
+    std::sort(check.begin(), check.end());
+
+    common::radix_sort_integer(vec.begin(), vec.end());
+
+    ASSERT_EQ(check, vec);
+}
+
+TEST(RadixSort, RandomIntegers) {
+    TestIntegers<uint32_t>(1024000);
+    TestIntegers<int32_t>(1024000);
+    TestIntegers<uint64_t>(1024000);
+    TestIntegers<int64_t>(1024000);
+    TestIntegers<int16_t>(100000);
+    TestIntegers<int64_t>(50);
+}
+
+struct FixedString : public MyString {
+    // key length used for automatic radix sort selection
+    static constexpr size_t radix_depth = 16;
+};
+
+TEST(RadixSort, HasRadixKey) {
+    static_assert(!common::has_radix_key<MyString>::value,
+                  "MyString has no radix_depth");
+    static_assert(common::has_radix_key<FixedString>::value,
+                  "FixedString has a radix key");
+    static_assert(!common::has_radix_key<size_t>::value,
+                  "size_t has no at_radix");
+}
+
 /******************************************************************************/
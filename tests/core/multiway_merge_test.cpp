@@ -13,6 +13,7 @@
 #include <thrill/common/function_traits.hpp>
 #include <thrill/core/multiway_merge.hpp>
 #include <thrill/core/multiway_merge_attic.hpp>
+#include <thrill/core/parallel_multiway_merge.hpp>
 #include <thrill/data/file.hpp>
 
 #include <thrill/common/logger.hpp>
@@ -133,4 +134,57 @@ TEST_F(MultiwayMerge, GetMultiwayMergePuller) {
     ASSERT_FALSE(puller.HasNext());
 }
 
+TEST_F(MultiwayMerge, ParallelMerge) {
+    std::mt19937 gen(0);
+    size_t a = 7;
+    size_t total = 0;
+
+    std::vector<data::File> in;
+    std::vector<size_t> ref;
+
+    for (size_t i = 0; i < a; ++i) {
+        // runs of different length with many duplicates
+        std::vector<size_t> tmp(10000 + 5000 * i);
+        for (size_t& t : tmp) t = gen() % 5000;
+        std::sort(tmp.begin(), tmp.end());
+        ref.insert(ref.end(), tmp.begin(), tmp.end());
+        total += tmp.size();
+
+        data::File f(block_pool_, 0, /* dia_id */ 0);
+        {
+            auto w = f.GetWriter();
+            for (auto& t : tmp) {
+                w.Put(t);
+            }
+        }
+        in.emplace_back(std::move(f));
+    }
+
+    std::sort(ref.begin(), ref.end());
+
+    for (size_t num_parts : { 1, 2, 3, 8 }) {
+        // the merge consumes its input Files
+        std::vector<data::File> copy;
+        for (const data::File& f : in)
+            copy.emplace_back(f.Copy());
+
+        data::File out = core::parallel_multiway_merge<size_t>(
+            copy.begin(), copy.end(), num_parts, /* prefetch */ 1,
+            std::less<size_t>(),
+            [this]() { return data::File(block_pool_, 0, 0); });
+
+        ASSERT_EQ(total, out.num_items());
+        for (const data::File& f : copy)
+            ASSERT_EQ(0u, f.num_items());
+
+        size_t i = 0;
+        auto r = out.GetKeepReader();
+        while (r.HasNext()) {
+            ASSERT_EQ(ref[i], r.Next<size_t>());
+            ++i;
+        }
+        ASSERT_EQ(total, i);
+    }
+}
+
 /******************************************************************************/
@@ -110,6 +110,71 @@ TEST(ReduceHashPhase, ProbingAddMyStructByHash) {
         });
 }
 
+TEST(ReduceHashPhase, SwissProbingAddMyStructByHash) {
+    api::RunLocalSameThread(
+        [](Context& ctx) {
+            TestAddMyStructByHash<core::ReduceTableImpl::SWISS_PROBING>(ctx);
+        });
+}
+
+struct MyParallelReduceConfig : public core::DefaultReduceConfig {
+    //! use many small partitions to spill into
+    static constexpr size_t post_min_items_per_partition_ = 256;
+
+    //! re-reduce spilled partitions with multiple threads
+    static constexpr size_t post_flush_threads_ = 4;
+};
+
+TEST(ReduceHashPhase, ParallelFlushAddMyStructByHash) {
+    api::RunLocalSameThread(
+        [](Context& ctx) {
+            static constexpr size_t mod_size = 60000;
+            static constexpr size_t test_size = mod_size * 4;
+
+            auto key_ex = [](const MyStruct& in) {
+                              return in.key % mod_size;
+                          };
+
+            auto red_fn = [](const MyStruct& in1, const MyStruct& in2) {
+                              return MyStruct {
+                                         in1.key, in1.value + in2.value
+                              };
+                          };
+
+            // collect all items
+            std::vector<MyStruct> result;
+
+            auto emit_fn = [&result](const MyStruct& in) {
+                               result.emplace_back(in);
+                           };
+
+            using Phase = core::ReduceByHashPostPhase<
+                      MyStruct, size_t, MyStruct,
+                      decltype(key_ex), decltype(red_fn), decltype(emit_fn),
+                      /* VolatileKey */ false, MyParallelReduceConfig>;
+
+            Phase phase(ctx, 0, key_ex, red_fn, emit_fn);
+            // too small for all keys, hence partitions are spilled
+            phase.Initialize(/* limit_memory_bytes */ 256 * 1024);
+
+            for (size_t i = 0; i < test_size; ++i) {
+                phase.Insert(MyStruct { i, i / mod_size });
+            }
+
+            phase.PushData(/* consume */ true);
+
+            // check result
+            std::sort(result.begin(), result.end());
+
+            ASSERT_EQ(mod_size, result.size());
+
+            for (size_t i = 0; i < result.size(); ++i) {
+                ASSERT_EQ(i, result[i].key);
+                ASSERT_EQ(6u, result[i].value);
+            }
+        });
+}
+
 /******************************************************************************/
 
 TEST(ReduceHashPhase, PostReduceByIndex) {
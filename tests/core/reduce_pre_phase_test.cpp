@@ -126,6 +126,99 @@ TEST(ReducePrePhase, ProbingAddMyStructByHash) {
         });
 }
 
+TEST(ReducePrePhase, SwissProbingAddMyStructByHash) {
+    api::RunLocalSameThread(
+        [](Context& ctx) {
+            TestAddMyStructByHash<core::ReduceTableImpl::SWISS_PROBING>(ctx);
+        });
+}
+
+template <core::ReduceTableImpl table_impl>
+static void TestBypassUniqueKeys(Context& ctx) {
+    static constexpr size_t test_size = 200000;
+
+    auto key_ex = [](const MyStruct& in) {
+                      return in.key;
+                  };
+
+    auto red_fn = [](const MyStruct& in1, const MyStruct& in2) {
+                      return MyStruct {
+                                 in1.key, in1.value + in2.value
+                      };
+                  };
+
+    // collect all items
+    const size_t num_partitions = 13;
+
+    std::vector<data::File> files;
+    for (size_t i = 0; i < num_partitions; ++i)
+        files.emplace_back(ctx.GetFile(nullptr));
+
+    std::vector<data::DynBlockWriter> emitters;
+    for (size_t i = 0; i < num_partitions; ++i)
+        emitters.emplace_back(files[i].GetDynWriter());
+
+    // process items with phase
+    using Phase = core::ReducePrePhase<
+              MyStruct, size_t, MyStruct,
+              decltype(key_ex), decltype(red_fn),
+              /* VolatileKey */ false,
+              MyReduceConfig<table_impl> >;
+
+    // the bypass is disabled by default
+    MyReduceConfig<table_impl> config;
+    config.bypass_reduction_rate_ = 0.1;
+
+    Phase phase(ctx, 0, num_partitions, key_ex, red_fn, emitters, config);
+
+    // small table, such that it flushes before the first bypass check
+    phase.Initialize(/* limit_memory_bytes */ 64 * 1024);
+
+    for (size_t i = 0; i < test_size; ++i) {
+        phase.Insert(MyStruct { i, i });
+    }
+
+    // all keys are unique, hence the table must have been bypassed
+    ASSERT_TRUE(phase.bypass());
+    ASSERT_EQ(test_size, phase.num_inserted() + phase.num_bypassed());
+    ASSERT_EQ(phase.num_bypassed() * sizeof(MyStruct), phase.bypassed_bytes());
+
+    phase.FlushAll();
+    phase.CloseAll();
+
+    // collect items and check result
+    std::vector<MyStruct> result;
+
+    for (size_t i = 0; i < num_partitions; ++i) {
+        data::File::Reader r = files[i].GetReader(/* consume */ true);
+        while (r.HasNext())
+            result.emplace_back(r.Next<MyStruct>());
+    }
+
+    std::sort(result.begin(), result.end());
+
+    ASSERT_EQ(test_size, result.size());
+
+    for (size_t i = 0; i < result.size(); ++i) {
+        ASSERT_EQ(i, result[i].key);
+        ASSERT_EQ(i, result[i].value);
+    }
+}
+
+TEST(ReducePrePhase, BucketBypassUniqueKeys) {
+    api::RunLocalSameThread(
+        [](Context& ctx) {
+            TestBypassUniqueKeys<core::ReduceTableImpl::BUCKET>(ctx);
+        });
+}
+
+TEST(ReducePrePhase, ProbingBypassUniqueKeys) {
+    api::RunLocalSameThread(
+        [](Context& ctx) {
+            TestBypassUniqueKeys<core::ReduceTableImpl::PROBING>(ctx);
+        });
+}
+
 /******************************************************************************/
 
 template <core::ReduceTableImpl table_impl>
@@ -109,4 +109,146 @@ TEST_F(BlockPoolTest, EvictBlock) {
     ASSERT_EQ(0u, block_pool_.writing_blocks() + block_pool_.swapped_blocks());
 }
 
+//! allocate an unpinned block of 4 KiB
+static data::Block AllocateUnpinnedBlock(data::BlockPool& block_pool) {
+    data::PinnedByteBlockPtr block = block_pool.AllocateByteBlock(4096, 0);
+    data::PinnedBlock pinned_block(std::move(block), 0, 4096, 0, 0, false);
+    return pinned_block.ToBlock();
+}
+
+//! evict the next block selected by the policy and wait for the write
+static void EvictNextBlock(data::BlockPool& block_pool) {
+    io::RequestPtr req = block_pool.EvictBlockLRU();
+    ASSERT_TRUE(req.valid());
+    req->wait();
+}
+
+TEST(BlockPool, EvictionPolicyConsume) {
+    data::BlockPool block_pool(0, 0, nullptr, nullptr, 1,
+                               /* compress_swap */ false, "consume");
+
+    data::Block a = AllocateUnpinnedBlock(block_pool);
+    data::Block b = AllocateUnpinnedBlock(block_pool);
+    data::Block c = AllocateUnpinnedBlock(block_pool);
+
+    block_pool.SetEvictionHint(a.byte_block().get(), data::EvictionHint::Announced);
+    block_pool.SetEvictionHint(c.byte_block().get(), data::EvictionHint::Consumed);
+    ASSERT_EQ(3u, block_pool.unpinned_blocks());
+
+    // consumed first, then without hint, then announced, unlike LRU order.
+    EvictNextBlock(block_pool);
+    ASSERT_FALSE(c.byte_block()->in_memory());
+    ASSERT_TRUE(b.byte_block()->in_memory());
+    EvictNextBlock(block_pool);
+    ASSERT_FALSE(b.byte_block()->in_memory());
+    ASSERT_TRUE(a.byte_block()->in_memory());
+    EvictNextBlock(block_pool);
+    ASSERT_FALSE(a.byte_block()->in_memory());
+
+    // pinning an announced block clears the hint
+    data::PinnedBlock pinned = a.PinWait(0);
+    ASSERT_EQ(data::EvictionHint::None, a.byte_block()->eviction_hint());
+}
+
+TEST(BlockPool, EvictionPolicyPriority) {
+    data::BlockPool block_pool(0, 0, nullptr, nullptr, 1,
+                               /* compress_swap */ false, "priority");
+
+    data::Block a = AllocateUnpinnedBlock(block_pool);
+    data::Block b = AllocateUnpinnedBlock(block_pool);
+    data::Block c = AllocateUnpinnedBlock(block_pool);
+
+    block_pool.SetBlockDiaId(a.byte_block().get(), 1);
+    block_pool.SetBlockDiaId(b.byte_block().get(), 2);
+    block_pool.SetBlockDiaId(c.byte_block().get(), 3);
+    ASSERT_EQ(2u, b.byte_block()->dia_id());
+
+    block_pool.SetDiaEvictionPriority(1, 1, 0);
+    block_pool.SetDiaEvictionPriority(
+        2, data::EvictionPolicy::kDisposeSoon, 0);
+
+    // DIA 3 has the default priority zero, and DIA 2 is disposed soon.
+    EvictNextBlock(block_pool);
+    ASSERT_FALSE(c.byte_block()->in_memory());
+    EvictNextBlock(block_pool);
+    ASSERT_FALSE(a.byte_block()->in_memory());
+    ASSERT_TRUE(b.byte_block()->in_memory());
+
+    block_pool.ClearDiaEvictionPriority(2, 0);
+    EvictNextBlock(block_pool);
+    ASSERT_FALSE(b.byte_block()->in_memory());
+}
+
+TEST(BlockPool, EvictionPolicyPriorityPerWorker) {
+    data::BlockPool block_pool(0, 0, nullptr, nullptr, 2,
+                               /* compress_swap */ false, "priority");
+
+    data::Block a = AllocateUnpinnedBlock(block_pool);
+    data::Block b = AllocateUnpinnedBlock(block_pool);
+
+    block_pool.SetBlockDiaId(a.byte_block().get(), 1);
+    block_pool.SetBlockDiaId(b.byte_block().get(), 2);
+
+    // both workers raise the priority of DIA 1
+    block_pool.SetDiaEvictionPriority(1, 1, 0);
+    block_pool.SetDiaEvictionPriority(1, 1, 1);
+
+    // worker 0 disposes DIA 1, which keeps the priority of worker 1
+    block_pool.ClearDiaEvictionPriority(1, 0);
+    EvictNextBlock(block_pool);
+    ASSERT_FALSE(b.byte_block()->in_memory());
+    ASSERT_TRUE(a.byte_block()->in_memory());
+}
+
+TEST(BlockPool, NumaPinStatistics) {
+    data::BlockPool block_pool(2);
+    block_pool.SetWorkerNumaNode(0, 0);
+    block_pool.SetWorkerNumaNode(1, 0);
+    ASSERT_EQ(0u, block_pool.worker_numa_node(1));
+
+    data::Block unpinned_block;
+    {
+        // allocation counts as a local access
+        data::PinnedByteBlockPtr block = block_pool.AllocateByteBlock(8, 0);
+        data::PinnedBlock pinned_block(std::move(block), 0, 8, 0, 0, false);
+        unpinned_block = pinned_block.ToBlock();
+    }
+    ASSERT_EQ(1u, block_pool.numa_local_pins());
+
+    // pins by both workers on the same node
+    data::PinnedBlock pin0 = unpinned_block.PinWait(0);
+    data::PinnedBlock pin1 = unpinned_block.PinWait(1);
+    ASSERT_EQ(3u, block_pool.numa_local_pins());
+    ASSERT_EQ(0u, block_pool.numa_remote_pins());
+}
+
+TEST(BlockPool, EvictCompressedBlock) {
+    data::BlockPool block_pool(0, 0, nullptr, nullptr, 1,
+                               /* compress_swap */ true);
+
+    const size_t size = 64 * 1024;
+
+    data::Block unpinned_block;
+    data::ByteBlock* byte_block;
+    {
+        data::PinnedByteBlockPtr block = block_pool.AllocateByteBlock(size, 0);
+        for (size_t i = 0; i < size; ++i)
+            block->data()[i] = static_cast<data::Byte>(i % 251 < 128 ? 0 : i);
+        byte_block = block.get();
+        data::PinnedBlock pinned_block(std::move(block), 0, size, 0, 0, false);
+        unpinned_block = pinned_block.ToBlock();
+    }
+    // evict block, which is compressed, and swap it back in by pinning it.
+    block_pool.EvictBlock(byte_block);
+    ASSERT_EQ(1u, block_pool.writing_blocks() + block_pool.swapped_blocks());
+
+    data::PinnedBlock pinned = unpinned_block.PinWait(0);
+    ASSERT_EQ(0u, block_pool.writing_blocks() + block_pool.swapped_blocks());
+
+    for (size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(static_cast<data::Byte>(i % 251 < 128 ? 0 : i),
+                  pinned.byte_block()->data()[i]);
+    }
+}
+
 /******************************************************************************/
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * tests/data/columnar_test.cpp
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <thrill/data/columnar.hpp>
+#include <thrill/data/file.hpp>
+
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+using namespace thrill;
+
+struct Columnar : public ::testing::Test {
+    data::BlockPool block_pool_;
+};
+
+using Triple = std::tuple<uint32_t, double, uint8_t>;
+
+using TripleWriter = data::ColumnarWriter<Triple, data::File>;
+using TripleReader = data::ColumnarReader<Triple, data::KeepFileBlockSource>;
+
+static Triple MakeTriple(size_t i) {
+    return Triple(static_cast<uint32_t>(i), i / 2.0,
+                  static_cast<uint8_t>(i % 256));
+}
+
+TEST_F(Columnar, Layout) {
+    using Layout = data::ColumnarLayout<Triple>;
+
+    ASSERT_EQ(3u, size_t(Layout::num_columns));
+    ASSERT_EQ(13u, size_t(Layout::item_size));
+
+    ASSERT_EQ(0u, Layout::ColumnOffset<0>(10));
+    ASSERT_EQ(64u, Layout::ColumnOffset<1>(10));
+    ASSERT_EQ(192u, Layout::ColumnOffset<2>(10));
+    ASSERT_EQ(202u, Layout::BlockSize(10));
+
+    ASSERT_LE(Layout::BlockSize(Layout::Capacity(4096)), 4096u);
+
+    static_assert(data::ColumnarLayout<std::pair<int, double> >::is_supported,
+                  "pair of PODs is supported");
+    static_assert(!data::ColumnarLayout<std::tuple<int, int*> >::is_supported,
+                  "pointers are not supported");
+}
+
+TEST_F(Columnar, PutItemsGetItems) {
+    static constexpr size_t test_size = 1000;
+
+    data::File file(block_pool_, 0, /* dia_id */ 0);
+    {
+        TripleWriter cw(&file, 4096);
+        for (size_t i = 0; i < test_size; ++i)
+            cw.Put(MakeTriple(i));
+    }
+
+    ASSERT_EQ(test_size, file.num_items());
+    // three full blocks and a partial one
+    ASSERT_EQ(4u, file.num_blocks());
+
+    TripleReader cr(data::KeepFileBlockSource(file, 0));
+    for (size_t i = 0; i < test_size; ++i) {
+        ASSERT_TRUE(cr.HasNext());
+        ASSERT_EQ(MakeTriple(i), cr.Next());
+    }
+    ASSERT_FALSE(cr.HasNext());
+}
+
+TEST_F(Columnar, ReadColumns) {
+    static constexpr size_t test_size = 1000;
+
+    data::File file(block_pool_, 0, /* dia_id */ 0);
+    {
+        TripleWriter cw(&file, 4096);
+        for (size_t i = 0; i < test_size; ++i)
+            cw.Put(MakeTriple(i));
+    }
+
+    // read only the second field of each item
+    {
+        TripleReader cr(data::KeepFileBlockSource(file, 0));
+        for (size_t i = 0; i < test_size; ++i) {
+            ASSERT_TRUE(cr.HasNext());
+            ASSERT_EQ(i / 2.0, cr.NextField<1>());
+        }
+        ASSERT_FALSE(cr.HasNext());
+    }
+
+    // sum the first column block-wise
+    {
+        TripleReader cr(data::KeepFileBlockSource(file, 0));
+        size_t sum = 0, items = 0;
+        while (cr.NextBlock()) {
+            const uint32_t* column = cr.Column<0>();
+            ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(cr.Column<1>()) % 64);
+            for (size_t i = 0; i < cr.block_num_items(); ++i)
+                sum += column[i];
+            items += cr.block_num_items();
+        }
+        ASSERT_EQ(test_size, items);
+        ASSERT_EQ(test_size * (test_size - 1) / 2, sum);
+    }
+}
+
+/******************************************************************************/
@@ -163,7 +163,7 @@ struct Multiplexer : public ::testing::Test {
 
 // open a Stream via data::Multiplexer, and send a short message to all workers,
 // receive and check the message.
-void TalkAllToAllViaCatStream(net::Group* net) {
+void TalkAllToAllViaCatStream(net::Group* net, bool compress) {
     common::NameThisThread("chmp" + mem::to_string(net->my_host_rank()));
 
     unsigned char send_buffer[123];
@@ -187,8 +187,10 @@ void TalkAllToAllViaCatStream(net::Group* net) {
 
         // open Writers and send a message to all workers
 
-        auto writers = multiplexer.GetOrCreateCatStream(
-            id, my_local_worker_id, /* dia_id */ 0)->GetWriters();
+        auto stream = multiplexer.GetOrCreateCatStream(
+            id, my_local_worker_id, /* dia_id */ 0);
+        stream->set_compress(compress);
+        auto writers = stream->GetWriters();
 
         for (size_t tgt = 0; tgt != writers.size(); ++tgt) {
             writers[tgt].Put("hello I am " + std::to_string(net->my_host_rank())
@@ -205,6 +207,12 @@ void TalkAllToAllViaCatStream(net::Group* net) {
             writers[tgt].Close();
         }
 
+        // the repetitive data must have been compressed when sent
+        if (compress && net->num_hosts() > 1) {
+            ASSERT_LT(stream->tx_net_compress_out_.load(),
+                      stream->tx_net_compress_in_.load());
+        }
+
         // open Readers and receive message from all workers
 
         auto readers = multiplexer.GetOrCreateCatStream(
@@ -234,10 +242,17 @@ void TalkAllToAllViaCatStream(net::Group* net) {
 
 TEST_F(Multiplexer, TalkAllToAllViaCatStreamForManyNetSizes) {
     // test for all network mesh sizes 1, 2, 5, 9:
-    net::RunLoopbackGroupTest(1, TalkAllToAllViaCatStream);
-    net::RunLoopbackGroupTest(2, TalkAllToAllViaCatStream);
-    net::RunLoopbackGroupTest(5, TalkAllToAllViaCatStream);
-    net::RunLoopbackGroupTest(9, TalkAllToAllViaCatStream);
+    auto talk = [](net::Group* net) { TalkAllToAllViaCatStream(net, false); };
+    net::RunLoopbackGroupTest(1, talk);
+    net::RunLoopbackGroupTest(2, talk);
+    net::RunLoopbackGroupTest(5, talk);
+    net::RunLoopbackGroupTest(9, talk);
+}
+
+TEST_F(Multiplexer, TalkAllToAllViaCompressedCatStream) {
+    auto talk = [](net::Group* net) { TalkAllToAllViaCatStream(net, true); };
+    net::RunLoopbackGroupTest(2, talk);
+    net::RunLoopbackGroupTest(5, talk);
 }
 
 TEST_F(Multiplexer, ReadCompleteCatStream) {
@@ -460,7 +475,7 @@ TEST_F(Multiplexer, ReadCompleteMixStreamManyTimes) {
 
 // open a Stream via data::Multiplexer, and send a short message to all workers,
 // receive and check the message.
-void TalkAllToAllViaMixStream(net::Group* net) {
+void TalkAllToAllViaMixStream(net::Group* net, bool compress) {
     common::NameThisThread("chmp" + mem::to_string(net->my_host_rank()));
 
     char send_buffer[123];
@@ -482,8 +497,10 @@ void TalkAllToAllViaMixStream(net::Group* net) {
 
         // open Writers and send a message to all workers
 
-        auto writers = multiplexer.GetOrCreateMixStream(
-            id, my_local_worker_id, /* dia_id */ 0)->GetWriters();
+        auto stream = multiplexer.GetOrCreateMixStream(
+            id, my_local_worker_id, /* dia_id */ 0);
+        stream->set_compress(compress);
+        auto writers = stream->GetWriters();
 
         for (size_t tgt = 0; tgt != writers.size(); ++tgt) {
             std::string txt =
@@ -538,13 +555,20 @@ void TalkAllToAllViaMixStream(net::Group* net) {
 
 TEST_F(Multiplexer, TalkAllToAllViaMixStreamForManyNetSizes) {
     // test for all network mesh sizes 1, 2, 5, 9:
-    net::RunLoopbackGroupTest(1, TalkAllToAllViaMixStream);
-    net::RunLoopbackGroupTest(2, TalkAllToAllViaMixStream);
-    net::RunLoopbackGroupTest(5, TalkAllToAllViaMixStream);
-    net::RunLoopbackGroupTest(9, TalkAllToAllViaMixStream);
+    auto talk = [](net::Group* net) { TalkAllToAllViaMixStream(net, false); };
+    net::RunLoopbackGroupTest(1, talk);
+    net::RunLoopbackGroupTest(2, talk);
+    net::RunLoopbackGroupTest(5, talk);
+    net::RunLoopbackGroupTest(9, talk);
     // the test does not work for two digit #workers (due to sorting digits)
 }
 
+TEST_F(Multiplexer, TalkAllToAllViaCompressedMixStream) {
+    auto talk = [](net::Group* net) { TalkAllToAllViaMixStream(net, true); };
+    net::RunLoopbackGroupTest(2, talk);
+    net::RunLoopbackGroupTest(5, talk);
+}
+
 /******************************************************************************/
 // Scatter Tests
 
@@ -144,6 +144,28 @@ static void TestMultiThreadBroadcast(net::Group* net) {
         });
 }
 
+/*!
+ * Broadcasts a value among the local threads of each host.
+ */
+static void TestMultiThreadLocalBroadcast(net::Group* net) {
+    const size_t count = 4;
+    ExecuteMultiThreads(
+        net, count, [=](net::FlowControlChannel& channel) {
+
+            size_t local_id = channel.my_rank() % count;
+
+            for (size_t origin = 0; origin < count; ++origin) {
+
+                size_t value = local_id == origin
+                               ? net->my_host_rank() * count + origin : 0;
+
+                size_t res = channel.LocalBroadcast(value, origin);
+
+                ASSERT_EQ(res, net->my_host_rank() * count + origin);
+            }
+        });
+}
+
 /*!
  * Calculates a sum over all worker and thread ids.
  */
@@ -237,6 +237,57 @@ static void TestDispatcherSyncSendAsyncRead(net::Group* net) {
     }
 }
 
+//! sends many Buffers of different sizes asynchronously to all workers, which
+//! the dispatcher may batch into vectored sends, and checks their order.
+static void TestDispatcherAsyncWriteBatched(net::Group* net) {
+    static constexpr size_t num_messages = 100;
+
+    mem::Manager mem_manager(nullptr, "Dispatcher");
+    std::unique_ptr<net::Dispatcher>
+    dispatcher = net->ConstructDispatcher(mem_manager);
+
+    auto message_size = [](size_t k) { return 1 + (k * 7919) % 50000; };
+    auto message_byte = [](size_t from, size_t k, size_t j) {
+                            return static_cast<uint8_t>(from * 31 + k * 7 + j);
+                        };
+
+    for (size_t i = 0; i != net->num_hosts(); ++i)
+    {
+        if (i == net->my_host_rank()) continue;
+        for (size_t k = 0; k < num_messages; ++k) {
+            net::Buffer buffer(message_size(k));
+            for (size_t j = 0; j < buffer.size(); ++j)
+                buffer[j] = message_byte(net->my_host_rank(), k, j);
+            dispatcher->AsyncWrite(net->connection(i), std::move(buffer));
+        }
+    }
+
+    // reads on a connection are completed in order
+    size_t received = 0;
+    std::vector<size_t> next(net->num_hosts());
+
+    for (size_t i = 0; i != net->num_hosts(); ++i)
+    {
+        if (i == net->my_host_rank()) continue;
+        for (size_t k = 0; k < num_messages; ++k) {
+            dispatcher->AsyncRead(
+                net->connection(i), message_size(k),
+                [&, i](net::Connection&, net::Buffer&& buffer) {
+                    size_t k = next[i]++;
+                    ASSERT_EQ(message_size(k), buffer.size());
+                    for (size_t j = 0; j < buffer.size(); ++j)
+                        ASSERT_EQ(message_byte(i, k, j), buffer[j]);
+                    received++;
+                });
+        }
+    }
+
+    while (received < (net->num_hosts() - 1) * num_messages ||
+           dispatcher->HasAsyncWrites()) {
+        dispatcher->Dispatch();
+    }
+}
+
 /******************************************************************************/
 // DispatcherThread tests
 
@@ -94,6 +94,9 @@ TEST(MockGroup, AllReduceHypercubeString) {
 TEST(MockGroup, DispatcherSyncSendAsyncRead) {
     MockTest(TestDispatcherSyncSendAsyncRead);
 }
+TEST(MockGroup, DispatcherAsyncWriteBatched) {
+    MockTest(TestDispatcherAsyncWriteBatched);
+}
 TEST(MockGroup, DispatcherLaunchAndTerminate) {
     MockTest(TestDispatcherLaunchAndTerminate);
 }
@@ -109,6 +112,9 @@ TEST(MockGroup, SingleThreadBroadcast) {
 TEST(MockGroup, MultiThreadBroadcast) {
     MockTestLess(TestMultiThreadBroadcast);
 }
+TEST(MockGroup, MultiThreadLocalBroadcast) {
+    MockTestLess(TestMultiThreadLocalBroadcast);
+}
 TEST(MockGroup, MultiThreadReduce) {
     MockTestLess(TestMultiThreadReduce);
 }
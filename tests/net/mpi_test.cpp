@@ -81,6 +81,9 @@ TEST(MpiGroup, AllReduceHypercubeString) {
 TEST(MpiGroup, DispatcherSyncSendAsyncRead) {
     MpiTest(TestDispatcherSyncSendAsyncRead);
 }
+TEST(MpiGroup, DispatcherAsyncWriteBatched) {
+    MpiTest(TestDispatcherAsyncWriteBatched);
+}
 TEST(MpiGroup, DispatcherLaunchAndTerminate) {
     MpiTest(TestDispatcherLaunchAndTerminate);
 }
@@ -96,6 +99,9 @@ TEST(MpiGroup, SingleThreadBroadcast) {
 TEST(MpiGroup, MultiThreadBroadcast) {
     MpiTest(TestMultiThreadBroadcast);
 }
+TEST(MpiGroup, MultiThreadLocalBroadcast) {
+    MpiTest(TestMultiThreadLocalBroadcast);
+}
 TEST(MpiGroup, MultiThreadReduce) {
     MpiTest(TestMultiThreadReduce);
 }
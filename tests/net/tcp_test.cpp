@@ -13,6 +13,12 @@
 #include <thrill/net/dispatcher_thread.hpp>
 #include <thrill/net/tcp/group.hpp>
 #include <thrill/net/tcp/select_dispatcher.hpp>
+#include <thrill/net/tcp/shm_channel.hpp>
+
+#if THRILL_HAVE_NET_SHM
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 #include <random>
 #include <string>
@@ -36,16 +42,115 @@ static void LocalGroupTest(
     const std::function<void(net::Group*)>& thread_function) {
     // execute local stream socket tests
     net::ExecuteGroupThreads(
-        net::tcp::Group::ConstructLoopbackMesh(6),
+        net::tcp::Group::ConstructLoopbackMesh(6, false),
+        thread_function);
+}
+
+static void LocalShmGroupTest(
+    const std::function<void(net::Group*)>& thread_function) {
+    // execute local stream socket tests with shared memory channels
+    net::ExecuteGroupThreads(
+        net::tcp::Group::ConstructLoopbackMesh(6, true),
         thread_function);
 }
 
+#if THRILL_HAVE_NET_SHM
+TEST(ShmChannel, PairSendRecvWrapAround) {
+    // small ring, such that the messages wrap around and fill it
+    auto pair = net::tcp::ShmChannel::CreatePair(4096);
+
+    // a new channel is ready for sending, like a new socket
+    struct pollfd pfd = { pair.first->write_fd(), POLLIN, 0 };
+    ASSERT_EQ(1, poll(&pfd, 1, 0));
+
+    static constexpr size_t size = 1000000;
+    std::vector<uint8_t> send_data(size), recv_data(size);
+    std::default_random_engine rng(std::random_device { } ());
+    for (size_t i = 0; i < size; ++i)
+        send_data[i] = static_cast<uint8_t>(rng());
+
+    std::thread sender([&]() {
+                           ASSERT_EQ(static_cast<ssize_t>(size),
+                                     pair.first->SyncSend(send_data.data(), size));
+                           pair.first->Close();
+                       });
+
+    ASSERT_EQ(static_cast<ssize_t>(size),
+              pair.second->SyncRecv(recv_data.data(), size));
+    sender.join();
+    ASSERT_EQ(send_data, recv_data);
+
+    // end-of-stream after the peer closed
+    uint8_t byte;
+    ASSERT_EQ(0, pair.second->RecvOne(&byte, 1));
+}
+
+TEST(ShmChannel, SignalOnlyWhenEmpty) {
+    auto pair = net::tcp::ShmChannel::CreatePair(4096);
+
+    // only the first of two sends into the empty ring signals the eventfd
+    uint8_t data[2] = { 1, 2 };
+    ASSERT_EQ(1, pair.first->SendOne(data, 1));
+    ASSERT_EQ(1, pair.first->SendOne(data + 1, 1));
+
+    uint64_t count = 0;
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(count)),
+              read(pair.second->read_fd(), &count, sizeof(count)));
+    ASSERT_EQ(1u, count);
+
+    // the receiver still gets all data without waiting on the notifier
+    ASSERT_EQ(2, pair.second->RecvOne(data, 2));
+    ASSERT_EQ(2u, data[1]);
+}
+
+TEST(RealTcpGroup, SharedMemoryOnSameMachine) {
+    if (!net::tcp::ShmChannel::Enabled()) return;
+
+    std::vector<std::unique_ptr<net::tcp::Group> > groups =
+        net::tcp::Group::ConstructLocalRealTCPMesh(4);
+
+    // all hosts run on this machine, hence all connections use shared memory
+    for (size_t i = 0; i < groups.size(); ++i) {
+        for (size_t j = 0; j < groups.size(); ++j) {
+            if (i == j) continue;
+            ASSERT_TRUE(groups[i]->tcp_connection(j).IsShm());
+        }
+    }
+}
+#endif
+
+static void EnableZeroCopy(net::Group* net) {
+    net::tcp::Group* g = static_cast<net::tcp::Group*>(net);
+    for (size_t i = 0; i < g->num_hosts(); ++i) {
+        if (i == g->my_host_rank()) continue;
+        g->tcp_connection(i).EnableZeroCopy(0);
+    }
+}
+
+TEST(RealTcpGroup, DispatcherAsyncWriteZeroCopy) {
+    // zero-copy sends are only possible on sockets, not on shared memory.
+    setenv("THRILL_NET_SHM", "0", 1);
+    std::vector<std::unique_ptr<net::tcp::Group> > groups =
+        net::tcp::Group::ConstructLocalRealTCPMesh(4);
+    unsetenv("THRILL_NET_SHM");
+
+    net::ExecuteGroupThreads(
+        groups, std::function<void(net::Group*)>(
+            [](net::Group* net) {
+                EnableZeroCopy(net);
+                TestDispatcherAsyncWriteBatched(net);
+            }));
+}
+
 /*[[[perl
   require("tests/net/test_gen.pm");
   generate_group_tests("RealTcpGroup", "RealGroupTest");
 
   generate_group_tests("LocalTcpGroup", "LocalGroupTest");
   generate_flow_control_tests("LocalTcpGroup", "LocalGroupTest");
+
+  generate_group_tests("LocalShmGroup", "LocalShmGroupTest");
+  generate_flow_control_tests("LocalShmGroup", "LocalShmGroupTest");
   ]]]*/
 TEST(RealTcpGroup, NoOperation) {
     RealGroupTest(TestNoOperation);
@@ -86,6 +191,9 @@ TEST(RealTcpGroup, AllReduceHypercubeString) {
 TEST(RealTcpGroup, DispatcherSyncSendAsyncRead) {
     RealGroupTest(TestDispatcherSyncSendAsyncRead);
 }
+TEST(RealTcpGroup, DispatcherAsyncWriteBatched) {
+    RealGroupTest(TestDispatcherAsyncWriteBatched);
+}
 TEST(RealTcpGroup, DispatcherLaunchAndTerminate) {
     RealGroupTest(TestDispatcherLaunchAndTerminate);
 }
@@ -128,6 +236,9 @@ TEST(LocalTcpGroup, AllReduceHypercubeString) {
 TEST(LocalTcpGroup, DispatcherSyncSendAsyncRead) {
     LocalGroupTest(TestDispatcherSyncSendAsyncRead);
 }
+TEST(LocalTcpGroup, DispatcherAsyncWriteBatched) {
+    LocalGroupTest(TestDispatcherAsyncWriteBatched);
+}
 TEST(LocalTcpGroup, DispatcherLaunchAndTerminate) {
     LocalGroupTest(TestDispatcherLaunchAndTerminate);
 }
@@ -143,6 +254,9 @@ TEST(LocalTcpGroup, SingleThreadBroadcast) {
 TEST(LocalTcpGroup, MultiThreadBroadcast) {
     LocalGroupTest(TestMultiThreadBroadcast);
 }
+TEST(LocalTcpGroup, MultiThreadLocalBroadcast) {
+    LocalGroupTest(TestMultiThreadLocalBroadcast);
+}
 TEST(LocalTcpGroup, MultiThreadReduce) {
     LocalGroupTest(TestMultiThreadReduce);
 }
@@ -167,6 +281,90 @@ TEST(LocalTcpGroup, PredecessorOneItem) {
 TEST(LocalTcpGroup, HardcoreRaceConditionTest) {
     LocalGroupTest(TestHardcoreRaceConditionTest);
 }
+TEST(LocalShmGroup, NoOperation) {
+    LocalShmGroupTest(TestNoOperation);
+}
+TEST(LocalShmGroup, SendRecvCyclic) {
+    LocalShmGroupTest(TestSendRecvCyclic);
+}
+TEST(LocalShmGroup, BroadcastIntegral) {
+    LocalShmGroupTest(TestBroadcastIntegral);
+}
+TEST(LocalShmGroup, SendReceiveAll2All) {
+    LocalShmGroupTest(TestSendReceiveAll2All);
+}
+TEST(LocalShmGroup, PrefixSumHypercube) {
+    LocalShmGroupTest(TestPrefixSumHypercube);
+}
+TEST(LocalShmGroup, PrefixSumHypercubeString) {
+    LocalShmGroupTest(TestPrefixSumHypercubeString);
+}
+TEST(LocalShmGroup, PrefixSum) {
+    LocalShmGroupTest(TestPrefixSum);
+}
+TEST(LocalShmGroup, Broadcast) {
+    LocalShmGroupTest(TestBroadcast);
+}
+TEST(LocalShmGroup, Reduce) {
+    LocalShmGroupTest(TestReduce);
+}
+TEST(LocalShmGroup, ReduceString) {
+    LocalShmGroupTest(TestReduceString);
+}
+TEST(LocalShmGroup, AllReduceString) {
+    LocalShmGroupTest(TestAllReduceString);
+}
+TEST(LocalShmGroup, AllReduceHypercubeString) {
+    LocalShmGroupTest(TestAllReduceHypercubeString);
+}
+TEST(LocalShmGroup, DispatcherSyncSendAsyncRead) {
+    LocalShmGroupTest(TestDispatcherSyncSendAsyncRead);
+}
+TEST(LocalShmGroup, DispatcherAsyncWriteBatched) {
+    LocalShmGroupTest(TestDispatcherAsyncWriteBatched);
+}
+TEST(LocalShmGroup, DispatcherLaunchAndTerminate) {
+    LocalShmGroupTest(TestDispatcherLaunchAndTerminate);
+}
+TEST(LocalShmGroup, SingleThreadPrefixSum) {
+    LocalShmGroupTest(TestSingleThreadPrefixSum);
+}
+TEST(LocalShmGroup, SingleThreadVectorPrefixSum) {
+    LocalShmGroupTest(TestSingleThreadVectorPrefixSum);
+}
+TEST(LocalShmGroup, SingleThreadBroadcast) {
+    LocalShmGroupTest(TestSingleThreadBroadcast);
+}
+TEST(LocalShmGroup, MultiThreadBroadcast) {
+    LocalShmGroupTest(TestMultiThreadBroadcast);
+}
+TEST(LocalShmGroup, MultiThreadLocalBroadcast) {
+    LocalShmGroupTest(TestMultiThreadLocalBroadcast);
+}
+TEST(LocalShmGroup, MultiThreadReduce) {
+    LocalShmGroupTest(TestMultiThreadReduce);
+}
+TEST(LocalShmGroup, SingleThreadAllReduce) {
+    LocalShmGroupTest(TestSingleThreadAllReduce);
+}
+TEST(LocalShmGroup, MultiThreadAllReduce) {
+    LocalShmGroupTest(TestMultiThreadAllReduce);
+}
+TEST(LocalShmGroup, MultiThreadPrefixSum) {
+    LocalShmGroupTest(TestMultiThreadPrefixSum);
+}
+TEST(LocalShmGroup, PredecessorManyItems) {
+    LocalShmGroupTest(TestPredecessorManyItems);
+}
+TEST(LocalShmGroup, PredecessorFewItems) {
+    LocalShmGroupTest(TestPredecessorFewItems);
+}
+TEST(LocalShmGroup, PredecessorOneItem) {
+    LocalShmGroupTest(TestPredecessorOneItem);
+}
+TEST(LocalShmGroup, HardcoreRaceConditionTest) {
+    LocalShmGroupTest(TestHardcoreRaceConditionTest);
+}
 // [[[end]]]
 
 /******************************************************************************/
@@ -0,0 +1,230 @@
+/*******************************************************************************
+ * thrill/api/broadcast_join.hpp
+ *
+ * Broadcast (map-side) inner join: replicates a small DIA into a host-global
+ * hash table, which is then probed by a LOp on the large DIA.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_API_BROADCAST_JOIN_HEADER
+#define THRILL_API_BROADCAST_JOIN_HEADER
+
+#include <thrill/api/action_node.hpp>
+#include <thrill/api/dia.hpp>
+#include <thrill/common/logger.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace thrill {
+namespace api {
+
+/*!
+ * An ActionNode which gathers all items of a DIA on the first worker of each
+ * host and builds a hash table of them keyed by key_extractor. The hash table
+ * is shared among all workers of the host via a shared pointer, hence it is
+ * built only once per host and read concurrently by all local workers.
+ *
+ * The hash table is held in floating RAM outside of the node's memory limit,
+ * hence this is only suitable for small DIAs.
+ *
+ * \ingroup api_layer
+ */
+template <typename Table, typename KeyExtractor>
+class BroadcastHashTableNode final
+    : public ActionResultNode<std::shared_ptr<const Table> >
+{
+    static constexpr bool debug = false;
+
+    using ValueType =
+              typename common::FunctionTraits<KeyExtractor>::template arg_plain<0>;
+
+public:
+    using Super = ActionResultNode<std::shared_ptr<const Table> >;
+    using Super::context_;
+
+    template <typename ParentDIA>
+    BroadcastHashTableNode(const ParentDIA& parent,
+                           const KeyExtractor& key_extractor)
+        : Super(parent.ctx(), "BroadcastHashTable",
+                { parent.id() }, { parent.node() }),
+          parent_stack_empty_(ParentDIA::stack_empty),
+          key_extractor_(key_extractor)
+    {
+        auto pre_op_function = [this](const ValueType& input) {
+                                   PreOp(input);
+                               };
+
+        // close the function stack with our pre op and register it at parent
+        // node for output
+        auto lop_chain = parent.stack().push(pre_op_function).fold();
+        parent.node()->AddChild(this, lop_chain);
+    }
+
+    void StartPreOp(size_t /* id */) final {
+        emitters_ = stream_->GetWriters();
+    }
+
+    //! Send item only to the first worker of each host.
+    void PreOp(const ValueType& element) {
+        const size_t workers_per_host = context_.workers_per_host();
+        for (size_t i = 0; i < emitters_.size(); i += workers_per_host) {
+            emitters_[i].Put(element);
+        }
+    }
+
+    bool OnPreOpFile(const data::File& file, size_t /* parent_index */) final {
+        if (!parent_stack_empty_) return false;
+        const size_t workers_per_host = context_.workers_per_host();
+        for (size_t i = 0; i < emitters_.size(); i += workers_per_host) {
+            emitters_[i].AppendBlocks(file.blocks());
+        }
+        return true;
+    }
+
+    void StopPreOp(size_t /* id */) final {
+        // data has been pushed during pre-op -> close emitters
+        for (size_t i = 0; i < emitters_.size(); i++) {
+            emitters_[i].Close();
+        }
+    }
+
+    //! Receives the items on the host's first worker, builds the hash table
+    //! and shares it with all other local workers.
+    void Execute() final {
+        std::shared_ptr<Table> table;
+
+        auto reader = stream_->GetCatReader(/* consume */ true);
+        if (context_.local_worker_id() == 0) {
+            table = std::make_shared<Table>();
+            while (reader.HasNext()) {
+                ValueType item = reader.template Next<ValueType>();
+                table->emplace(key_extractor_(item), std::move(item));
+            }
+
+            Super::logger_
+                << "class" << "BroadcastHashTableNode"
+                << "event" << "done"
+                << "items" << table->size();
+        }
+        else {
+            // other local workers receive nothing.
+            assert(!reader.HasNext());
+        }
+        stream_->Close();
+
+        table_ = context_.net.LocalBroadcast(
+            std::shared_ptr<const Table>(std::move(table)));
+
+        LOG << "BroadcastHashTableNode: worker " << context_.my_rank()
+            << " got table with " << table_->size() << " items";
+    }
+
+    const std::shared_ptr<const Table>& result() const final {
+        return table_;
+    }
+
+private:
+    //! Whether the parent stack is empty
+    const bool parent_stack_empty_;
+
+    //! key extractor for the hash table
+    KeyExtractor key_extractor_;
+
+    //! host-global shared hash table
+    std::shared_ptr<const Table> table_;
+
+    data::CatStreamPtr stream_ { context_.GetNewCatStream(this) };
+    std::vector<data::CatStream::Writer> emitters_;
+};
+
+template <typename ValueType, typename Stack>
+template <typename KeyExtractor1, typename KeyExtractor2,
+          typename JoinFunction, typename HashFunction, typename SecondDIA>
+auto DIA<ValueType, Stack>::InnerJoin(
+    struct BroadcastTag const &,
+    const SecondDIA &second_dia,
+    const KeyExtractor1 &key_extractor1,
+    const KeyExtractor2 &key_extractor2,
+    const JoinFunction &join_function) const {
+
+    assert(IsValid());
+    assert(second_dia.IsValid());
+
+    static_assert(
+        std::is_convertible<
+            ValueType,
+            typename FunctionTraits<KeyExtractor1>::template arg<0>
+            >::value,
+        "KeyExtractor1 has the wrong input type");
+
+    static_assert(
+        std::is_convertible<
+            typename SecondDIA::ValueType,
+            typename FunctionTraits<KeyExtractor2>::template arg<0>
+            >::value,
+        "KeyExtractor2 has the wrong input type");
+
+    static_assert(
+        std::is_same<
+            typename FunctionTraits<KeyExtractor1>::result_type,
+            typename FunctionTraits<KeyExtractor2>::result_type>::value,
+        "KeyExtractor1 and KeyExtractor2 must return the same key type");
+
+    static_assert(
+        std::is_convertible<
+            ValueType,
+            typename FunctionTraits<JoinFunction>::template arg<0>
+            >::value,
+        "JoinFunction has the wrong first input type");
+
+    static_assert(
+        std::is_convertible<
+            typename FunctionTraits<KeyExtractor2>::template arg_plain<0>,
+            typename FunctionTraits<JoinFunction>::template arg<1>
+            >::value,
+        "JoinFunction has the wrong second input type");
+
+    using Key = typename FunctionTraits<KeyExtractor2>::result_type;
+    using SecondInput =
+              typename FunctionTraits<KeyExtractor2>::template arg_plain<0>;
+    using JoinResult = typename FunctionTraits<JoinFunction>::result_type;
+
+    using Table = std::unordered_multimap<Key, SecondInput, HashFunction>;
+
+    using BroadcastHashTableNode =
+              api::BroadcastHashTableNode<Table, KeyExtractor2>;
+
+    // build the host-global hash table from the small DIA immediately
+    auto node = common::MakeCounting<BroadcastHashTableNode>(
+        second_dia, key_extractor2);
+
+    node->RunScope();
+
+    std::shared_ptr<const Table> table = node->result();
+
+    // probe the hash table in the LOp function stack of this DIA
+    return FlatMap<JoinResult>(
+        [table, key_extractor1, join_function](
+            const ValueType& input, auto emit_func) {
+            auto range = table->equal_range(key_extractor1(input));
+            for (auto it = range.first; it != range.second; ++it)
+                emit_func(join_function(input, it->second));
+        });
+}
+
+} // namespace api
+} // namespace thrill
+
+#endif // !THRILL_API_BROADCAST_JOIN_HEADER
+
+/******************************************************************************/
@@ -16,6 +16,7 @@
 #include <thrill/common/linux_proc_stats.hpp>
 #include <thrill/common/logger.hpp>
 #include <thrill/common/math.hpp>
+#include <thrill/common/numa.hpp>
 #include <thrill/common/porting.hpp>
 #include <thrill/common/profile_thread.hpp>
 #include <thrill/common/string.hpp>
@@ -111,6 +112,17 @@ ConstructLoopbackHostContexts(
     return host_context;
 }
 
+//! Place a local worker on the cpu with the given machine-wide index, where
+//! cpus are enumerated NUMA node by node: the worker's ByteBlocks are allocated
+//! in the cpu's node. Returns the cpu to pin the worker's thread to.
+static inline size_t PlaceWorker(
+    HostContext& host_context, size_t local_worker_id, size_t cpu_index) {
+    const common::NumaTopology& numa = common::NumaTopology::Machine();
+    host_context.block_pool().SetWorkerNumaNode(
+        local_worker_id, numa.WorkerNode(cpu_index));
+    return numa.WorkerCpu(cpu_index);
+}
+
 //! Generic runner for backends supporting loopback tests.
 template <typename NetGroup>
 static inline void
@@ -134,6 +146,8 @@ RunLoopbackThreads(
         mem::by_string log_prefix = "host " + mem::to_string(host);
         for (size_t worker = 0; worker < workers_per_host; ++worker) {
             size_t id = host * workers_per_host + worker;
+            size_t cpu = PlaceWorker(
+                *host_contexts[host], worker, core_offset + id);
             threads[id] = common::CreateThread(
                 [&host_contexts, &job_startpoint, host, worker, log_prefix] {
                     Context ctx(*host_contexts[host], worker);
@@ -142,7 +156,7 @@ RunLoopbackThreads(
 
                     ctx.Launch(job_startpoint);
                 });
-            common::SetCpuAffinity(threads[id], core_offset + id);
+            common::SetCpuAffinity(threads[id], cpu);
         }
     }
 
@@ -513,6 +527,7 @@ int RunBackendTcp(const std::function<void(Context&)>& job_startpoint) {
     std::vector<std::thread> threads(workers_per_host);
 
     for (size_t worker = 0; worker < workers_per_host; worker++) {
+        size_t cpu = PlaceWorker(host_context, worker, worker);
         threads[worker] = common::CreateThread(
             [&host_context, &job_startpoint, worker] {
                 Context ctx(host_context, worker);
@@ -520,7 +535,7 @@ int RunBackendTcp(const std::function<void(Context&)>& job_startpoint) {
 
                 ctx.Launch(job_startpoint);
             });
-        common::SetCpuAffinity(threads[worker], worker);
+        common::SetCpuAffinity(threads[worker], cpu);
     }
 
     // join worker threads
@@ -599,6 +614,7 @@ int RunBackendMpi(const std::function<void(Context&)>& job_startpoint) {
     std::vector<std::thread> threads(workers_per_host);
 
     for (size_t worker = 0; worker < workers_per_host; worker++) {
+        size_t cpu = PlaceWorker(host_context, worker, worker);
         threads[worker] = common::CreateThread(
             [&host_context, &job_startpoint, worker] {
                 Context ctx(host_context, worker);
@@ -607,7 +623,7 @@ int RunBackendMpi(const std::function<void(Context&)>& job_startpoint) {
 
                 ctx.Launch(job_startpoint);
             });
-        common::SetCpuAffinity(threads[worker], worker);
+        common::SetCpuAffinity(threads[worker], cpu);
     }
 
     // join worker threads
@@ -686,6 +702,7 @@ int RunBackendIb(const std::function<void(Context&)>& job_startpoint) {
     std::vector<std::thread> threads(workers_per_host);
 
     for (size_t worker = 0; worker < workers_per_host; worker++) {
+        size_t cpu = PlaceWorker(host_context, worker, worker);
         threads[worker] = common::CreateThread(
             [&host_context, &job_startpoint, worker] {
                 Context ctx(host_context, worker);
@@ -694,7 +711,7 @@ int RunBackendIb(const std::function<void(Context&)>& job_startpoint) {
 
                 ctx.Launch(job_startpoint);
             });
-        common::SetCpuAffinity(threads[worker], worker);
+        common::SetCpuAffinity(threads[worker], cpu);
     }
 
     // join worker threads
@@ -914,6 +931,43 @@ int MemoryConfig::setup_detect() {
 #endif
     }
 
+    // optionally compress blocks written to external memory
+
+    const char* env_compress_swap = getenv("THRILL_COMPRESS_SWAP");
+
+    compress_swap_ = (env_compress_swap && *env_compress_swap &&
+                      strcmp(env_compress_swap, "0") != 0);
+
+    // optionally compress blocks sent over the network by DIA operations
+
+    const char* env_compress_net = getenv("THRILL_COMPRESS_NET");
+
+    compress_net_ = (env_compress_net && *env_compress_net &&
+                     strcmp(env_compress_net, "0") != 0);
+
+    // select policy for evicting blocks to external memory
+
+    const char* env_eviction = getenv("THRILL_EVICTION");
+
+    if (env_eviction && *env_eviction) {
+        if (!data::EvictionPolicy::Make(env_eviction)) {
+            std::cerr << "Thrill: environment variable"
+                      << " THRILL_EVICTION=" << env_eviction
+                      << " is not a valid eviction policy"
+                      << " (lru, consume, or priority)."
+                      << std::endl;
+            return -1;
+        }
+        eviction_policy_ = env_eviction;
+    }
+
+    // optionally map local binary input files into memory
+
+    const char* env_mmap_read = getenv("THRILL_MMAP_READ");
+
+    mmap_read_ = (env_mmap_read && *env_mmap_read &&
+                  strcmp(env_mmap_read, "0") != 0);
+
     apply();
 
     return 0;
@@ -953,7 +1007,8 @@ void MemoryConfig::print(size_t workers_per_host) const {
         << " BlockPool=" << common::FormatIecUnits(ram_block_pool_hard_) << "B,"
         << " workers="
         << common::FormatIecUnits(ram_workers_ / workers_per_host) << "B,"
-        << " floating=" << common::FormatIecUnits(ram_floating_) << "B."
+        << " floating=" << common::FormatIecUnits(ram_floating_) << "B"
+        << (compress_swap_ ? ", compressing swap." : ".")
         << std::endl;
 }
 
@@ -1024,7 +1079,10 @@ data::FilePtr Context::GetFilePtr(DIABase* dia) {
 }
 
 data::CatStreamPtr Context::GetNewCatStream(size_t dia_id) {
-    return multiplexer_.GetNewCatStream(local_worker_id_, dia_id);
+    data::CatStreamPtr stream =
+        multiplexer_.GetNewCatStream(local_worker_id_, dia_id);
+    stream->set_compress(mem_config_.compress_net_);
+    return stream;
 }
 
 data::CatStreamPtr Context::GetNewCatStream(DIABase* dia) {
@@ -1032,7 +1090,10 @@ data::CatStreamPtr Context::GetNewCatStream(DIABase* dia) {
 }
 
 data::MixStreamPtr Context::GetNewMixStream(size_t dia_id) {
-    return multiplexer_.GetNewMixStream(local_worker_id_, dia_id);
+    data::MixStreamPtr stream =
+        multiplexer_.GetNewMixStream(local_worker_id_, dia_id);
+    stream->set_compress(mem_config_.compress_net_);
+    return stream;
 }
 
 data::MixStreamPtr Context::GetNewMixStream(DIABase* dia) {
@@ -74,6 +74,23 @@ public:
     //! remaining free-floating RAM used for user and Thrill data structures.
     size_t ram_floating_;
 
+    //! compress ByteBlocks evicted by data::BlockPool to external memory,
+    //! enabled by THRILL_COMPRESS_SWAP.
+    bool compress_swap_ = false;
+
+    //! name of data::EvictionPolicy of the data::BlockPool, selected by
+    //! THRILL_EVICTION.
+    std::string eviction_policy_ = "lru";
+
+    //! compress Blocks sent over the network by the Streams of DIA
+    //! operations, enabled by THRILL_COMPRESS_NET.
+    bool compress_net_ = false;
+
+    //! map uncompressed local ReadBinary() inputs read-only into memory
+    //! instead of reading them into the data::BlockPool, enabled by
+    //! THRILL_MMAP_READ.
+    bool mmap_read_ = false;
+
     //! StageBuilder verbosity flag
     bool verbose_ = true;
 };
@@ -182,7 +199,8 @@ private:
     //! data block pool
     data::BlockPool block_pool_ {
         mem_config_.ram_block_pool_soft_, mem_config_.ram_block_pool_hard_,
-        &logger_, &mem_manager_, workers_per_host_
+        &logger_, &mem_manager_, workers_per_host_,
+        mem_config_.compress_swap_, mem_config_.eviction_policy_
     };
 
 #if !THRILL_HAVE_THREAD_SANITIZER
@@ -77,6 +77,30 @@ struct NoRebalanceTag {
 //! global const NoRebalanceTag instance
 const struct NoRebalanceTag NoRebalanceTag;
 
+//! tag structure for InnerJoin()
+struct BroadcastTag {
+    BroadcastTag() { }
+};
+
+//! global const BroadcastTag instance
+const struct BroadcastTag BroadcastTag;
+
+//! tag structure for Sort()
+struct SkewAwareTag {
+    SkewAwareTag() { }
+};
+
+//! global const SkewAwareTag instance
+const struct SkewAwareTag SkewAwareTag;
+
+//! tag structure for GroupByKey()
+struct HashGroupTag {
+    HashGroupTag() { }
+};
+
+//! global const HashGroupTag instance
+const struct HashGroupTag HashGroupTag;
+
 //! tag structure for Read()
 struct LocalStorageTag {
     LocalStorageTag() { }
@@ -271,6 +295,19 @@ public:
         return *this;
     }
 
+    /*!
+     * Set the priority of the referenced DIANode's data for eviction to
+     * external memory, which is used if THRILL_EVICTION=priority: blocks of
+     * DIAs with lower priority are evicted first, the default is zero. This
+     * does not create a new DIA, but returns the existing one.
+     */
+    const DIA& EvictionPriority(int priority) const {
+        assert(IsValid());
+        node_->context().block_pool().SetDiaEvictionPriority(
+            node_->id(), priority, node_->context().local_worker_id());
+        return *this;
+    }
+
     /*!
      * Execute DIA's scope and parents such that this (Action)Node is
      * Executed. This does not create a new DIA, but returns the existing one.
@@ -1171,6 +1208,31 @@ public:
     auto GroupByKey(const KeyExtractor &key_extractor,
                     const GroupByFunction &groupby_function) const;
 
+    /*!
+     * GroupByKey with hash grouping: the received items are bucketed by key in
+     * memory instead of sorted, and only if they exceed the memory limit, they
+     * are spilled into hash-partitioned Files, which are then grouped one after
+     * another. The groups are processed in arbitrary order instead of by
+     * ascending key, which saves the O(n log n) sort. Only spill Files which
+     * remain too large after repeated partitioning, e.g. due to a single very
+     * frequent key, are sorted externally.
+     *
+     * \param key_extractor Key extractor function, which maps each element to a
+     * key of possibly different type.
+     *
+     * \param groupby_function Reduce function, which defines how the key
+     * buckets are grouped and processed.
+     *      input param: api::GroupByReader with functions HasNext() and Next()
+     *
+     * \ingroup dia_dops
+     */
+    template <typename ValueOut, typename KeyExtractor,
+              typename GroupByFunction, typename HashFunction =
+                  std::hash<typename FunctionTraits<KeyExtractor>::result_type> >
+    auto GroupByKey(struct HashGroupTag const &,
+                    const KeyExtractor &key_extractor,
+                    const GroupByFunction &groupby_function) const;
+
     /*!
      * GroupBy is a DOp, which groups elements of the DIA by its key.
      * After having grouped all elements of one key, all elements of one key
@@ -1225,6 +1287,11 @@ public:
      * The two input DIAs are required to be of equal size, otherwise use the
      * CutTag variant.
      *
+     * The result is distributed among the workers like the outputs of
+     * Generate(), ReduceToIndex(), and GroupToIndex(). Inputs which already
+     * have this distribution on all workers, e.g. Cache()s of such DIAs, are
+     * not exchanged but read locally.
+     *
      * \tparam ZipFunction Type of the zip_function. This is a function with two
      * input elements, both of the local type, and one output element, which is
      * the type of the Zip node.
@@ -1314,6 +1381,107 @@ public:
     auto Zip(struct NoRebalanceTag const &, const SecondDIA &second_dia,
              const ZipFunction &zip_function) const;
 
+    /*!
+     * InnerJoin is a DOp, which performs an equi-join of this DIA with a second
+     * DIA. Each pair of items from both DIAs whose keys, as given by the two
+     * key extractors, are equal is combined by the join_function into an item
+     * of the output DIA.
+     *
+     * Both DIAs are hash-partitioned by key among the workers. Locally, the
+     * smaller side is loaded into a hash table and probed with the larger
+     * side. If the smaller side does not fit into RAM, both sides are sorted
+     * and merged instead, which requires an operator< on the key type.
+     *
+     * \param second_dia DIA, which is joined with this DIA.
+     *
+     * \param key_extractor1 Key extractor function for items of this DIA.
+     *
+     * \param key_extractor2 Key extractor function for items of the second
+     * DIA, it must return the same key type as key_extractor1.
+     *
+     * \param join_function Join function, which combines an item of this DIA
+     * and an item of the second DIA with equal keys into an output item.
+     *
+     * \ingroup dia_dops
+     */
+    template <typename KeyExtractor1, typename KeyExtractor2,
+              typename JoinFunction, typename HashFunction =
+                  std::hash<typename FunctionTraits<KeyExtractor1>::result_type>,
+              typename SecondDIA>
+    auto InnerJoin(const SecondDIA &second_dia,
+                   const KeyExtractor1 &key_extractor1,
+                   const KeyExtractor2 &key_extractor2,
+                   const JoinFunction &join_function) const;
+
+    /*!
+     * InnerJoin with BroadcastTag performs an equi-join of this (large) DIA
+     * with a small second DIA without shuffling this DIA. The second DIA is
+     * immediately gathered onto each host and loaded into a hash table, which
+     * is shared by all workers of the host. The items of this DIA are then
+     * joined by probing the hash table in a LOp, hence the result DIA is a
+     * FlatMap of this DIA.
+     *
+     * The second DIA must fit into the RAM of each host.
+     *
+     * \param second_dia Small DIA, which is replicated to all hosts.
+     *
+     * \param key_extractor1 Key extractor function for items of this DIA.
+     *
+     * \param key_extractor2 Key extractor function for items of the second
+     * DIA, it must return the same key type as key_extractor1.
+     *
+     * \param join_function Join function, which combines an item of this DIA
+     * and an item of the second DIA with equal keys into an output item.
+     *
+     * \ingroup dia_dops
+     */
+    template <typename KeyExtractor1, typename KeyExtractor2,
+              typename JoinFunction, typename HashFunction =
+                  std::hash<typename FunctionTraits<KeyExtractor1>::result_type>,
+              typename SecondDIA>
+    auto InnerJoin(struct BroadcastTag const &,
+                   const SecondDIA &second_dia,
+                   const KeyExtractor1 &key_extractor1,
+                   const KeyExtractor2 &key_extractor2,
+                   const JoinFunction &join_function) const;
+
+    /*!
+     * SemiJoinFilter removes items of this (large) DIA whose keys do not occur
+     * in a small second DIA, before this DIA is shuffled by a following join
+     * or reduction. The keys of the second DIA are immediately inserted into a
+     * Bloom filter, whose bit arrays are merged among all workers by an
+     * AllReduce. The items of this DIA are then tested against the filter in a
+     * LOp, hence the result DIA is a Filter of this DIA and non-matching items
+     * never reach the network.
+     *
+     * The Bloom filter has false positives, hence some items without matching
+     * key may remain, which the following join must drop.
+     *
+     * \param second_dia Small DIA, whose keys are inserted into the filter.
+     *
+     * \param key_extractor1 Key extractor function for items of this DIA.
+     *
+     * \param key_extractor2 Key extractor function for items of the second
+     * DIA, it must return the same key type as key_extractor1.
+     *
+     * \param bits_per_key Size of the Bloom filter in bits per key of the
+     * second DIA, ten bits yield about 1% false positives.
+     *
+     * \param hash_function Hash function of the keys.
+     *
+     * \ingroup dia_lops
+     */
+    template <typename KeyExtractor1, typename KeyExtractor2,
+              typename HashFunction =
+                  std::hash<typename FunctionTraits<KeyExtractor1>::result_type>,
+              typename SecondDIA>
+    auto SemiJoinFilter(const SecondDIA &second_dia,
+                        const KeyExtractor1 &key_extractor1,
+                        const KeyExtractor2 &key_extractor2,
+                        size_t bits_per_key = 10,
+                        const HashFunction &hash_function = HashFunction())
+    const;
+
     /*!
      * Zips each item of a DIA with its zero-based array index. This requires a
      * full data store/retrieve cycle because the input DIA's size is generally
@@ -1351,7 +1519,8 @@ public:
      * true, if first element is smaller than second. False otherwise.
      *
      * \param sort_algorithm Algorithm class used to sort items. Merging is
-     * always done using a tournament tree with compare_function.
+     * always done using a tournament tree with compare_function. Use
+     * ParallelSortAlgorithm to sort runs with multiple threads per worker.
      *
      * \ingroup dia_dops
      */
@@ -1359,6 +1528,28 @@ public:
     auto Sort(const CompareFunction &compare_function,
               const SortFunction &sort_algorithm) const;
 
+    /*!
+     * Sort with SkewAwareTag is a DOp, which sorts a given DIA according to the
+     * given compare_function, like Sort(). The splitters are selected at the
+     * quantiles of the sample weighted by the number of items each worker's
+     * samples represent, and the partition sizes are estimated from the
+     * sample. If a worker would receive more than (1 + epsilon) times the
+     * average number of items, the splitters are selected again from a larger
+     * sample drawn by random access. Only if the estimate is too inaccurate to
+     * decide, the partition sizes are counted in a pass over the local items.
+     *
+     * \tparam CompareFunction Type of the compare_function.
+     *  Should be (ValueType,ValueType)->bool
+     *
+     * \param compare_function Function, which compares two elements. Returns
+     * true, if first element is smaller than second. False otherwise.
+     *
+     * \ingroup dia_dops
+     */
+    template <typename CompareFunction = std::less<ValueType> >
+    auto Sort(struct SkewAwareTag const &,
+              const CompareFunction &compare_function = CompareFunction()) const;
+
     /*!
      * Merge is a DOp, which merges two sorted DIAs to a single sorted DIA.
      * Both input DIAs must be used sorted conforming to the given comparator.
@@ -1575,6 +1766,15 @@ using api::PadTag;
 //! imported from api namespace
 using api::NoRebalanceTag;
 
+//! imported from api namespace
+using api::BroadcastTag;
+
+//! imported from api namespace
+using api::SkewAwareTag;
+
+//! imported from api namespace
+using api::HashGroupTag;
+
 } // namespace thrill
 
 #endif // !THRILL_API_DIA_HEADER
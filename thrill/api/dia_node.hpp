@@ -136,8 +136,19 @@ public:
             DecConsumeCounter(1);
 
         bool consume = context().consume() && consume_counter() == 0;
+        // the data is disposed afterwards, hence writing it to external
+        // memory is wasted I/O: let the BlockPool evict it last.
+        if (consume) {
+            context().block_pool().SetDiaEvictionPriority(
+                id(), data::EvictionPolicy::kDisposeSoon,
+                context().local_worker_id());
+        }
         PushData(consume);
-        if (consume) Dispose();
+        if (consume) {
+            Dispose();
+            context().block_pool().ClearDiaEvictionPriority(
+                id(), context().local_worker_id());
+        }
 
         for (const Child& child : children_)
             child.node->StopPreOp(child.parent_index);
@@ -34,7 +34,8 @@ namespace api {
 
 // forward declarations for friend classes
 template <typename ValueType,
-          typename KeyExtractor, typename GroupFunction, typename HashFunction>
+          typename KeyExtractor, typename GroupFunction, typename HashFunction,
+          bool UseHashing>
 class GroupByNode;
 
 template <typename ValueType,
@@ -49,7 +50,8 @@ class GroupByIterator
     template <typename T1,
               typename T2,
               typename T3,
-              typename T4>
+              typename T4,
+              bool B5>
     friend class GroupByNode;
 
     template <typename T1,
@@ -131,7 +133,8 @@ class GroupByMultiwayMergeIterator
     template <typename T1,
               typename T2,
               typename T3,
-              typename T4>
+              typename T4,
+              bool B5>
     friend class GroupByNode;
 
     template <typename T1,
@@ -19,9 +19,12 @@
 #include <thrill/api/group_by_iterator.hpp>
 #include <thrill/common/functional.hpp>
 #include <thrill/common/logger.hpp>
+#include <thrill/core/parallel_multiway_merge.hpp>
+#include <thrill/core/reduce_functional.hpp>
 
 #include <algorithm>
 #include <functional>
+#include <thread>
 #include <type_traits>
 #include <typeinfo>
 #include <utility>
@@ -31,10 +34,17 @@ namespace thrill {
 namespace api {
 
 /*!
+ * A DIANode which groups the items by key. Without UseHashing, the received
+ * items are sorted into runs which are multiway merged. With UseHashing, they
+ * are bucketed by the hash of their key into a single File of consecutive
+ * groups, which falls back to hash-partitioned spill Files if the items do not
+ * fit into the memory limit.
+ *
  * \ingroup api_layer
  */
 template <typename ValueType,
-          typename KeyExtractor, typename GroupFunction, typename HashFunction>
+          typename KeyExtractor, typename GroupFunction, typename HashFunction,
+          bool UseHashing>
 class GroupByNode final : public DOpNode<ValueType>
 {
     static constexpr bool debug = false;
@@ -101,8 +111,29 @@ public:
             emitter_[i].Close();
     }
 
+    DIAMemUse ExecuteMemUse() final {
+        if (UseHashing)
+            return DIAMemUse::Max();
+        else
+            return 0;
+    }
+
     void Execute() override {
-        MainOp();
+        if (UseHashing)
+            MainOpHash();
+        else
+            MainOp();
+    }
+
+    DIAMemUse PushDataMemUse() final {
+        if (files_.size() <= 1) {
+            // direct push, no merge necessary
+            return 0;
+        }
+        else {
+            // need to perform multiway merging
+            return DIAMemUse::Max();
+        }
     }
 
     void PushData(bool consume) final {
@@ -116,6 +147,10 @@ public:
             // if there's only one run, call user funcs
             RunUserFunc(files_[0], consume);
         }
+        else if (MergeParallel()) {
+            // runs were merged into one File, call user funcs
+            RunUserFunc(files_[0], consume);
+        }
         else {
             // otherwise sort all runs using multiway merge
             LOG << "start multiwaymerge";
@@ -165,6 +200,40 @@ private:
     data::File sorted_elems_ { context_.GetFile(this) };
     size_t totalsize_ = 0;
 
+    //! maximum recursion depth of hash-partitioning spill Files, beyond which
+    //! Files which are still too large are sorted externally.
+    static constexpr size_t max_spill_levels_ = 3;
+
+    //! Merge runs concurrently in disjoint key ranges into a single File, if
+    //! more than one thread per worker is available and the runs fit into the
+    //! memory limit, since the merged File is materialized.
+    bool MergeParallel() {
+        const size_t prefetch = 1;
+        const size_t num_threads = std::max<size_t>(
+            1, std::thread::hardware_concurrency() / context_.workers_per_host());
+        size_t total_bytes = 0;
+        for (const data::File& file : files_)
+            total_bytes += file.size_bytes();
+        const size_t num_parts = core::parallel_merge_degree(
+            num_threads, files_.size(), total_bytes,
+            DIABase::mem_limit_, prefetch);
+
+        if (num_parts <= 1) return false;
+
+        LOG << "parallel multiwaymerge of " << files_.size()
+            << " runs into " << num_parts << " parts";
+
+        data::File merged = core::parallel_multiway_merge<ValueIn>(
+            files_.begin(), files_.end(), num_parts, prefetch,
+            ValueComparator(*this),
+            [this]() { return context_.GetFile(this); });
+
+        files_.clear();
+        files_.emplace_back(std::move(merged));
+
+        return true;
+    }
+
     void RunUserFunc(data::File& f, bool consume) {
         auto r = f.GetReader(consume);
         if (r.HasNext()) {
@@ -230,6 +299,220 @@ private:
             << " time=" << timer
             << " number_files=" << files_.size();
     }
+
+    //! \name Hash Grouping
+    //! \{
+
+    //! Receive elements from other workers and group them by hashing into a
+    //! single File.
+    void MainOpHash() {
+        LOG << "running hash group by main op";
+
+        // M/2 such that the other half is used for writing, with room for
+        // the bucket arrays of GroupVector() per item.
+        const size_t capacity = std::max<size_t>(
+            1, DIABase::mem_limit_
+            / (sizeof(ValueIn) + 4 * sizeof(size_t)) / 2);
+
+        std::vector<ValueIn> incoming;
+        std::vector<data::File> spill_files;
+        std::vector<data::File::Writer> spill_writers;
+        size_t num_spilled = 0;
+
+        common::StatsTimerStart timer;
+        auto reader = stream_->GetCatReader(/* consume */ true);
+        while (reader.HasNext()) {
+            // if vector is full, partition it into spill Files
+            if (mem::memory_exceeded || incoming.size() >= capacity) {
+                if (spill_files.empty())
+                    OpenSpillFiles(spill_files, spill_writers);
+                num_spilled += incoming.size();
+                SpillVector(incoming, spill_writers);
+            }
+            incoming.emplace_back(reader.template Next<ValueIn>());
+        }
+        stream_->Close();
+
+        files_.emplace_back(context_.GetFile(this));
+        data::File::Writer writer = files_.back().GetWriter();
+
+        if (spill_files.empty()) {
+            GroupVector(incoming, writer);
+        }
+        else {
+            num_spilled += incoming.size();
+            SpillVector(incoming, spill_writers);
+            std::vector<ValueIn>().swap(incoming);
+
+            for (data::File::Writer& w : spill_writers) w.Close();
+            spill_writers.clear();
+
+            for (data::File& f : spill_files)
+                GroupFile(f, writer, 1, capacity);
+        }
+        writer.Close();
+        totalsize_ += files_.back().num_items();
+
+        timer.Stop();
+
+        LOG << "RESULT"
+            << " name=mainop_hash"
+            << " time=" << timer
+            << " spilled_items=" << num_spilled
+            << " spill_files=" << spill_files.size();
+    }
+
+    //! Create spill Files for hash-partitioning, as many as write buffers fit
+    //! into a fraction of the memory limit.
+    void OpenSpillFiles(std::vector<data::File>& files,
+                        std::vector<data::File::Writer>& writers) {
+        const size_t num_files = std::max<size_t>(
+            2, std::min<size_t>(
+                64, DIABase::mem_limit_ / data::default_block_size / 4));
+        for (size_t i = 0; i < num_files; ++i)
+            files.emplace_back(context_.GetFile(this));
+        for (data::File& f : files)
+            writers.emplace_back(f.GetWriter());
+    }
+
+    //! Write the items of v to the first level spill Files and clear it.
+    void SpillVector(std::vector<ValueIn>& v,
+                     std::vector<data::File::Writer>& writers) {
+        for (const ValueIn& e : v)
+            writers[SpillIndex(e, 1, writers.size())].Put(e);
+        v.clear();
+    }
+
+    //! Spill File of an item at a level of hash-partitioning, using
+    //! independent hashes for each level.
+    size_t SpillIndex(const ValueIn& v, size_t level, size_t num_files) const {
+        return core::Hash128to64(level, hash_function_(key_extractor_(v)))
+               % num_files;
+    }
+
+    //! Group the items of a spill File into writer. If the File is too large,
+    //! partition it again by a different hash.
+    void GroupFile(data::File& file, data::File::Writer& writer,
+                   size_t level, size_t capacity) {
+        if (file.num_items() <= capacity) {
+            std::vector<ValueIn> v;
+            v.reserve(file.num_items());
+            auto reader = file.GetConsumeReader();
+            while (reader.HasNext())
+                v.emplace_back(reader.template Next<ValueIn>());
+            GroupVector(v, writer);
+            return;
+        }
+
+        if (level >= max_spill_levels_) {
+            // repartitioning does not help, e.g. the File contains a key with
+            // more than capacity items.
+            SortFile(file, writer, capacity);
+            return;
+        }
+
+        LOG << "repartitioning spill file with " << file.num_items()
+            << " items at level " << level;
+
+        std::vector<data::File> files;
+        std::vector<data::File::Writer> writers;
+        OpenSpillFiles(files, writers);
+        {
+            auto reader = file.GetConsumeReader();
+            while (reader.HasNext()) {
+                ValueIn e = reader.template Next<ValueIn>();
+                writers[SpillIndex(e, level + 1, writers.size())].Put(e);
+            }
+        }
+        for (data::File::Writer& w : writers) w.Close();
+        writers.clear();
+
+        for (data::File& f : files)
+            GroupFile(f, writer, level + 1, capacity);
+    }
+
+    //! Group the items of a File which does not fit into memory by an
+    //! external sort: sort runs of capacity items and merge them into writer.
+    void SortFile(data::File& file, data::File::Writer& writer,
+                  size_t capacity) {
+        LOG << "sorting oversized spill file with " << file.num_items()
+            << " items";
+
+        std::vector<data::File> runs;
+        {
+            std::vector<ValueIn> v;
+            v.reserve(capacity);
+            auto reader = file.GetConsumeReader();
+            while (reader.HasNext()) {
+                while (reader.HasNext() && v.size() < capacity)
+                    v.emplace_back(reader.template Next<ValueIn>());
+                std::sort(v.begin(), v.end(), ValueComparator(*this));
+
+                runs.emplace_back(context_.GetFile(this));
+                data::File::Writer w = runs.back().GetWriter();
+                for (const ValueIn& e : v)
+                    w.Put(e);
+                w.Close();
+                v.clear();
+            }
+        }
+
+        std::vector<data::File::ConsumeReader> seq;
+        seq.reserve(runs.size());
+        for (data::File& f : runs)
+            seq.emplace_back(f.GetConsumeReader());
+
+        auto puller = core::make_multiway_merge_tree<ValueIn>(
+            seq.begin(), seq.end(), ValueComparator(*this));
+        while (puller.HasNext())
+            writer.Put(puller.Next());
+    }
+
+    //! Write the items of v to writer such that items with equal keys are
+    //! consecutive: a counting sort distributes them into as many buckets as
+    //! there are items by a hash of their key, and the few keys colliding in a
+    //! bucket are separated by comparing them.
+    void GroupVector(std::vector<ValueIn>& v, data::File::Writer& writer) {
+        const size_t n = v.size();
+        if (n == 0) return;
+
+        // bucket of each item, and the beginning of each bucket
+        std::vector<size_t> bucket(n);
+        std::vector<size_t> begin(n + 1, 0);
+        for (size_t i = 0; i < n; ++i) {
+            bucket[i] = core::Hash128to64(
+                0, hash_function_(key_extractor_(v[i]))) % n;
+            ++begin[bucket[i] + 1];
+        }
+        for (size_t b = 1; b <= n; ++b)
+            begin[b] += begin[b - 1];
+
+        // order the item indexes by bucket
+        std::vector<size_t> order(n);
+        {
+            std::vector<size_t> fill(begin.begin(), begin.end() - 1);
+            for (size_t i = 0; i < n; ++i)
+                order[fill[bucket[i]]++] = i;
+        }
+        std::vector<size_t>().swap(bucket);
+
+        std::vector<bool> done(n, false);
+        for (size_t b = 0; b < n; ++b) {
+            for (size_t i = begin[b]; i < begin[b + 1]; ++i) {
+                if (done[i]) continue;
+                const Key key = key_extractor_(v[order[i]]);
+                writer.Put(v[order[i]]);
+                for (size_t j = i + 1; j < begin[b + 1]; ++j) {
+                    if (done[j] || !(key_extractor_(v[order[j]]) == key))
+                        continue;
+                    writer.Put(v[order[j]]);
+                    done[j] = true;
+                }
+            }
+        }
+    }
+
+    //! \}
 };
 
 /******************************************************************************/
@@ -251,7 +534,35 @@ auto DIA<ValueType, Stack>::GroupByKey(
         "KeyExtractor has the wrong input type");
 
     using GroupByNode = api::GroupByNode<
-              DOpResult, KeyExtractor, GroupFunction, HashFunction>;
+              DOpResult, KeyExtractor, GroupFunction, HashFunction,
+              /* UseHashing */ false>;
+
+    auto node = common::MakeCounting<GroupByNode>(
+        *this, key_extractor, groupby_function);
+
+    return DIA<DOpResult>(node);
+}
+
+template <typename ValueType, typename Stack>
+template <typename ValueOut, typename KeyExtractor,
+          typename GroupFunction, typename HashFunction>
+auto DIA<ValueType, Stack>::GroupByKey(
+    struct HashGroupTag const &,
+    const KeyExtractor &key_extractor,
+    const GroupFunction &groupby_function) const {
+
+    using DOpResult = ValueOut;
+
+    static_assert(
+        std::is_same<
+            typename std::decay<typename common::FunctionTraits<KeyExtractor>
+                                ::template arg<0> >::type,
+            ValueType>::value,
+        "KeyExtractor has the wrong input type");
+
+    using GroupByNode = api::GroupByNode<
+              DOpResult, KeyExtractor, GroupFunction, HashFunction,
+              /* UseHashing */ true>;
 
     auto node = common::MakeCounting<GroupByNode>(
         *this, key_extractor, groupby_function);
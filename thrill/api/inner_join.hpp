@@ -0,0 +1,543 @@
+/*******************************************************************************
+ * thrill/api/inner_join.hpp
+ *
+ * DIANode for an inner join operation. Performs a distributed equi-join of two
+ * DIAs by hash-partitioning both inputs.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_API_INNER_JOIN_HEADER
+#define THRILL_API_INNER_JOIN_HEADER
+
+#include <thrill/api/dia.hpp>
+#include <thrill/api/dop_node.hpp>
+#include <thrill/common/functional.hpp>
+#include <thrill/common/logger.hpp>
+#include <thrill/core/multiway_merge.hpp>
+#include <thrill/data/file.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace thrill {
+namespace api {
+
+/*!
+ * A DIANode which performs an inner equi-join of two DIAs. Items of both
+ * inputs are hash-partitioned by their key to the workers in the PreOps, such
+ * that all items with equal key meet on the same worker.
+ *
+ * Locally, the smaller of both received inputs is loaded into a hash table,
+ * which is then probed with all items of the larger input. If the smaller input
+ * does not fit into the memory assigned to the node, both inputs are sorted
+ * into runs of Files instead, and the join is performed by merging the two
+ * sorted sequences. The fallback requires that the key type supports
+ * operator<.
+ *
+ * \tparam ValueType Output type of the join operation.
+ *
+ * \tparam KeyExtractor1 Type of the key extractor of the first input.
+ *
+ * \tparam KeyExtractor2 Type of the key extractor of the second input.
+ *
+ * \tparam JoinFunction Type of the join function, which combines two items.
+ *
+ * \tparam HashFunction Type of the hash function used to partition keys.
+ *
+ * \ingroup api_layer
+ */
+template <typename ValueType,
+          typename KeyExtractor1, typename KeyExtractor2,
+          typename JoinFunction, typename HashFunction>
+class JoinNode final : public DOpNode<ValueType>
+{
+    static constexpr bool debug = false;
+
+    using Super = DOpNode<ValueType>;
+    using Super::context_;
+
+    using InputTypeFirst =
+              typename common::FunctionTraits<KeyExtractor1>::template arg_plain<0>;
+    using InputTypeSecond =
+              typename common::FunctionTraits<KeyExtractor2>::template arg_plain<0>;
+
+    using Key = typename common::FunctionTraits<KeyExtractor1>::result_type;
+
+    //! Comparator of items by their key, used for the sort-merge fallback.
+    template <typename Input, typename KeyExtractor>
+    class KeyComparator
+    {
+    public:
+        explicit KeyComparator(const KeyExtractor& key_extractor)
+            : key_extractor_(key_extractor) { }
+
+        bool operator () (const Input& a, const Input& b) const {
+            return key_extractor_(a) < key_extractor_(b);
+        }
+
+    private:
+        const KeyExtractor& key_extractor_;
+    };
+
+    using ComparatorFirst = KeyComparator<InputTypeFirst, KeyExtractor1>;
+    using ComparatorSecond = KeyComparator<InputTypeSecond, KeyExtractor2>;
+
+public:
+    /*!
+     * Constructor for a JoinNode.
+     */
+    template <typename ParentDIA0, typename ParentDIA1>
+    JoinNode(const ParentDIA0& parent0, const ParentDIA1& parent1,
+             const KeyExtractor1& key_extractor1,
+             const KeyExtractor2& key_extractor2,
+             const JoinFunction& join_function,
+             const HashFunction& hash_function = HashFunction())
+        : Super(parent0.ctx(), "InnerJoin",
+                { parent0.id(), parent1.id() },
+                { parent0.node(), parent1.node() }),
+          key_extractor1_(key_extractor1),
+          key_extractor2_(key_extractor2),
+          join_function_(join_function),
+          hash_function_(hash_function)
+    {
+        // Hook PreOps of both parents
+        auto pre_op0_fn = [this](const InputTypeFirst& input) {
+                              writers0_[
+                                  hash_function_(key_extractor1_(input))
+                                  % writers0_.size()].Put(input);
+                          };
+        auto pre_op1_fn = [this](const InputTypeSecond& input) {
+                              writers1_[
+                                  hash_function_(key_extractor2_(input))
+                                  % writers1_.size()].Put(input);
+                          };
+
+        // close the function stacks with our pre ops and register them at
+        // the parent nodes for output
+        auto lop_chain0 = parent0.stack().push(pre_op0_fn).fold();
+        parent0.node()->AddChild(this, lop_chain0, 0);
+
+        auto lop_chain1 = parent1.stack().push(pre_op1_fn).fold();
+        parent1.node()->AddChild(this, lop_chain1, 1);
+    }
+
+    void StartPreOp(size_t parent_index) final {
+        LOG << *this << " StartPreOp() parent_index=" << parent_index;
+        if (parent_index == 0)
+            writers0_ = streams_[0]->GetWriters();
+        else
+            writers1_ = streams_[1]->GetWriters();
+    }
+
+    void StopPreOp(size_t parent_index) final {
+        LOG << *this << " StopPreOp() parent_index=" << parent_index;
+        if (parent_index == 0) {
+            for (size_t i = 0; i < writers0_.size(); ++i)
+                writers0_[i].Close();
+        }
+        else {
+            for (size_t i = 0; i < writers1_.size(); ++i)
+                writers1_[i].Close();
+        }
+    }
+
+    DIAMemUse ExecuteMemUse() final {
+        return DIAMemUse::Max();
+    }
+
+    void Execute() final {
+        MainOp();
+    }
+
+    DIAMemUse PushDataMemUse() final {
+        return DIAMemUse::Max();
+    }
+
+    void PushData(bool consume) final {
+        size_t result_count = 0;
+
+        if (use_sort_merge_)
+            result_count = MergeJoin(consume);
+        else if (build_first_)
+            result_count = HashJoinBuildFirst(consume);
+        else
+            result_count = HashJoinBuildSecond(consume);
+
+        Super::logger_
+            << "class" << "JoinNode"
+            << "event" << "push"
+            << "sort_merge" << use_sort_merge_
+            << "result_count" << result_count;
+    }
+
+    void Dispose() final {
+        files0_.clear();
+        files1_.clear();
+    }
+
+private:
+    KeyExtractor1 key_extractor1_;
+    KeyExtractor2 key_extractor2_;
+    JoinFunction join_function_;
+    HashFunction hash_function_;
+
+    //! CatStreams for hash-partitioning the two inputs
+    data::CatStreamPtr streams_[2] = {
+        context_.GetNewCatStream(this), context_.GetNewCatStream(this)
+    };
+
+    //! Writers to the two inbound CatStreams
+    std::vector<data::Stream::Writer> writers0_, writers1_;
+
+    //! Received items of each input. These contain a single unsorted File
+    //! each, or sorted runs if use_sort_merge_ is set.
+    std::deque<data::File> files0_, files1_;
+
+    //! whether the first input is the build side of the hash join
+    bool build_first_ = false;
+
+    //! whether the smaller input does not fit into RAM and a sort-merge join is
+    //! performed instead
+    bool use_sort_merge_ = false;
+
+    //! Receive all items of an inbound stream into a File
+    template <typename Input>
+    data::File ReceiveFile(data::CatStreamPtr& stream) {
+        data::File file = context_.GetFile(this);
+        data::File::Writer writer = file.GetWriter();
+
+        auto reader = stream->GetCatReader(/* consume */ true);
+        while (reader.HasNext())
+            writer.Put(reader.template Next<Input>());
+
+        writer.Close();
+        stream->Close();
+        return file;
+    }
+
+    void MainOp() {
+        files0_.emplace_back(ReceiveFile<InputTypeFirst>(streams_[0]));
+        files1_.emplace_back(ReceiveFile<InputTypeSecond>(streams_[1]));
+
+        build_first_ = files0_[0].size_bytes() <= files1_[0].size_bytes();
+
+        // estimate the hash table's size as twice the serialized size of the
+        // build side.
+        size_t build_bytes = build_first_
+                             ? files0_[0].size_bytes() : files1_[0].size_bytes();
+
+        use_sort_merge_ = 2 * build_bytes > DIABase::mem_limit_;
+
+        if (use_sort_merge_) {
+            sLOG << "JoinNode: build side of" << build_bytes
+                 << "bytes exceeds mem_limit" << DIABase::mem_limit_
+                 << "-> sort-merge join";
+
+            SortRuns<InputTypeFirst>(
+                files0_, ComparatorFirst(key_extractor1_));
+            SortRuns<InputTypeSecond>(
+                files1_, ComparatorSecond(key_extractor2_));
+        }
+
+        Super::logger_
+            << "class" << "JoinNode"
+            << "event" << "done"
+            << "items0" << CountItems(files0_)
+            << "items1" << CountItems(files1_)
+            << "build_first" << build_first_
+            << "sort_merge" << use_sort_merge_;
+    }
+
+    static size_t CountItems(const std::deque<data::File>& files) {
+        size_t count = 0;
+        for (const data::File& f : files) count += f.num_items();
+        return count;
+    }
+
+    //! Replace the single unsorted File in files by sorted runs.
+    template <typename Input, typename Comparator>
+    void SortRuns(std::deque<data::File>& files, const Comparator& cmp) {
+        data::File unsorted = std::move(files.front());
+        files.clear();
+
+        // M/2 such that the other half is used to prepare the next bulk
+        size_t capacity = std::max<size_t>(
+            1, DIABase::mem_limit_ / sizeof(Input) / 2);
+        std::vector<Input> vec;
+        vec.reserve(std::min(capacity, unsorted.num_items()));
+
+        auto flush_run =
+            [&]() {
+                std::sort(vec.begin(), vec.end(), cmp);
+
+                files.emplace_back(context_.GetFile(this));
+                auto writer = files.back().GetWriter();
+                for (const Input& e : vec)
+                    writer.Put(e);
+                writer.Close();
+
+                vec.clear();
+            };
+
+        auto reader = unsorted.GetConsumeReader();
+        while (reader.HasNext()) {
+            if ((mem::memory_exceeded && !vec.empty()) ||
+                vec.size() >= capacity)
+                flush_run();
+            vec.emplace_back(reader.template Next<Input>());
+        }
+        if (vec.size())
+            flush_run();
+    }
+
+    //! Build a hash table from the first input and probe with the second.
+    size_t HashJoinBuildFirst(bool consume) {
+        std::unordered_multimap<Key, InputTypeFirst, HashFunction> table(
+            files0_[0].num_items(), hash_function_);
+
+        auto build_reader = files0_[0].GetReader(consume);
+        while (build_reader.HasNext()) {
+            InputTypeFirst item = build_reader.template Next<InputTypeFirst>();
+            table.emplace(key_extractor1_(item), std::move(item));
+        }
+
+        size_t result_count = 0;
+        auto probe_reader = files1_[0].GetReader(consume);
+        while (probe_reader.HasNext()) {
+            InputTypeSecond item = probe_reader.template Next<InputTypeSecond>();
+            auto range = table.equal_range(key_extractor2_(item));
+            for (auto it = range.first; it != range.second; ++it) {
+                this->PushItem(join_function_(it->second, item));
+                ++result_count;
+            }
+        }
+        return result_count;
+    }
+
+    //! Build a hash table from the second input and probe with the first.
+    size_t HashJoinBuildSecond(bool consume) {
+        std::unordered_multimap<Key, InputTypeSecond, HashFunction> table(
+            files1_[0].num_items(), hash_function_);
+
+        auto build_reader = files1_[0].GetReader(consume);
+        while (build_reader.HasNext()) {
+            InputTypeSecond item = build_reader.template Next<InputTypeSecond>();
+            table.emplace(key_extractor2_(item), std::move(item));
+        }
+
+        size_t result_count = 0;
+        auto probe_reader = files0_[0].GetReader(consume);
+        while (probe_reader.HasNext()) {
+            InputTypeFirst item = probe_reader.template Next<InputTypeFirst>();
+            auto range = table.equal_range(key_extractor1_(item));
+            for (auto it = range.first; it != range.second; ++it) {
+                this->PushItem(join_function_(item, it->second));
+                ++result_count;
+            }
+        }
+        return result_count;
+    }
+
+    //! calculate maximum merging degree from available memory and the number
+    //! of files of one input. additionally calculate the prefetch size of each
+    //! File. The runs of both inputs are merged at once, hence each input gets
+    //! half of the Blocks.
+    std::pair<size_t, size_t> MaxMergeDegreePrefetch(size_t num_files) {
+        size_t avail_blocks = std::max<size_t>(
+            2, DIABase::mem_limit_ / data::default_block_size / 2);
+        if (num_files >= avail_blocks) {
+            // more files than blocks available -> partial merge of avail_blocks
+            // Files with prefetch = 0, which is one read Block per File.
+            return std::make_pair(avail_blocks, 0u);
+        }
+        else {
+            // less files than available Blocks -> split blocks equally among
+            // Files.
+            return std::make_pair(
+                num_files,
+                std::min<size_t>(16u, (avail_blocks / num_files) - 1));
+        }
+    }
+
+    //! Merge batches of runs of one input until the remaining ones can be
+    //! merged at once.
+    template <typename Input, typename Comparator>
+    void PartialMerge(std::deque<data::File>& files, const Comparator& cmp) {
+        size_t merge_degree, prefetch;
+
+        while (files.size() > MaxMergeDegreePrefetch(files.size()).first)
+        {
+            std::tie(merge_degree, prefetch) =
+                MaxMergeDegreePrefetch(files.size());
+
+            sLOG << "JoinNode: partial multi-way-merge of"
+                 << merge_degree << "files with prefetch" << prefetch;
+
+            std::vector<data::File::ConsumeReader> seq;
+            seq.reserve(merge_degree);
+
+            for (size_t t = 0; t < merge_degree; ++t)
+                seq.emplace_back(files[t].GetConsumeReader(0));
+
+            StartPrefetch(seq, prefetch);
+
+            auto puller = core::make_multiway_merge_tree<Input>(
+                seq.begin(), seq.end(), cmp);
+
+            files.emplace_back(context_.GetFile(this));
+            auto writer = files.back().GetWriter();
+            while (puller.HasNext())
+                writer.Put(puller.Next());
+            writer.Close();
+
+            // release references to the merged files before erasing them.
+            seq.clear();
+            files.erase(files.begin(), files.begin() + merge_degree);
+        }
+    }
+
+    //! Merge the sorted runs of both inputs and join items with equal keys.
+    size_t MergeJoin(bool consume) {
+        if (files0_.empty() || files1_.empty()) return 0;
+
+        // bound the number of runs opened at once
+        PartialMerge<InputTypeFirst>(files0_, ComparatorFirst(key_extractor1_));
+        PartialMerge<InputTypeSecond>(files1_, ComparatorSecond(key_extractor2_));
+
+        std::vector<data::File::Reader> seq0, seq1;
+        seq0.reserve(files0_.size());
+        seq1.reserve(files1_.size());
+
+        for (size_t t = 0; t < files0_.size(); ++t)
+            seq0.emplace_back(files0_[t].GetReader(consume, 0));
+        for (size_t t = 0; t < files1_.size(); ++t)
+            seq1.emplace_back(files1_[t].GetReader(consume, 0));
+
+        StartPrefetch(seq0, MaxMergeDegreePrefetch(files0_.size()).second);
+        StartPrefetch(seq1, MaxMergeDegreePrefetch(files1_.size()).second);
+
+        auto puller0 = core::make_multiway_merge_tree<InputTypeFirst>(
+            seq0.begin(), seq0.end(), ComparatorFirst(key_extractor1_));
+        auto puller1 = core::make_multiway_merge_tree<InputTypeSecond>(
+            seq1.begin(), seq1.end(), ComparatorSecond(key_extractor2_));
+
+        bool has0 = puller0.HasNext(), has1 = puller1.HasNext();
+        if (!has0 || !has1) return 0;
+
+        InputTypeFirst item0 = puller0.Next();
+        InputTypeSecond item1 = puller1.Next();
+
+        size_t result_count = 0;
+        std::vector<InputTypeSecond> group1;
+
+        while (has0 && has1) {
+            Key key0 = key_extractor1_(item0);
+            Key key1 = key_extractor2_(item1);
+
+            if (key0 < key1) {
+                if ((has0 = puller0.HasNext())) item0 = puller0.Next();
+            }
+            else if (key1 < key0) {
+                if ((has1 = puller1.HasNext())) item1 = puller1.Next();
+            }
+            else {
+                // collect all items of the second input with equal key
+                group1.clear();
+                group1.emplace_back(std::move(item1));
+                while ((has1 = puller1.HasNext())) {
+                    item1 = puller1.Next();
+                    if (key0 < key_extractor2_(item1)) break;
+                    group1.emplace_back(std::move(item1));
+                }
+
+                // join them with all items of the first input with equal key
+                do {
+                    for (const InputTypeSecond& g : group1) {
+                        this->PushItem(join_function_(item0, g));
+                        ++result_count;
+                    }
+                    if ((has0 = puller0.HasNext())) item0 = puller0.Next();
+                } while (has0 && !(key0 < key_extractor1_(item0)));
+            }
+        }
+
+        return result_count;
+    }
+};
+
+template <typename ValueType, typename Stack>
+template <typename KeyExtractor1, typename KeyExtractor2,
+          typename JoinFunction, typename HashFunction, typename SecondDIA>
+auto DIA<ValueType, Stack>::InnerJoin(
+    const SecondDIA &second_dia,
+    const KeyExtractor1 &key_extractor1,
+    const KeyExtractor2 &key_extractor2,
+    const JoinFunction &join_function) const {
+
+    assert(IsValid());
+    assert(second_dia.IsValid());
+
+    static_assert(
+        std::is_convertible<
+            ValueType,
+            typename FunctionTraits<KeyExtractor1>::template arg<0>
+            >::value,
+        "KeyExtractor1 has the wrong input type");
+
+    static_assert(
+        std::is_convertible<
+            typename SecondDIA::ValueType,
+            typename FunctionTraits<KeyExtractor2>::template arg<0>
+            >::value,
+        "KeyExtractor2 has the wrong input type");
+
+    static_assert(
+        std::is_same<
+            typename FunctionTraits<KeyExtractor1>::result_type,
+            typename FunctionTraits<KeyExtractor2>::result_type>::value,
+        "KeyExtractor1 and KeyExtractor2 must return the same key type");
+
+    static_assert(
+        std::is_convertible<
+            typename FunctionTraits<KeyExtractor1>::template arg_plain<0>,
+            typename FunctionTraits<JoinFunction>::template arg<0>
+            >::value,
+        "JoinFunction has the wrong first input type");
+
+    static_assert(
+        std::is_convertible<
+            typename FunctionTraits<KeyExtractor2>::template arg_plain<0>,
+            typename FunctionTraits<JoinFunction>::template arg<1>
+            >::value,
+        "JoinFunction has the wrong second input type");
+
+    using JoinResult = typename FunctionTraits<JoinFunction>::result_type;
+
+    using JoinNode = api::JoinNode<
+              JoinResult, KeyExtractor1, KeyExtractor2,
+              JoinFunction, HashFunction>;
+
+    auto node = common::MakeCounting<JoinNode>(
+        *this, second_dia, key_extractor1, key_extractor2, join_function);
+
+    return DIA<JoinResult>(node);
+}
+
+} // namespace api
+} // namespace thrill
+
+#endif // !THRILL_API_INNER_JOIN_HEADER
+
+/******************************************************************************/
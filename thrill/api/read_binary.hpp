@@ -20,6 +20,7 @@
 #include <thrill/common/logger.hpp>
 #include <thrill/data/block.hpp>
 #include <thrill/data/block_reader.hpp>
+#include <thrill/io/mapped_range.hpp>
 #include <thrill/io/syscall_file.hpp>
 #include <thrill/net/buffer_builder.hpp>
 #include <thrill/vfs/file_io.hpp>
@@ -142,6 +143,24 @@ public:
                     // (these cannot be mapped using the io layer)
                     my_files_.push_back(fi);
                 }
+#if THRILL_HAVE_MMAP_FILE
+                else if (context_.mem_config().mmap_read_) {
+                    // map the range read-only into memory and let Blocks point
+                    // into the page cache directly.
+
+                    io::MappedRangePtr mapping =
+                        common::MakeCounting<io::MappedRange>(
+                            fi.path, fi.range.begin, fi.range.size());
+
+                    AppendFileBlocks(
+                        fi, [this, &mapping, &fi](size_t off, size_t bsize) {
+                            return context_.block_pool().MapMemoryBlock(
+                                mapping, off - fi.range.begin, bsize);
+                        });
+
+                    use_ext_file_ = true;
+                }
+#endif
                 else {
                     // new method: map blocks into a File using io layer
 
@@ -150,30 +169,11 @@ public:
                             fi.path,
                             io::FileBase::RDONLY | io::FileBase::NO_LOCK));
 
-                    size_t item_off = 0;
-
-                    for (size_t off = fi.range.begin; off < fi.range.end;
-                         off += data::default_block_size) {
-
-                        size_t bsize = std::min(
-                            off + data::default_block_size, fi.range.end) - off;
-
-                        data::ByteBlockPtr bbp =
-                            context_.block_pool().MapExternalBlock(
+                    AppendFileBlocks(
+                        fi, [this, &file](size_t off, size_t bsize) {
+                            return context_.block_pool().MapExternalBlock(
                                 file, off, bsize);
-
-                        size_t item_num =
-                            (bsize - item_off + fixed_size_ - 1) / fixed_size_;
-
-                        data::Block block(
-                            std::move(bbp), 0, bsize, item_off, item_num,
-                            /* typecode_verify */ false);
-
-                        item_off += item_num * fixed_size_ - bsize;
-
-                        LOG << "ReadBinary: adding Block " << block;
-                        ext_file_.AppendBlock(std::move(block));
-                    }
+                        });
 
                     use_ext_file_ = true;
                 }
@@ -252,10 +252,38 @@ public:
     }
 
 private:
+    //! Append Blocks of default_block_size covering the range of the file to
+    //! ext_file_, the ByteBlocks are created by map_block(offset, size).
+    template <typename MapBlock>
+    void AppendFileBlocks(const FileInfo& fi, const MapBlock& map_block) {
+        size_t item_off = 0;
+
+        for (size_t off = fi.range.begin; off < fi.range.end;
+             off += data::default_block_size) {
+
+            size_t bsize = std::min(
+                off + data::default_block_size, fi.range.end) - off;
+
+            data::ByteBlockPtr bbp = map_block(off, bsize);
+
+            size_t item_num =
+                (bsize - item_off + fixed_size_ - 1) / fixed_size_;
+
+            data::Block block(
+                std::move(bbp), 0, bsize, item_off, item_num,
+                /* typecode_verify */ false);
+
+            item_off += item_num * fixed_size_ - bsize;
+
+            LOG << "ReadBinary: adding Block " << block;
+            ext_file_.AppendBlock(std::move(block));
+        }
+    }
+
     //! list of files for non-mapped File push
     std::vector<FileInfo> my_files_;
 
-    //! File containing Blocks mapped directly to a io fileimpl.
+    //! File containing Blocks mapped directly to a io fileimpl or into memory.
     bool use_ext_file_ = false;
     data::File ext_file_ { context_.GetFile(this) };
 
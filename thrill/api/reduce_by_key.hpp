@@ -22,9 +22,11 @@
 #include <thrill/common/logger.hpp>
 #include <thrill/common/meta.hpp>
 #include <thrill/common/porting.hpp>
+#include <thrill/core/hot_key_sketch.hpp>
 #include <thrill/core/reduce_by_hash_post_phase.hpp>
 #include <thrill/core/reduce_pre_phase.hpp>
 
+#include <algorithm>
 #include <functional>
 #include <thread>
 #include <type_traits>
@@ -75,8 +77,20 @@ class ReduceNode final : public DOpNode<ValueType>
 
     using HashIndexFunction = core::ReduceByHash<Key, KeyHashFunction>;
 
+    using CombineIndexFunction =
+              core::ReduceByHashStrided<Key, KeyHashFunction>;
+
+    using MakeTableItem =
+              core::ReduceMakeTableItem<ValueType, TableItem, VolatileKey>;
+
     static constexpr bool use_mix_stream_ = ReduceConfig::use_mix_stream_;
     static constexpr bool use_post_thread_ = ReduceConfig::use_post_thread_;
+    static constexpr bool use_host_combine_ = ReduceConfig::use_host_combine_;
+    static constexpr bool use_skew_split_ = ReduceConfig::use_skew_split_;
+
+    static_assert(!(use_host_combine_ && use_skew_split_),
+                  "ReduceConfig: host combining and skew splitting "
+                  "cannot be used together");
 
 private:
     //! Emitter for PostPhase to push elements to next DIA object.
@@ -85,7 +99,7 @@ private:
     public:
         explicit Emitter(ReduceNode* node) : node_(node) { }
         void operator () (const ValueType& item) const
-        { return node_->PushItem(item); }
+        { return node_->EmitItem(item); }
 
     private:
         ReduceNode* node_;
@@ -105,16 +119,47 @@ public:
                const KeyHashFunction& key_hash_function,
                const KeyEqualFunction& key_equal_function)
         : Super(parent.ctx(), label, { parent.id() }, { parent.node() }),
+          host_combine_(use_host_combine_ &&
+                        parent.ctx().workers_per_host() > 1),
+          skew_split_(use_skew_split_ && parent.ctx().num_workers() > 1),
           mix_stream_(use_mix_stream_ ?
                       parent.ctx().GetNewMixStream(this) : nullptr),
           cat_stream_(use_mix_stream_ ?
                       nullptr : parent.ctx().GetNewCatStream(this)),
-          emitters_(use_mix_stream_ ?
-                    mix_stream_->GetWriters() : cat_stream_->GetWriters()),
+          emitters_(
+              SelectWriters(
+                  use_mix_stream_ ?
+                  mix_stream_->GetWriters() : cat_stream_->GetWriters())),
+          combine_stream_(host_combine_ ?
+                          parent.ctx().GetNewCatStream(this) : nullptr),
+          combine_emitters_(
+              host_combine_ ?
+              SelectCombineWriters(combine_stream_->GetWriters()) :
+              std::vector<data::Stream::Writer>()),
+          hot_stream_(skew_split_ ?
+                      parent.ctx().GetNewCatStream(this) : nullptr),
+          key_extractor_(key_extractor),
+          reduce_function_(reduce_function),
+          key_hash_function_(key_hash_function),
+          key_equal_function_(key_equal_function),
+          // without skew splitting the sketch is unused, keep it tiny
+          sketch_(skew_split_ ?
+                  config.skew_hot_fraction() / parent.ctx().num_workers() : 1.0,
+                  ReduceConfig::skew_min_items_,
+                  ReduceConfig::skew_sketch_error_),
           pre_phase_(
-              context_, Super::id(), parent.ctx().num_workers(),
-              key_extractor, reduce_function, emitters_, config,
+              context_, Super::id(),
+              host_combine_ ? combine_emitters_.size() : emitters_.size(),
+              key_extractor, reduce_function,
+              host_combine_ ? combine_emitters_ : emitters_, config,
               HashIndexFunction(key_hash_function), key_equal_function),
+          combine_phase_(
+              context_, Super::id(), emitters_.size(),
+              key_extractor, reduce_function, emitters_, config,
+              CombineIndexFunction(
+                  HashIndexFunction(key_hash_function),
+                  parent.ctx().workers_per_host()),
+              key_equal_function),
           post_phase_(
               context_, Super::id(), key_extractor, reduce_function,
               Emitter(this), config,
@@ -124,8 +169,18 @@ public:
         // reduce each bucket to a single value, afterwards send data to another
         // worker given by the shuffle algorithm.
         auto pre_op_fn = [this](const ValueType& input) {
+                             if (use_skew_split_ && skew_split_) {
+                                 sketch_.Insert(
+                                     key_hash_function_(key_extractor_(input)));
+                             }
                              return pre_phase_.Insert(input);
                          };
+        if (skew_split_) {
+            pre_phase_.set_router(
+                [this](const size_t& partition_id, const TableItem& p) {
+                    return RouteItem(partition_id, p);
+                });
+        }
         // close the function stack with our pre op and register it at
         // parent node for output
         auto lop_chain = parent.stack().push(pre_op_fn).fold();
@@ -158,6 +213,19 @@ public:
         // Flush hash table before the postOp
         pre_phase_.FlushAll();
         pre_phase_.CloseAll();
+
+        if (host_combine_) CombineHost();
+        if (use_skew_split_ && skew_split_) AgreeHotKeys();
+
+        if (pre_phase_.bypass()) {
+            // report the switch point and the items which skipped the table
+            Super::logger_
+                << "class" << "ReduceNode"
+                << "event" << "pre_phase_bypass"
+                << "switch_items" << pre_phase_.num_inserted()
+                << "bypassed_items" << pre_phase_.num_bypassed()
+                << "bypassed_bytes" << pre_phase_.bypassed_bytes();
+        }
         // waiting for the additional thread to finish the reduce
         if (use_post_thread_) thread_.join();
         use_mix_stream_ ? mix_stream_->Close() : cat_stream_->Close();
@@ -179,6 +247,8 @@ public:
             reduced_ = true;
         }
         post_phase_.PushData(consume);
+
+        if (use_skew_split_ && skew_split_) PushHotKeys(consume);
     }
 
     //! process the inbound data in the post reduce phase
@@ -205,16 +275,59 @@ public:
 
     void Dispose() final {
         post_phase_.Dispose();
+        std::vector<ValueType>().swap(hot_results_);
     }
 
 private:
+    //! whether the pre phase sends items to the local worker combining them
+    //! for the host, which then sends them to the post phase.
+    const bool host_combine_;
+
+    //! whether hot keys are spread over all workers, see use_skew_split_.
+    const bool skew_split_;
+
     // pointers for both Mix and CatStream. only one is used, the other costs
     // only a null pointer.
     data::MixStreamPtr mix_stream_;
     data::CatStreamPtr cat_stream_;
 
+    //! writers to the post phase: to all workers, or with host combining to the
+    //! workers with the same local id on all hosts.
     std::vector<data::Stream::Writer> emitters_;
 
+    //! stream to the combining workers on this host, only for host combining.
+    data::CatStreamPtr combine_stream_;
+
+    //! writers to the combining workers on this host.
+    std::vector<data::Stream::Writer> combine_emitters_;
+
+    //! stream of the partial results of hot keys to the workers owning the
+    //! keys, only for skew splitting.
+    data::CatStreamPtr hot_stream_;
+
+    //! writers of the partial results of hot keys to their owners, opened
+    //! when the first one is sent.
+    std::vector<data::Stream::Writer> hot_emitters_;
+
+    //! copies of the UDFs for the final combine of hot keys
+    KeyExtractor key_extractor_;
+    ReduceFunction reduce_function_;
+    KeyHashFunction key_hash_function_;
+    KeyEqualFunction key_equal_function_;
+
+    //! sketch detecting hot keys in the pre phase, after StopPreOp() it holds
+    //! the hot keys of all workers.
+    core::HotKeySketch sketch_;
+
+    //! round-robin counter spreading the items of hot keys
+    size_t hot_round_ = 0;
+
+    //! whether the partial results of hot keys were combined
+    bool hot_combined_ = false;
+
+    //! final values of the hot keys owned by this worker
+    std::vector<ValueType> hot_results_;
+
     //! handle to additional thread for post phase
     std::thread thread_;
 
@@ -222,12 +335,189 @@ private:
         TableItem, Key, ValueType, KeyExtractor, ReduceFunction, VolatileKey,
         ReduceConfig, HashIndexFunction, KeyEqualFunction> pre_phase_;
 
+    //! second pre phase combining the items of all local workers, only
+    //! initialized for host combining.
+    core::ReducePrePhase<
+        TableItem, Key, ValueType, KeyExtractor, ReduceFunction, VolatileKey,
+        ReduceConfig, CombineIndexFunction, KeyEqualFunction> combine_phase_;
+
     core::ReduceByHashPostPhase<
         TableItem, Key, ValueType, KeyExtractor, ReduceFunction, Emitter,
         VolatileKey, ReduceConfig,
         HashIndexFunction, KeyEqualFunction> post_phase_;
 
     bool reduced_ = false;
+
+    //! Keep the writers to the targets of this worker's items and close all
+    //! others. Without host combining, these are all workers. With it, the
+    //! item with ReduceByHash partition p is sent by the combining worker
+    //! with local id p % workers_per_host to worker p, hence the targets are
+    //! the workers with the same local id on all hosts.
+    std::vector<data::Stream::Writer> SelectWriters(
+        std::vector<data::Stream::Writer>&& writers) {
+        if (!host_combine_) return std::move(writers);
+
+        std::vector<data::Stream::Writer> selected;
+        for (size_t w = 0; w < writers.size(); ++w) {
+            if (w % context_.workers_per_host() == context_.local_worker_id())
+                selected.emplace_back(std::move(writers[w]));
+            else
+                writers[w].Close();
+        }
+        return selected;
+    }
+
+    //! Keep the writers to the workers on this host and close all others. The
+    //! pre phase partitions items among them by ReduceByHash partition modulo
+    //! workers_per_host.
+    std::vector<data::Stream::Writer> SelectCombineWriters(
+        std::vector<data::Stream::Writer>&& writers) {
+        size_t begin = context_.host_rank() * context_.workers_per_host();
+        size_t end = begin + context_.workers_per_host();
+
+        std::vector<data::Stream::Writer> selected;
+        for (size_t w = 0; w < writers.size(); ++w) {
+            if (w >= begin && w < end)
+                selected.emplace_back(std::move(writers[w]));
+            else
+                writers[w].Close();
+        }
+        return selected;
+    }
+
+    //! Combine the items sent by the pre phases of all local workers in a
+    //! second pre phase, which sends each key once per host to the post phase.
+    void CombineHost() {
+        // the table of the first pre phase was released, reuse its memory.
+        if (!use_post_thread_)
+            combine_phase_.Initialize(DIABase::mem_limit_);
+        else
+            combine_phase_.Initialize(DIABase::mem_limit_ / 2);
+
+        size_t num_received = 0;
+        auto reader = combine_stream_->GetCatReader(/* consume */ true);
+        while (reader.HasNext()) {
+            combine_phase_.InsertItem(reader.template Next<TableItem>());
+            ++num_received;
+        }
+        combine_stream_->Close();
+
+        combine_phase_.FlushAll();
+        combine_phase_.CloseAll();
+
+        Super::logger_
+            << "class" << "ReduceNode"
+            << "event" << "host_combine"
+            << "received_items" << num_received
+            << "sent_items" << combine_phase_.num_emitted();
+    }
+
+    //! \name Skew Splitting
+    //! \{
+
+    //! Send items of hot keys round-robin to all workers, others to the worker
+    //! owning the key.
+    size_t RouteItem(const size_t& partition_id, const TableItem& p) {
+        if (sketch_.hot().empty() ||
+            !sketch_.IsHot(key_hash_function_(
+                               MakeTableItem::GetKey(p, key_extractor_))))
+            return partition_id;
+        return (partition_id + ++hot_round_) % emitters_.size();
+    }
+
+    //! Agree on the union of the hot keys of all workers, whose partial
+    //! results are combined after the post phase.
+    void AgreeHotKeys() {
+        size_t local_hot = sketch_.hot().size();
+        sketch_.set_hot(
+            context_.net.AllReduce(sketch_.hot(), core::HotKeySketch::Union));
+
+        Super::logger_
+            << "class" << "ReduceNode"
+            << "event" << "skew_split"
+            << "local_hot_keys" << local_hot
+            << "hot_keys" << sketch_.hot().size();
+    }
+
+    //! Push an item of the post phase to the next DIA, or send it to the worker
+    //! owning the key if it is the partial result of a hot key.
+    void EmitItem(const ValueType& item) {
+        if (use_skew_split_ && skew_split_ && !sketch_.hot().empty()) {
+            Key key = key_extractor_(item);
+            if (sketch_.IsHot(key_hash_function_(key))) {
+                // the partial results are sent only once, later PushData()
+                // calls push the combined hot_results_.
+                if (!hot_combined_) {
+                    if (hot_emitters_.empty())
+                        hot_emitters_ = hot_stream_->GetWriters();
+                    hot_emitters_[Owner(key)].Put(item);
+                }
+                return;
+            }
+        }
+        this->PushItem(item);
+    }
+
+    //! Combine the partial results of the hot keys owned by this worker once,
+    //! and push the final values.
+    void PushHotKeys(bool consume) {
+        if (!hot_combined_) {
+            if (hot_emitters_.empty())
+                hot_emitters_ = hot_stream_->GetWriters();
+            for (data::Stream::Writer& w : hot_emitters_) w.Close();
+
+            // order the partial results by key hash, then combine those with
+            // equal keys in each run of equal hashes.
+            std::vector<std::pair<uint64_t, ValueType> > partials;
+            auto reader = hot_stream_->GetCatReader(/* consume */ true);
+            while (reader.HasNext()) {
+                ValueType item = reader.template Next<ValueType>();
+                uint64_t hash = key_hash_function_(key_extractor_(item));
+                partials.emplace_back(hash, std::move(item));
+            }
+            hot_stream_->Close();
+            std::vector<data::Stream::Writer>().swap(hot_emitters_);
+
+            std::sort(partials.begin(), partials.end(),
+                      [](const std::pair<uint64_t, ValueType>& a,
+                         const std::pair<uint64_t, ValueType>& b) {
+                          return a.first < b.first;
+                      });
+
+            for (size_t i = 0; i < partials.size(); ) {
+                size_t run_begin = hot_results_.size();
+                uint64_t hash = partials[i].first;
+                for ( ; i < partials.size() && partials[i].first == hash; ++i) {
+                    ValueType& item = partials[i].second;
+                    size_t r = run_begin;
+                    while (r < hot_results_.size() &&
+                           !key_equal_function_(
+                               key_extractor_(hot_results_[r]),
+                               key_extractor_(item))) ++r;
+                    if (r == hot_results_.size())
+                        hot_results_.emplace_back(std::move(item));
+                    else
+                        hot_results_[r] =
+                            reduce_function_(hot_results_[r], item);
+                }
+            }
+            hot_combined_ = true;
+        }
+
+        for (const ValueType& item : hot_results_)
+            this->PushItem(item);
+
+        if (consume)
+            std::vector<ValueType>().swap(hot_results_);
+    }
+
+    //! worker owning a key without skew splitting
+    size_t Owner(const Key& key) const {
+        return HashIndexFunction(key_hash_function_)(
+            key, context_.num_workers(), 0, 0).partition_id;
+    }
+
+    //! \}
 };
 
 template <typename ValueType, typename Stack>
@@ -169,6 +169,16 @@ public:
         // Flush hash table before the postOp
         pre_phase_.FlushAll();
         pre_phase_.CloseAll();
+
+        if (pre_phase_.bypass()) {
+            // report the switch point and the items which skipped the table
+            Super::logger_
+                << "class" << "ReduceToIndexNode"
+                << "event" << "pre_phase_bypass"
+                << "switch_items" << pre_phase_.num_inserted()
+                << "bypassed_items" << pre_phase_.num_bypassed()
+                << "bypassed_bytes" << pre_phase_.bypassed_bytes();
+        }
         // waiting for the additional thread to finish the reduce
         if (use_post_thread_) thread_.join();
         use_mix_stream_ ? mix_stream_->Close() : cat_stream_->Close();
@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * thrill/api/semi_join_filter.hpp
+ *
+ * Semi-join pushdown: builds a distributed Bloom filter of the keys of a small
+ * DIA, which is applied as a LOp filter to a large DIA.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_API_SEMI_JOIN_FILTER_HEADER
+#define THRILL_API_SEMI_JOIN_FILTER_HEADER
+
+#include <thrill/api/action_node.hpp>
+#include <thrill/api/dia.hpp>
+#include <thrill/common/logger.hpp>
+#include <thrill/core/bloom_filter.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace thrill {
+namespace api {
+
+/*!
+ * An ActionNode which builds a Bloom filter of the keys of all items of a DIA.
+ * Each worker collects the hashes of its local keys, then all workers agree on
+ * the filter size, insert their hashes into equal filters, and merge the bit
+ * arrays with an AllReduce. Hence, all workers end up with the same filter.
+ *
+ * \ingroup api_layer
+ */
+template <typename KeyExtractor, typename HashFunction>
+class BloomFilterNode final
+    : public ActionResultNode<std::shared_ptr<const core::BloomFilter> >
+{
+    static constexpr bool debug = false;
+
+    using ValueType =
+              typename common::FunctionTraits<KeyExtractor>::template arg_plain<0>;
+
+public:
+    using Super = ActionResultNode<std::shared_ptr<const core::BloomFilter> >;
+    using Super::context_;
+
+    template <typename ParentDIA>
+    BloomFilterNode(const ParentDIA& parent,
+                    const KeyExtractor& key_extractor,
+                    const HashFunction& hash_function,
+                    size_t bits_per_key)
+        : Super(parent.ctx(), "BloomFilter",
+                { parent.id() }, { parent.node() }),
+          key_extractor_(key_extractor),
+          hash_function_(hash_function),
+          bits_per_key_(bits_per_key)
+    {
+        auto pre_op_function = [this](const ValueType& input) {
+                                   hashes_.push_back(
+                                       hash_function_(key_extractor_(input)));
+                               };
+
+        // close the function stack with our pre op and register it at parent
+        // node for output
+        auto lop_chain = parent.stack().push(pre_op_function).fold();
+        parent.node()->AddChild(this, lop_chain);
+    }
+
+    //! Builds the local filter and merges the filters of all workers.
+    void Execute() final {
+        // all workers must construct filters of equal size.
+        size_t num_keys = context_.net.AllReduce(hashes_.size());
+
+        core::BloomFilter filter(num_keys, bits_per_key_);
+        for (const uint64_t& hash : hashes_)
+            filter.Insert(hash);
+        std::vector<uint64_t>().swap(hashes_);
+
+        filter.set_words(
+            context_.net.AllReduce(filter.words(), core::BloomFilter::Union));
+
+        Super::logger_
+            << "class" << "BloomFilterNode"
+            << "event" << "done"
+            << "keys" << num_keys
+            << "bits" << filter.num_bits();
+
+        LOG << "BloomFilterNode: worker " << context_.my_rank()
+            << " got filter with " << filter.num_bits() << " bits for "
+            << num_keys << " keys";
+
+        filter_ = std::make_shared<const core::BloomFilter>(std::move(filter));
+    }
+
+    const std::shared_ptr<const core::BloomFilter>& result() const final {
+        return filter_;
+    }
+
+private:
+    //! key extractor of the small DIA
+    KeyExtractor key_extractor_;
+
+    //! hash function of the keys
+    HashFunction hash_function_;
+
+    //! bits of the filter per key
+    size_t bits_per_key_;
+
+    //! hashes of the local keys
+    std::vector<uint64_t> hashes_;
+
+    //! the global filter
+    std::shared_ptr<const core::BloomFilter> filter_;
+};
+
+template <typename ValueType, typename Stack>
+template <typename KeyExtractor1, typename KeyExtractor2,
+          typename HashFunction, typename SecondDIA>
+auto DIA<ValueType, Stack>::SemiJoinFilter(
+    const SecondDIA &second_dia,
+    const KeyExtractor1 &key_extractor1,
+    const KeyExtractor2 &key_extractor2,
+    size_t bits_per_key,
+    const HashFunction &hash_function) const {
+
+    assert(IsValid());
+    assert(second_dia.IsValid());
+
+    static_assert(
+        std::is_convertible<
+            ValueType,
+            typename FunctionTraits<KeyExtractor1>::template arg<0>
+            >::value,
+        "KeyExtractor1 has the wrong input type");
+
+    static_assert(
+        std::is_convertible<
+            typename SecondDIA::ValueType,
+            typename FunctionTraits<KeyExtractor2>::template arg<0>
+            >::value,
+        "KeyExtractor2 has the wrong input type");
+
+    static_assert(
+        std::is_same<
+            typename FunctionTraits<KeyExtractor1>::result_type,
+            typename FunctionTraits<KeyExtractor2>::result_type>::value,
+        "KeyExtractor1 and KeyExtractor2 must return the same key type");
+
+    using BloomFilterNode =
+              api::BloomFilterNode<KeyExtractor2, HashFunction>;
+
+    // build the global Bloom filter of the second DIA's keys immediately
+    auto node = common::MakeCounting<BloomFilterNode>(
+        second_dia, key_extractor2, hash_function, bits_per_key);
+
+    node->RunScope();
+
+    std::shared_ptr<const core::BloomFilter> filter = node->result();
+
+    // test the items of this DIA in its LOp function stack
+    return Filter(
+        [filter, key_extractor1, hash_function](const ValueType& input) {
+            return filter->Contains(hash_function(key_extractor1(input)));
+        });
+}
+
+} // namespace api
+} // namespace thrill
+
+#endif // !THRILL_API_SEMI_JOIN_FILTER_HEADER
+
+/******************************************************************************/
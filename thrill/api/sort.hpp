@@ -21,22 +21,89 @@
 #include <thrill/common/math.hpp>
 #include <thrill/common/porting.hpp>
 #include <thrill/common/qsort.hpp>
+#include <thrill/common/radix_sort.hpp>
+#include <thrill/common/thread_pool.hpp>
 #include <thrill/core/multiway_merge.hpp>
+#include <thrill/core/parallel_multiway_merge.hpp>
 #include <thrill/data/file.hpp>
 #include <thrill/net/group.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <deque>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <numeric>
 #include <random>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace thrill {
 namespace api {
 
+/*!
+ * Whether a SortAlgorithm allocates a temporary buffer as large as the sorted
+ * range for items of ValueType compared with CompareFunction. This is declared
+ * by a member template UsesBuffer<ValueType, CompareFunction> of the
+ * algorithm, algorithms without it are assumed to sort in-place.
+ */
+template <typename SortAlgorithm, typename ValueType, typename CompareFunction>
+class SortAlgorithmUsesBuffer
+{
+    template <typename Algorithm>
+    static constexpr bool Test(
+        typename Algorithm::template UsesBuffer<
+            ValueType, CompareFunction>* /* tag */) {
+        return Algorithm::template UsesBuffer<
+            ValueType, CompareFunction>::value;
+    }
+
+    template <typename Algorithm>
+    static constexpr bool Test(...) { return false; }
+
+public:
+    static constexpr bool value = Test<SortAlgorithm>(nullptr);
+};
+
+/*!
+ * Tell a SortAlgorithm how many workers share the cores of the host, if it has
+ * a method set_workers_per_host(), e.g. to divide the cores among them.
+ */
+template <typename SortAlgorithm>
+auto SortAlgorithmSetWorkersPerHost(
+    SortAlgorithm& sort_algorithm, size_t workers_per_host, int)
+->decltype(sort_algorithm.set_workers_per_host(workers_per_host), void()) {
+    sort_algorithm.set_workers_per_host(workers_per_host);
+}
+
+//! fallback: the SortAlgorithm does not care.
+template <typename SortAlgorithm>
+void SortAlgorithmSetWorkersPerHost(SortAlgorithm&, size_t, long) { }
+
+/*!
+ * Whether a SortAlgorithm in its current configuration allocates a temporary
+ * buffer as large as the sorted range, if it has a method
+ * uses_buffer<ValueType, CompareFunction>(), e.g. depending on its number of
+ * threads.
+ */
+template <typename ValueType, typename CompareFunction, typename SortAlgorithm>
+auto SortAlgorithmBufferNeeded(const SortAlgorithm& sort_algorithm, int)
+->decltype(sort_algorithm.template uses_buffer<ValueType, CompareFunction>()) {
+    return sort_algorithm.template uses_buffer<ValueType, CompareFunction>();
+}
+
+//! fallback: the static SortAlgorithmUsesBuffer decides.
+template <typename ValueType, typename CompareFunction, typename SortAlgorithm>
+bool SortAlgorithmBufferNeeded(const SortAlgorithm&, long) {
+    return SortAlgorithmUsesBuffer<
+        SortAlgorithm, ValueType, CompareFunction>::value;
+}
+
 /*!
  * A DIANode which performs a Sort operation. Sort sorts a DIA according to a
  * given compare function
@@ -68,6 +135,12 @@ class SortNode final : public DOpNode<ValueType>
 
     using SampleIndexPair = std::pair<ValueType, size_t>;
 
+    //! sample sent to worker 0 with the number of local items it represents
+    using WeightedSample = std::pair<SampleIndexPair, double>;
+
+    //! estimated imbalance of the partition and its relative error
+    using ImbalanceEstimate = std::pair<double, double>;
+
     static const bool use_background_thread_ = false;
 
 public:
@@ -77,12 +150,17 @@ public:
     template <typename ParentDIA>
     SortNode(const ParentDIA& parent,
              const CompareFunction& compare_function,
-             const SortAlgorithm& sort_algorithm = SortAlgorithm())
+             const SortAlgorithm& sort_algorithm = SortAlgorithm(),
+             bool skew_aware = false)
         : Super(parent.ctx(), "Sort", { parent.id() }, { parent.node() }),
           compare_function_(compare_function),
           sort_algorithm_(sort_algorithm),
-          parent_stack_empty_(ParentDIA::stack_empty)
+          parent_stack_empty_(ParentDIA::stack_empty),
+          skew_aware_(skew_aware)
     {
+        SortAlgorithmSetWorkersPerHost(
+            sort_algorithm_, context_.workers_per_host(), 0);
+
         // Hook PreOp(s)
         auto pre_op_fn = [this](const ValueType& input) {
                              PreOp(input);
@@ -209,6 +287,11 @@ public:
             local_size = files_[0].num_items();
             this->PushFile(files_[0], consume);
         }
+        else if (MergeParallel()) {
+            // all runs were merged into a single File
+            local_size = files_[0].num_items();
+            this->PushFile(files_[0], consume);
+        }
         else {
             size_t merge_degree, prefetch;
 
@@ -285,6 +368,38 @@ public:
         files_.clear();
     }
 
+    /*!
+     * Merge all files_ concurrently in disjoint key ranges if more than one
+     * thread per worker is available and the runs fit into the memory limit,
+     * since the merged File is materialized. Afterwards files_ contains a
+     * single sorted File. Returns false if the files were not merged.
+     */
+    bool MergeParallel() {
+        const size_t num_threads = std::max<size_t>(
+            1, std::thread::hardware_concurrency() / context_.workers_per_host());
+        size_t total_bytes = 0;
+        for (const data::File& file : files_)
+            total_bytes += file.size_bytes();
+        const size_t num_parts = core::parallel_merge_degree(
+            num_threads, files_.size(), total_bytes,
+            DIABase::mem_limit_, parallel_prefetch_);
+
+        if (num_parts <= 1) return false;
+
+        sLOG1 << "Start parallel multi-way-merge of" << files_.size()
+              << "files into" << num_parts << "parts";
+
+        data::File merged = core::parallel_multiway_merge<ValueType>(
+            files_.begin(), files_.end(), num_parts, parallel_prefetch_,
+            compare_function_,
+            [this]() { return context_.GetFile(this); });
+
+        files_.clear();
+        files_.emplace_back(std::move(merged));
+
+        return true;
+    }
+
 private:
     //! The comparison function which is applied to two elements.
     CompareFunction compare_function_;
@@ -295,6 +410,9 @@ private:
     //! Whether the parent stack is empty
     const bool parent_stack_empty_;
 
+    //! Whether to check the partition sizes and re-sample on overload
+    const bool skew_aware_;
+
     //! \name PreOp Phase
     //! \{
 
@@ -315,6 +433,12 @@ private:
     //! epsilon
     static constexpr double desired_imbalance_ = 0.1;
 
+    //! maximum number of re-sampling rounds in skew-aware mode
+    static constexpr size_t max_resample_rounds_ = 3;
+
+    //! factor by which the sample is enlarged in each re-sampling round
+    static constexpr size_t resample_factor_ = 2;
+
     //! calculate currently desired number of samples
     size_t wanted_sample_size() const {
         size_t s = static_cast<size_t>(
@@ -323,6 +447,15 @@ private:
         return std::max(s, size_t(1));
     }
 
+    //! maximum number of local samples when re-sampling, such that the samples
+    //! of all workers fit into a fraction of worker 0's memory.
+    size_t max_sample_size() const {
+        return std::max(
+            wanted_sample_size(),
+            DIABase::mem_limit_ / 16
+            / (context_.num_workers() * sizeof(WeightedSample)));
+    }
+
     //! \}
 
     //! \name MainOp and PushData
@@ -330,6 +463,8 @@ private:
 
     //! Local data files
     std::deque<data::File> files_;
+    //! prefetch degree of each File in MergeParallel()
+    static constexpr size_t parallel_prefetch_ = 1;
     //! Total number of local elements after communication
     size_t local_out_size_ = 0;
 
@@ -352,33 +487,46 @@ private:
     void FindAndSendSplitters(
         std::vector<SampleIndexPair>& splitters, size_t sample_size,
         data::MixStreamPtr& sample_stream,
-        std::vector<data::MixStream::Writer>& sample_writers) {
+        std::vector<data::MixStream::Writer>& sample_writers,
+        ImbalanceEstimate& estimate) {
 
         // Get samples from other workers
         size_t num_total_workers = context_.num_workers();
 
-        std::vector<SampleIndexPair> samples;
+        std::vector<WeightedSample> samples;
         samples.reserve(sample_size * num_total_workers);
 
         auto reader = sample_stream->GetMixReader(/* consume */ true);
 
         while (reader.HasNext()) {
-            samples.push_back(reader.template Next<SampleIndexPair>());
+            samples.push_back(reader.template Next<WeightedSample>());
         }
         if (samples.size() == 0) return;
 
         // Find splitters
         std::sort(samples.begin(), samples.end(),
                   [this](
-                      const SampleIndexPair& a, const SampleIndexPair& b) {
-                      return LessSampleIndex(a, b);
+                      const WeightedSample& a, const WeightedSample& b) {
+                      return LessSampleIndex(a.first, b.first);
                   });
 
-        size_t splitting_size = samples.size() / num_total_workers;
+        // sample positions of the splitters
+        std::vector<size_t> splitter_pos;
+        splitter_pos.reserve(num_total_workers - 1);
+
+        if (!skew_aware_) {
+            size_t splitting_size = samples.size() / num_total_workers;
+
+            for (size_t i = 1; i < num_total_workers; ++i)
+                splitter_pos.push_back(i * splitting_size);
+        }
+        else {
+            splitter_pos = WeightedSplitters(samples, estimate);
+        }
 
         // Send splitters to other workers
-        for (size_t i = 1; i < num_total_workers; ++i) {
-            splitters.push_back(samples[i * splitting_size]);
+        for (const size_t& pos : splitter_pos) {
+            splitters.push_back(samples[pos].first);
             for (size_t j = 1; j < num_total_workers; j++) {
                 sample_writers[j].Put(splitters.back());
             }
@@ -388,6 +536,67 @@ private:
             sample_writers[j].Close();
     }
 
+    /*!
+     * Select the splitters at the quantiles of the sorted samples weighted by
+     * the number of items each sample represents, and estimate the resulting
+     * partition sizes from the samples between the splitters. Returns the
+     * splitters' sample positions. The estimate's error is the sampling error
+     * of the smallest bucket plus the largest weight of a single sample.
+     */
+    std::vector<size_t> WeightedSplitters(
+        const std::vector<WeightedSample>& samples,
+        ImbalanceEstimate& estimate) {
+
+        size_t num_total_workers = context_.num_workers();
+
+        double total_weight = 0, max_weight = 0;
+        for (const WeightedSample& s : samples) {
+            total_weight += s.second;
+            max_weight = std::max(max_weight, s.second);
+        }
+        const double bucket_weight =
+            total_weight / static_cast<double>(num_total_workers);
+
+        std::vector<size_t> splitter_pos;
+        splitter_pos.reserve(num_total_workers - 1);
+
+        // advance to the sample at which the cumulative weight reaches each
+        // quantile, positions of equal splitters may repeat.
+        double sum = 0;
+        size_t j = 0;
+        for (size_t i = 1; i < num_total_workers; ++i) {
+            double target = bucket_weight * static_cast<double>(i);
+            while (j + 1 < samples.size() && sum + samples[j].second < target)
+                sum += samples[j++].second;
+            splitter_pos.push_back(j);
+        }
+
+        // bucket i contains the samples after splitter i - 1 up to splitter i,
+        // since items equal to a splitter are put into the lower bucket.
+        double max_bucket = 0;
+        size_t min_count = samples.size(), begin = 0;
+        for (size_t i = 0; i < num_total_workers; ++i) {
+            size_t end = i + 1 < num_total_workers
+                         ? std::max(begin, splitter_pos[i] + 1) : samples.size();
+            double bucket = 0;
+            for (size_t k = begin; k < end; ++k)
+                bucket += samples[k].second;
+            max_bucket = std::max(max_bucket, bucket);
+            min_count = std::min(min_count, end - begin);
+            begin = end;
+        }
+
+        estimate.first = max_bucket / bucket_weight;
+        estimate.second =
+            1.0 / std::sqrt(static_cast<double>(std::max<size_t>(min_count, 1)))
+            + max_weight / bucket_weight;
+
+        LOG << "WeightedSplitters() estimated imbalance " << estimate.first
+            << " error " << estimate.second;
+
+        return splitter_pos;
+    }
+
     class TreeBuilder
     {
     public:
@@ -436,11 +645,8 @@ private:
         return !compare_function_(a.first, b.first) && a.second >= b.second;
     }
 
-    //! round n down by k where k is a power of two.
-    template <typename Integral>
-    static inline size_t RoundDown(Integral n, Integral k) {
-        return (n & ~(k - 1));
-    }
+    //! number of items classified together in TransmitItems()
+    static constexpr size_t classify_batch_size_ = 16;
 
     void TransmitItems(
         // Tree of splitters, sizeof |splitter|
@@ -471,75 +677,54 @@ private:
 
         std::swap(data_writers[actual_k - 1], data_writers[k - 1]);
 
-        // classify all items (take two at once) and immediately transmit them.
+        // classify items in batches: first run all items of a batch down the
+        // splitter tree level by level, such that the independent comparisons
+        // of the batch are overlapped by the CPU, then fix up buckets of items
+        // equal to splitters and transmit the batch in a second pass.
+
+        std::vector<ValueType> batch;
+        batch.reserve(classify_batch_size_);
+
+        // bucket oracle: tree index of each item in the batch
+        uint32_t oracle[classify_batch_size_];
 
-        const size_t stepsize = 2;
+        const size_t end_items = prefix_items + local_items_;
 
-        size_t i = prefix_items;
-        for ( ; i < prefix_items + RoundDown(local_items_, stepsize); i += stepsize)
+        for (size_t i = prefix_items; i < end_items; )
         {
-            // take two items
-            size_t j0 = 1;
-            ValueType el0 = unsorted_reader.Next<ValueType>();
+            const size_t n = std::min<size_t>(
+                size_t(classify_batch_size_), end_items - i);
 
-            size_t j1 = 1;
-            ValueType el1 = unsorted_reader.Next<ValueType>();
+            batch.clear();
+            for (size_t b = 0; b < n; ++b) {
+                batch.emplace_back(unsorted_reader.Next<ValueType>());
+                oracle[b] = 1;
+            }
 
             // run items down the tree
             for (size_t l = 0; l < log_k; l++)
             {
-                j0 = 2 * j0 + (compare_function_(el0, tree[j0]) ? 0 : 1);
-                j1 = 2 * j1 + (compare_function_(el1, tree[j1]) ? 0 : 1);
-            }
-
-            size_t b0 = j0 - k;
-            size_t b1 = j1 - k;
-
-            while (b0 && EqualSampleGreaterIndex(
-                       sorted_splitters[b0 - 1], SampleIndexPair(el0, i + 0))) {
-                b0--;
-
-                // LOG0 << "el0 equal match b0 " << b0
-                //      << " prefix_items " << prefix_items
-                //      << " lhs.first = " << sorted_splitters[b0 - 1].first
-                //      << " lhs.second = " << sorted_splitters[b0 - 1].second
-                //      << " rhs.first = " << el0
-                //      << " rhs.second = " << i;
-            }
-
-            while (b1 && EqualSampleGreaterIndex(
-                       sorted_splitters[b1 - 1], SampleIndexPair(el1, i + 1))) {
-                b1--;
+                for (size_t b = 0; b < n; ++b) {
+                    oracle[b] = 2 * oracle[b] + (
+                        compare_function_(batch[b], tree[oracle[b]]) ? 0 : 1);
+                }
             }
 
-            assert(data_writers[b0].IsValid());
-            assert(data_writers[b1].IsValid());
-
-            data_writers[b0].Put(el0);
-            data_writers[b1].Put(el1);
-        }
-
-        // last iteration of loop if we have an odd number of items.
-        for ( ; i < prefix_items + local_items_; i++)
-        {
-            size_t j0 = 1;
-            ValueType el0 = unsorted_reader.Next<ValueType>();
-
-            // run item down the tree
-            for (size_t l = 0; l < log_k; l++)
+            for (size_t b = 0; b < n; ++b)
             {
-                j0 = 2 * j0 + (compare_function_(el0, tree[j0]) ? 0 : 1);
-            }
+                size_t bucket = oracle[b] - k;
 
-            size_t b0 = j0 - k;
+                while (bucket && EqualSampleGreaterIndex(
+                           sorted_splitters[bucket - 1],
+                           SampleIndexPair(batch[b], i + b))) {
+                    bucket--;
+                }
 
-            while (b0 && EqualSampleGreaterIndex(
-                       sorted_splitters[b0 - 1], SampleIndexPair(el0, i))) {
-                b0--;
+                assert(data_writers[bucket].IsValid());
+                data_writers[bucket].Put(batch[b]);
             }
 
-            assert(data_writers[b0].IsValid());
-            data_writers[b0].Put(el0);
+            i += n;
         }
 
         // close writers and flush data
@@ -572,60 +757,69 @@ private:
             return;
         }
 
-        // stream to send samples to process 0 and receive them back
-        data::MixStreamPtr sample_stream = context_.GetNewMixStream(this);
-
-        // Send all samples to worker 0.
-        std::vector<data::MixStream::Writer> sample_writers =
-            sample_stream->GetWriters();
-
-        for (const SampleIndexPair& sample : samples_) {
-            // send samples but add the local prefix to index ranks
-            sample_writers[0].Put(
-                SampleIndexPair(sample.first, prefix_items + sample.second));
-        }
-        sample_writers[0].Close();
-        std::vector<SampleIndexPair>().swap(samples_);
-
         // Get the ceiling of log(num_total_workers), as SSSS needs 2^n buckets.
         size_t ceil_log = common::IntegerLog2Ceil(num_total_workers);
         size_t workers_algo = size_t(1) << ceil_log;
         size_t splitter_count_algo = workers_algo - 1;
 
-        std::vector<SampleIndexPair> splitters;
-        splitters.reserve(workers_algo);
-
-        if (context_.my_rank() == 0) {
-            FindAndSendSplitters(splitters, samples_.size(),
-                                 sample_stream, sample_writers);
-        }
-        else {
-            // Close unused emitters
-            for (size_t j = 1; j < num_total_workers; j++) {
-                sample_writers[j].Close();
-            }
-            data::MixStream::MixReader reader =
-                sample_stream->GetMixReader(/* consume */ true);
-            while (reader.HasNext()) {
-                splitters.push_back(reader.template Next<SampleIndexPair>());
-            }
-        }
-        sample_writers.clear();
-        sample_stream->Close();
+        ImbalanceEstimate estimate(1.0, 0.0);
+        std::vector<SampleIndexPair> splitters =
+            SelectSplitters(prefix_items, workers_algo, estimate);
 
         // code from SS2NPartition, slightly altered
 
         std::vector<ValueType> splitter_tree(workers_algo + 1);
 
-        // add sentinel splitters if fewer nodes than splitters.
-        for (size_t i = num_total_workers; i < workers_algo; i++) {
-            splitters.push_back(splitters.back());
-        }
-
         TreeBuilder(splitter_tree.data(),
                     splitters.data(),
                     splitter_count_algo);
 
+        // in skew-aware mode: check the partition sizes estimated from the
+        // sample and re-sample with a larger sample if a worker would be
+        // overloaded. Only if the estimate is too close to the limit to
+        // decide, count the actual bucket sizes of all items.
+        for (size_t round = 0; skew_aware_; ++round)
+        {
+            const double limit = 1.0 + desired_imbalance_;
+            double imbalance = estimate.first;
+            bool counted = false;
+
+            if (estimate.first * (1.0 + estimate.second) > limit &&
+                estimate.first / (1.0 + estimate.second) <= limit) {
+                imbalance = CountBuckets(
+                    splitter_tree.data(), workers_algo, ceil_log,
+                    splitters.data(), prefix_items, total_items);
+                counted = true;
+            }
+
+            Super::logger_
+                << "class" << "SortNode"
+                << "event" << "resample_check"
+                << "round" << round
+                << "estimate" << estimate.first
+                << "error" << estimate.second
+                << "counted" << counted
+                << "imbalance" << imbalance
+                << "sample_size" << samples_.size();
+
+            if (imbalance <= limit || round == max_resample_rounds_) break;
+
+            // the decision is equal on all workers, since the estimate was
+            // broadcast and the bucket sizes were summed up.
+            size_t sample_size = wanted_sample_size();
+            for (size_t r = 0; r <= round; ++r) sample_size *= resample_factor_;
+
+            Resample(std::min(sample_size, max_sample_size()));
+
+            splitters = SelectSplitters(prefix_items, workers_algo, estimate);
+            TreeBuilder(splitter_tree.data(),
+                        splitters.data(),
+                        splitter_count_algo);
+        }
+        // number of local samples the splitters were finally selected from
+        const size_t sample_size = samples_.size();
+        std::vector<SampleIndexPair>().swap(samples_);
+
         data::MixStreamPtr data_stream = context_.GetNewMixStream(this);
 
         std::thread thread;
@@ -667,13 +861,148 @@ private:
             balance = 1 / balance;
         }
 
+        // maximum output size of all workers relative to the average
+        size_t max_out_size = context_.net.AllReduce(
+            local_out_size_, common::maximum<size_t>());
+        double imbalance =
+            static_cast<double>(max_out_size)
+            * static_cast<double>(num_total_workers)
+            / static_cast<double>(total_items);
+
         Super::logger_
             << "class" << "SortNode"
             << "event" << "done"
             << "workers" << num_total_workers
             << "local_out_size" << local_out_size_
             << "balance" << balance
-            << "sample_size" << samples_.size();
+            << "imbalance" << imbalance
+            << "sample_size" << sample_size;
+    }
+
+    /*!
+     * Send the local samples_ to worker 0, which selects num_total_workers - 1
+     * splitters and sends them to all workers. Returns the sorted splitters,
+     * padded with sentinels to workers_algo - 1. In skew-aware mode, the
+     * estimated imbalance of the partition is broadcast to all workers.
+     */
+    std::vector<SampleIndexPair> SelectSplitters(
+        size_t prefix_items, size_t workers_algo,
+        ImbalanceEstimate& estimate) {
+
+        size_t num_total_workers = context_.num_workers();
+
+        // stream to send samples to process 0 and receive them back
+        data::MixStreamPtr sample_stream = context_.GetNewMixStream(this);
+
+        // Send all samples to worker 0.
+        std::vector<data::MixStream::Writer> sample_writers =
+            sample_stream->GetWriters();
+
+        // each sample represents the same number of local items
+        const double weight =
+            static_cast<double>(local_items_)
+            / static_cast<double>(std::max<size_t>(samples_.size(), 1));
+
+        for (const SampleIndexPair& sample : samples_) {
+            // send samples but add the local prefix to index ranks
+            sample_writers[0].Put(
+                WeightedSample(
+                    SampleIndexPair(sample.first, prefix_items + sample.second),
+                    weight));
+        }
+        sample_writers[0].Close();
+        size_t sample_size = samples_.size();
+
+        std::vector<SampleIndexPair> splitters;
+        splitters.reserve(workers_algo);
+
+        if (context_.my_rank() == 0) {
+            FindAndSendSplitters(splitters, sample_size,
+                                 sample_stream, sample_writers, estimate);
+        }
+        else {
+            // Close unused emitters
+            for (size_t j = 1; j < num_total_workers; j++) {
+                sample_writers[j].Close();
+            }
+            data::MixStream::MixReader reader =
+                sample_stream->GetMixReader(/* consume */ true);
+            while (reader.HasNext()) {
+                splitters.push_back(reader.template Next<SampleIndexPair>());
+            }
+        }
+        sample_writers.clear();
+        sample_stream->Close();
+
+        // add sentinel splitters if fewer nodes than splitters.
+        for (size_t i = num_total_workers; i < workers_algo; i++) {
+            splitters.push_back(splitters.back());
+        }
+
+        if (skew_aware_)
+            estimate = context_.net.Broadcast(estimate);
+
+        return splitters;
+    }
+
+    /*!
+     * Classify all local items with the splitter tree, sum up the bucket sizes
+     * of all workers, and return the largest bucket size relative to the
+     * average. This costs a full pass over the local items and is only used if
+     * the estimate from the sample is inconclusive.
+     */
+    double CountBuckets(
+        const ValueType* const tree, size_t k, size_t log_k,
+        const SampleIndexPair* const sorted_splitters,
+        size_t prefix_items, size_t total_items) {
+
+        std::vector<size_t> bucket_size(k, 0);
+
+        auto reader = unsorted_file_.GetKeepReader();
+        for (size_t i = 0; i < local_items_; ++i)
+        {
+            ValueType el = reader.template Next<ValueType>();
+
+            size_t j = 1;
+            for (size_t l = 0; l < log_k; l++)
+                j = 2 * j + (compare_function_(el, tree[j]) ? 0 : 1);
+
+            size_t b = j - k;
+            while (b && EqualSampleGreaterIndex(
+                       sorted_splitters[b - 1],
+                       SampleIndexPair(el, prefix_items + i))) {
+                b--;
+            }
+            ++bucket_size[b];
+        }
+
+        bucket_size = context_.net.AllReduce(
+            bucket_size, common::ComponentSum<std::vector<size_t> >());
+
+        size_t max_bucket =
+            *std::max_element(bucket_size.begin(), bucket_size.end());
+
+        LOG << "CountBuckets() max_bucket=" << max_bucket
+            << " total_items=" << total_items;
+
+        return static_cast<double>(max_bucket)
+               * static_cast<double>(context_.num_workers())
+               / static_cast<double>(total_items);
+    }
+
+    //! Replace samples_ with sample_size local items drawn by random access.
+    void Resample(size_t sample_size) {
+        samples_.clear();
+        if (local_items_ == 0) return;
+
+        size_t pick_items = std::min(local_items_, sample_size);
+        samples_.reserve(pick_items);
+
+        for (size_t i = 0; i < pick_items; ++i) {
+            size_t index = rng_() % local_items_;
+            samples_.emplace_back(
+                unsorted_file_.GetItemAt<ValueType>(index), index);
+        }
     }
 
     void ReceiveItems(data::MixStreamPtr& data_stream) {
@@ -684,6 +1013,11 @@ private:
 
         // M/2 such that the other half is used to prepare the next bulk
         size_t capacity = DIABase::mem_limit_ / sizeof(ValueType) / 2;
+
+        // the sort algorithm's buffer is taken from the run's half
+        if (SortAlgorithmBufferNeeded<ValueType, CompareFunction>(
+                sort_algorithm_, 0))
+            capacity /= 2;
         std::vector<ValueType> vec;
         vec.reserve(capacity);
 
@@ -752,13 +1086,186 @@ private:
     }
 };
 
+/*!
+ * Default sort algorithm used by Sort() for local run formation. Selects at
+ * compile time: integral items compared with std::less or std::greater are
+ * sorted using an LSD radix sort, items with a fixed-width at_radix() key (see
+ * common::has_radix_key) compared with std::less are sorted using an MSD radix
+ * sort, and all other items are sorted using std::sort().
+ */
 class DefaultSortAlgorithm
 {
 public:
+    //! the LSD radix sort of integral items allocates a buffer of the range
+    template <typename ValueType, typename CompareFunction>
+    using UsesBuffer = std::integral_constant<
+              bool,
+              std::is_integral<ValueType>::value &&
+              !std::is_same<ValueType, bool>::value &&
+              (std::is_same<CompareFunction, std::less<ValueType> >::value ||
+               std::is_same<CompareFunction, std::greater<ValueType> >::value)>;
+
+    template <typename Iterator, typename CompareFunction>
+    void operator () (Iterator begin, Iterator end, CompareFunction cmp) const {
+        using ValueType = typename std::iterator_traits<Iterator>::value_type;
+        return Select<ValueType>(begin, end, cmp);
+    }
+
+private:
+    //! integral items in ascending order
+    template <typename ValueType, typename Iterator>
+    static typename std::enable_if<
+        std::is_integral<ValueType>::value &&
+        !std::is_same<ValueType, bool>::value>::type
+    Select(Iterator begin, Iterator end, const std::less<ValueType>&) {
+        common::radix_sort_integer(begin, end);
+    }
+
+    //! integral items in descending order
+    template <typename ValueType, typename Iterator>
+    static typename std::enable_if<
+        std::is_integral<ValueType>::value &&
+        !std::is_same<ValueType, bool>::value>::type
+    Select(Iterator begin, Iterator end, const std::greater<ValueType>&) {
+        common::radix_sort_integer(begin, end);
+        std::reverse(begin, end);
+    }
+
+    //! items with a fixed-width 8-bit character key in ascending order
+    template <typename ValueType, typename Iterator>
+    static typename std::enable_if<
+        common::has_radix_key<ValueType>::value>::type
+    Select(Iterator begin, Iterator end, const std::less<ValueType>& cmp) {
+        common::radix_sort_CI<ValueType::radix_depth>(begin, end, 256, cmp);
+    }
+
+    //! fallback: comparison based sort
+    template <typename ValueType, typename Iterator, typename CompareFunction>
+    static void Select(Iterator begin, Iterator end, const CompareFunction& cmp) {
+        std::sort(begin, end, cmp);
+    }
+};
+
+/*!
+ * Parallel sort algorithm for use with Sort(), which sorts the item vector of
+ * a run using multiple threads of a common::ThreadPool. The range is split into
+ * one chunk per thread, the chunks are sorted concurrently using
+ * SequentialSortAlgorithm, and then merged pairwise in rounds, in which all
+ * pairs of a round are merged concurrently.
+ *
+ * This is useful when running fewer workers than cores per host, e.g. with
+ * THRILL_WORKERS_PER_HOST=1, as otherwise all other cores are idle during run
+ * formation. By default, SortNode sets the number of threads to the number of
+ * cores divided by the workers per host. The ThreadPool is started on first
+ * use and reused for all runs.
+ */
+template <typename SequentialSortAlgorithm = DefaultSortAlgorithm>
+class ParallelSortAlgorithm
+{
+public:
+    //! minimum number of items per thread, smaller ranges use fewer threads.
+    static constexpr size_t min_chunk_size = 65536;
+
+    //! the chunks together need the buffer of the sequential algorithm, and
+    //! std::inplace_merge() of two chunks allocates up to half their range.
+    template <typename ValueType, typename CompareFunction>
+    using UsesBuffer = std::true_type;
+
+    //! with a single thread, only the sequential algorithm's buffer is used.
+    template <typename ValueType, typename CompareFunction>
+    bool uses_buffer() const {
+        return num_threads_ > 1 ||
+               SortAlgorithmUsesBuffer<
+            SequentialSortAlgorithm, ValueType, CompareFunction>::value;
+    }
+
+    //! Construct with num_threads threads, or if zero, the number of cores
+    //! divided by the workers per host.
+    explicit ParallelSortAlgorithm(
+        size_t num_threads = 0,
+        const SequentialSortAlgorithm& sequential = SequentialSortAlgorithm())
+        : num_threads_(num_threads), auto_threads_(num_threads == 0),
+          sequential_(sequential) {
+        if (auto_threads_) set_workers_per_host(1);
+    }
+
+    //! copies start their own ThreadPool
+    ParallelSortAlgorithm(const ParallelSortAlgorithm& other)
+        : num_threads_(other.num_threads_), auto_threads_(other.auto_threads_),
+          sequential_(other.sequential_) { }
+
+    //! copies start their own ThreadPool
+    ParallelSortAlgorithm& operator = (const ParallelSortAlgorithm& other) {
+        num_threads_ = other.num_threads_;
+        auto_threads_ = other.auto_threads_;
+        sequential_ = other.sequential_;
+        pool_.reset();
+        return *this;
+    }
+
+    //! divide the cores among the workers of the host, unless the number of
+    //! threads was given.
+    void set_workers_per_host(size_t workers_per_host) {
+        if (!auto_threads_) return;
+        num_threads_ = std::max<size_t>(
+            1, std::thread::hardware_concurrency() / workers_per_host);
+        pool_.reset();
+    }
+
+    //! number of threads to use
+    size_t num_threads() const { return num_threads_; }
+
     template <typename Iterator, typename CompareFunction>
     void operator () (Iterator begin, Iterator end, CompareFunction cmp) const {
-        return std::sort(begin, end, cmp);
+        const size_t size = end - begin;
+        const size_t p = std::min(num_threads_, size / min_chunk_size);
+
+        if (p <= 1)
+            return sequential_(begin, end, cmp);
+
+        // chunk boundaries, chunk i is [bound[i],bound[i+1])
+        std::vector<size_t> bound(p + 1);
+        for (size_t i = 0; i <= p; ++i)
+            bound[i] = i * size / p;
+
+        if (!pool_)
+            pool_ = std::make_unique<common::ThreadPool>(num_threads_);
+        common::ThreadPool& pool = *pool_;
+
+        for (size_t i = 0; i < p; ++i) {
+            pool.Enqueue(
+                [this, begin, &bound, &cmp, i]() {
+                    sequential_(begin + bound[i], begin + bound[i + 1], cmp);
+                });
+        }
+        pool.LoopUntilEmpty();
+
+        // merge sorted chunks pairwise, doubling the width in each round
+        for (size_t width = 1; width < p; width *= 2) {
+            for (size_t i = 0; i + width < p; i += 2 * width) {
+                pool.Enqueue(
+                    [begin, &bound, &cmp, i, width, p]() {
+                        std::inplace_merge(
+                            begin + bound[i], begin + bound[i + width],
+                            begin + bound[std::min(i + 2 * width, p)], cmp);
+                    });
+            }
+            pool.LoopUntilEmpty();
+        }
     }
+
+private:
+    //! number of threads to use
+    size_t num_threads_;
+
+    //! whether num_threads_ is derived from the workers per host
+    bool auto_threads_;
+
+    //! sort algorithm used for each chunk
+    SequentialSortAlgorithm sequential_;
+
+    //! threads sorting and merging the chunks, started on first use.
+    mutable std::unique_ptr<common::ThreadPool> pool_;
 };
 
 template <typename ValueType, typename Stack>
@@ -825,6 +1332,40 @@ auto DIA<ValueType, Stack>::Sort(const CompareFunction &compare_function,
     return DIA<ValueType>(node);
 }
 
+template <typename ValueType, typename Stack>
+template <typename CompareFunction>
+auto DIA<ValueType, Stack>::Sort(
+    struct SkewAwareTag const &,
+    const CompareFunction &compare_function) const {
+    assert(IsValid());
+
+    using SortNode = api::SortNode<
+              ValueType, CompareFunction, DefaultSortAlgorithm>;
+
+    static_assert(
+        std::is_convertible<
+            ValueType,
+            typename FunctionTraits<CompareFunction>::template arg<0> >::value,
+        "CompareFunction has the wrong input type");
+
+    static_assert(
+        std::is_convertible<
+            ValueType,
+            typename FunctionTraits<CompareFunction>::template arg<1> >::value,
+        "CompareFunction has the wrong input type");
+
+    static_assert(
+        std::is_convertible<
+            typename FunctionTraits<CompareFunction>::result_type,
+            bool>::value,
+        "CompareFunction has the wrong output type (should be bool)");
+
+    auto node = common::MakeCounting<SortNode>(
+        *this, compare_function, DefaultSortAlgorithm(), /* skew_aware */ true);
+
+    return DIA<ValueType>(node);
+}
+
 } // namespace api
 } // namespace thrill
 
@@ -20,8 +20,10 @@
 #include <thrill/api/dop_node.hpp>
 #include <thrill/common/functional.hpp>
 #include <thrill/common/logger.hpp>
+#include <thrill/common/math.hpp>
 #include <thrill/common/meta.hpp>
 #include <thrill/common/string.hpp>
+#include <thrill/data/dyn_block_reader.hpp>
 #include <thrill/data/file.hpp>
 
 #include <algorithm>
@@ -86,6 +88,9 @@ class ZipNode final : public DOpNode<ValueType>
     using ZipArgs =
               typename common::FunctionTraits<ZipFunction>::args_plain;
 
+    static_assert(kNumInputs <= 8 * sizeof(size_t),
+                  "Zip() supports at most one input per bit of size_t");
+
 public:
     /*!
      * Constructor for a ZipNode.
@@ -142,33 +147,26 @@ public:
         size_t result_count = 0;
 
         if (result_size_ != 0) {
-            if (NoRebalance) {
-                // get inbound readers from all Streams
-                std::array<data::File::Reader, kNumInputs> readers;
-                for (size_t i = 0; i < kNumInputs; ++i)
+            // get inbound readers from the local Files of inputs which were
+            // not scattered, and from the Streams of all others.
+            std::array<data::DynBlockReader, kNumInputs> readers;
+            for (size_t i = 0; i < kNumInputs; ++i) {
+                if (NoRebalance || !streams_[i]) {
                     readers[i] = files_[i].GetReader(consume);
-
-                ReaderNext<data::File::Reader> reader_next(*this, readers);
-
-                while (reader_next.HasNext()) {
-                    auto v = common::VariadicMapEnumerate<kNumInputs>(reader_next);
-                    this->PushItem(common::ApplyTuple(zip_function_, v));
-                    ++result_count;
+                }
+                else {
+                    readers[i] = data::ConstructDynBlockReader<
+                        data::CatStream::CatBlockSource>(
+                        streams_[i]->GetCatBlockSource(consume));
                 }
             }
-            else {
-                // get inbound readers from all Streams
-                std::array<data::CatStream::CatReader, kNumInputs> readers;
-                for (size_t i = 0; i < kNumInputs; ++i)
-                    readers[i] = streams_[i]->GetCatReader(consume);
 
-                ReaderNext<data::CatStream::CatReader> reader_next(*this, readers);
+            ReaderNext<data::DynBlockReader> reader_next(*this, readers);
 
-                while (reader_next.HasNext()) {
-                    auto v = common::VariadicMapEnumerate<kNumInputs>(reader_next);
-                    this->PushItem(common::ApplyTuple(zip_function_, v));
-                    ++result_count;
-                }
+            while (reader_next.HasNext()) {
+                auto v = common::VariadicMapEnumerate<kNumInputs>(reader_next);
+                this->PushItem(common::ApplyTuple(zip_function_, v));
+                ++result_count;
             }
         }
 
@@ -198,7 +196,8 @@ private:
     //! Writers to intermediate files
     data::File::Writer writers_[kNumInputs];
 
-    //! Array of inbound CatStreams
+    //! Array of inbound CatStreams, empty for inputs which already have the
+    //! target distribution and are read from files_.
     data::CatStreamPtr streams_[kNumInputs];
 
     //! \name Variables for Calculating Exchange
@@ -247,7 +246,9 @@ private:
         ZipNode* node_;
     };
 
-    //! Scatter items from DIA "Index" to other workers if necessary.
+    //! Scatter items from DIA "Index" to other workers if necessary. The items
+    //! are distributed like common::CalculateLocalRange(), which is also the
+    //! distribution of Generate(), ReduceToIndex(), and GroupToIndex().
     template <size_t Index>
     void DoScatter() {
         const size_t workers = context_.num_workers();
@@ -256,38 +257,20 @@ private:
         size_t local_end = std::min(
             result_size_,
             dia_size_prefixsum_[Index] + files_[Index].num_items());
-        size_t local_size = local_end - local_begin;
-
-        //! number of elements per worker (rounded up)
-        size_t per_pe = (result_size_ + workers - 1) / workers;
-        //! offsets for scattering
-        std::vector<size_t> offsets(workers + 1, 0);
-
-        size_t offset = 0;
-        size_t count = std::min(per_pe - local_begin % per_pe, local_size);
-        size_t target = local_begin / per_pe;
 
         sLOG << "input" << Index
              << "local_begin" << local_begin << "local_end" << local_end
-             << "local_size" << local_size
-             << "result_size_" << result_size_ << "pre_pe" << per_pe
-             << "count" << count << "target" << target;
-
-        //! do as long as there are elements to be scattered, includes elements
-        //! kept on this worker
-        while (local_size > 0 && target < workers) {
-            ++target;
-            offsets[target] = offset + count;
-            local_begin += count;
-            local_size -= count;
-            offset += count;
-            count = std::min(per_pe - local_begin % per_pe, local_size);
-        }
+             << "result_size_" << result_size_;
 
-        //! fill offset vector, no more scattering here
-        while (target < workers) {
-            ++target;
-            offsets[target] = target == 0 ? 0 : offsets[target - 1];
+        //! offsets for scattering: intersect the local range with the target
+        //! range of each worker, includes elements kept on this worker
+        std::vector<size_t> offsets(workers + 1, 0);
+        for (size_t w = 0; w < workers; ++w) {
+            common::Range target =
+                common::CalculateLocalRange(result_size_, workers, w);
+            size_t begin = std::max(target.begin, local_begin);
+            size_t end = std::min(target.end, local_end);
+            offsets[w + 1] = offsets[w] + (begin < end ? end - begin : 0);
         }
 
         LOG << "offsets[" << Index << "] = " << common::VecToStr(offsets);
@@ -355,10 +338,25 @@ private:
 
         if (result_size_ == 0) return;
 
+        // inputs whose local items are exactly the target range on all
+        // workers, e.g. DIAs produced by ReduceToIndex() or a Cache() of them,
+        // are zipped locally without scattering.
+        common::Range target = context_.CalculateLocalRange(result_size_);
+        size_t local_aligned = 0;
+        for (size_t i = 0; i < kNumInputs; ++i) {
+            if (dia_size_prefixsum_[i] == target.begin &&
+                dia_local_size[i] == target.size())
+                local_aligned |= size_t(1) << i;
+        }
+        size_t aligned = context_.net.AllReduce(
+            local_aligned, std::bit_and<size_t>());
+
+        sLOG << "aligned inputs mask" << aligned;
+
         // perform scatters to exchange data, with different types.
         common::VariadicCallEnumerate<kNumInputs>(
             [=](auto index) {
-                (void)index;
+                if (aligned & (size_t(1) << decltype(index)::index)) return;
                 this->DoScatter<decltype(index)::index>();
             });
     }
@@ -43,6 +43,13 @@ static constexpr unsigned g_cache_line_size = 64;
 
 #if __linux__
 #define THRILL_HAVE_LINUXAIO_FILE 1
+#define THRILL_HAVE_NET_EPOLL 1
+#define THRILL_HAVE_NET_SHM 1
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define THRILL_HAVE_IOURING_FILE 1
+#endif
+#endif
 #endif
 
 #if defined(_MSC_VER)
@@ -0,0 +1,206 @@
+/*******************************************************************************
+ * thrill/common/lz_compress.cpp
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <thrill/common/lz_compress.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace thrill {
+namespace common {
+
+//! number of bits of the hash table of previous positions
+static constexpr size_t kHashBits = 12;
+
+//! minimum length of a back-reference
+static constexpr size_t kMinMatch = 4;
+
+//! maximum distance of a back-reference
+static constexpr size_t kMaxOffset = 65535;
+
+//! the last bytes are always encoded as literals, such that the matcher can
+//! always read four bytes.
+static constexpr size_t kLastLiterals = 5;
+
+//! number of consecutive misses after which the matcher skips ahead faster on
+//! incompressible data.
+static constexpr size_t kSkipTrigger = 6;
+
+static inline uint32_t Load32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t Hash32(uint32_t v) {
+    return (v * 2654435761u) >> (32 - kHashBits);
+}
+
+//! write extension bytes of a length field which overflowed its four token
+//! bits. returns nullptr if the output buffer is full.
+static inline uint8_t* PutLength(uint8_t* op, uint8_t* oend, size_t len) {
+    for ( ; len >= 255; len -= 255) {
+        if (op == oend) return nullptr;
+        *op++ = 255;
+    }
+    if (op == oend) return nullptr;
+    *op++ = static_cast<uint8_t>(len);
+    return op;
+}
+
+//! write a token with literals [anchor, anchor + lit_len) and, if
+//! match_len != 0, a back-reference. returns nullptr if the output is full.
+static inline uint8_t* PutSequence(
+    uint8_t* op, uint8_t* oend, const uint8_t* anchor, size_t lit_len,
+    size_t offset, size_t match_len) {
+
+    if (op == oend) return nullptr;
+    uint8_t* token = op++;
+
+    *token = static_cast<uint8_t>(std::min<size_t>(lit_len, 15) << 4);
+    if (lit_len >= 15 && !(op = PutLength(op, oend, lit_len - 15)))
+        return nullptr;
+
+    if (static_cast<size_t>(oend - op) < lit_len) return nullptr;
+    std::memcpy(op, anchor, lit_len);
+    op += lit_len;
+
+    if (match_len == 0) return op;
+
+    if (static_cast<size_t>(oend - op) < 2) return nullptr;
+    *op++ = static_cast<uint8_t>(offset & 0xFF);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+
+    match_len -= kMinMatch;
+    *token |= static_cast<uint8_t>(std::min<size_t>(match_len, 15));
+    if (match_len >= 15 && !(op = PutLength(op, oend, match_len - 15)))
+        return nullptr;
+
+    return op;
+}
+
+size_t LzCompress(const uint8_t* input, size_t input_size,
+                  uint8_t* output, size_t output_capacity) {
+
+    const uint8_t* ip = input, * anchor = input;
+    const uint8_t* const iend = input + input_size;
+    uint8_t* op = output, * const oend = output + output_capacity;
+
+    if (input_size > kMinMatch + kLastLiterals)
+    {
+        // positions of previous occurrences of four byte sequences
+        uint32_t table[size_t(1) << kHashBits];
+        std::fill(table, table + (size_t(1) << kHashBits), 0);
+
+        const uint8_t* const mlimit = iend - kLastLiterals - kMinMatch;
+        const uint8_t* const mend = iend - kLastLiterals;
+        size_t misses = 0;
+
+        while (ip <= mlimit)
+        {
+            uint32_t seq = Load32(ip);
+            uint32_t h = Hash32(seq);
+            const uint8_t* ref = input + table[h];
+            table[h] = static_cast<uint32_t>(ip - input);
+
+            if (ref >= ip || static_cast<size_t>(ip - ref) > kMaxOffset ||
+                Load32(ref) != seq) {
+                ip += 1 + (misses++ >> kSkipTrigger);
+                continue;
+            }
+            misses = 0;
+
+            // extend match forward
+            size_t match_len = kMinMatch;
+            while (ip + match_len < mend && ref[match_len] == ip[match_len])
+                ++match_len;
+
+            op = PutSequence(op, oend, anchor, ip - anchor,
+                             ip - ref, match_len);
+            if (!op) return 0;
+
+            ip += match_len;
+            anchor = ip;
+        }
+    }
+
+    // last token contains only literals
+    op = PutSequence(op, oend, anchor, iend - anchor, 0, 0);
+    if (!op) return 0;
+
+    return op - output;
+}
+
+bool LzDecompress(const uint8_t* input, size_t input_size,
+                  uint8_t* output, size_t output_size) {
+
+    const uint8_t* ip = input;
+    const uint8_t* const iend = input + input_size;
+    uint8_t* op = output, * const oend = output + output_size;
+
+    //! read extension bytes of a length field
+    auto get_length =
+        [&ip, iend](size_t& len) {
+            uint8_t b;
+            do {
+                if (ip == iend) return false;
+                b = *ip++;
+                len += b;
+            } while (b == 255);
+            return true;
+        };
+
+    while (ip != iend)
+    {
+        uint8_t token = *ip++;
+
+        // copy literals
+        size_t lit_len = token >> 4;
+        if (lit_len == 15 && !get_length(lit_len)) return false;
+
+        if (static_cast<size_t>(iend - ip) < lit_len ||
+            static_cast<size_t>(oend - op) < lit_len) return false;
+
+        std::memcpy(op, ip, lit_len);
+        ip += lit_len, op += lit_len;
+
+        // last token contains only literals
+        if (ip == iend) return op == oend;
+
+        // copy back-reference, which may overlap the output
+        if (iend - ip < 2) return false;
+        size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+
+        size_t match_len = token & 15;
+        if (match_len == 15 && !get_length(match_len)) return false;
+        match_len += kMinMatch;
+
+        if (offset == 0 || offset > static_cast<size_t>(op - output) ||
+            static_cast<size_t>(oend - op) < match_len) return false;
+
+        const uint8_t* ref = op - offset;
+        if (offset >= match_len) {
+            std::memcpy(op, ref, match_len);
+            op += match_len;
+        }
+        else {
+            for (size_t i = 0; i < match_len; ++i)
+                *op++ = *ref++;
+        }
+    }
+
+    return false;
+}
+
+} // namespace common
+} // namespace thrill
+
+/******************************************************************************/
@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * thrill/common/lz_compress.hpp
+ *
+ * A fast byte-level LZ77 compressor in the style of LZ4, used to compress
+ * Blocks written to external memory or sent over the network.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_COMMON_LZ_COMPRESS_HEADER
+#define THRILL_COMMON_LZ_COMPRESS_HEADER
+
+#include <cstddef>
+#include <cstdint>
+
+namespace thrill {
+namespace common {
+
+/*!
+ * Compress the bytes [input, input + input_size) into the buffer [output,
+ * output + output_capacity). Returns the size of the compressed data, or 0 if
+ * it does not fit into output_capacity, e.g. because the input is not
+ * compressible.
+ *
+ * The compressed stream is a sequence of tokens, each containing a run of
+ * literal bytes followed by a back-reference of at least four bytes into a
+ * window of 64 KiB, except for the last token which contains only literals.
+ */
+size_t LzCompress(const uint8_t* input, size_t input_size,
+                  uint8_t* output, size_t output_capacity);
+
+/*!
+ * Decompress the data [input, input + input_size) created by LzCompress() into
+ * the buffer [output, output + output_size). Returns false if the compressed
+ * data is corrupt or does not decompress to exactly output_size bytes.
+ */
+bool LzDecompress(const uint8_t* input, size_t input_size,
+                  uint8_t* output, size_t output_size);
+
+} // namespace common
+} // namespace thrill
+
+#endif // !THRILL_COMMON_LZ_COMPRESS_HEADER
+
+/******************************************************************************/
@@ -0,0 +1,231 @@
+/*******************************************************************************
+ * thrill/common/numa.cpp
+ *
+ * Detection of the NUMA topology and binding of memory to NUMA nodes.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <thrill/common/defines.hpp>
+#include <thrill/common/logger.hpp>
+#include <thrill/common/numa.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <utility>
+
+#if __linux__
+#include <dirent.h>
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace thrill {
+namespace common {
+
+NumaTopology::NumaTopology() {
+#if __linux__
+    const char* env_numa = getenv("THRILL_NUMA");
+    bool enabled = !(env_numa && strcmp(env_numa, "0") == 0);
+
+    // cpus this process may run on
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool have_allowed =
+        sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    std::vector<std::pair<size_t, std::vector<size_t> > > nodes;
+
+    DIR* dir = enabled ? opendir("/sys/devices/system/node") : nullptr;
+    if (dir) {
+        while (struct dirent* de = readdir(dir)) {
+            if (strncmp(de->d_name, "node", 4) != 0) continue;
+            char* endptr;
+            size_t id = std::strtoul(de->d_name + 4, &endptr, 10);
+            if (endptr == de->d_name + 4 || *endptr != 0) continue;
+
+            std::ifstream in(std::string("/sys/devices/system/node/")
+                             + de->d_name + "/cpulist");
+            std::string line;
+            if (!std::getline(in, line)) continue;
+
+            std::vector<size_t> cpus = ParseCpuList(line);
+            if (have_allowed) {
+                cpus.erase(
+                    std::remove_if(
+                        cpus.begin(), cpus.end(), [&allowed](size_t c) {
+                            return c >= CPU_SETSIZE || !CPU_ISSET(c, &allowed);
+                        }), cpus.end());
+            }
+            if (cpus.empty()) continue;
+
+            nodes.emplace_back(id, std::move(cpus));
+        }
+        closedir(dir);
+    }
+    std::sort(nodes.begin(), nodes.end());
+
+    for (auto& n : nodes) {
+        node_ids_.push_back(n.first);
+        node_cpus_.emplace_back(std::move(n.second));
+    }
+
+    if (node_cpus_.empty() && have_allowed) {
+        std::vector<size_t> cpus;
+        for (size_t c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &allowed)) cpus.push_back(c);
+        }
+        if (!cpus.empty()) {
+            node_ids_.push_back(0);
+            node_cpus_.emplace_back(std::move(cpus));
+        }
+    }
+#endif
+
+    if (node_cpus_.empty()) {
+        std::vector<size_t> cpus(
+            std::max(std::thread::hardware_concurrency(), 1u));
+        for (size_t c = 0; c < cpus.size(); ++c) cpus[c] = c;
+        node_ids_.push_back(0);
+        node_cpus_.emplace_back(std::move(cpus));
+    }
+
+    MakeCpuOrder();
+}
+
+NumaTopology::NumaTopology(
+    const std::vector<size_t>& node_ids,
+    const std::vector<std::vector<size_t> >& node_cpus)
+    : node_ids_(node_ids), node_cpus_(node_cpus) {
+    assert(node_ids_.size() == node_cpus_.size());
+    MakeCpuOrder();
+}
+
+const NumaTopology& NumaTopology::Machine() {
+    static NumaTopology topology;
+    return topology;
+}
+
+void NumaTopology::MakeCpuOrder() {
+    for (size_t n = 0; n < node_cpus_.size(); ++n) {
+        for (const size_t& c : node_cpus_[n]) {
+            cpu_order_.push_back(c);
+            cpu_order_node_.push_back(n);
+        }
+    }
+}
+
+bool NumaTopology::BindMemory(void* addr, size_t size, size_t node) const {
+#if __linux__ && defined(SYS_mbind)
+    static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+
+    // restrict to the whole pages inside the area
+    uintptr_t begin = reinterpret_cast<uintptr_t>(addr);
+    uintptr_t end = begin + size;
+    begin = (begin + page_size - 1) / page_size * page_size;
+    end = end / page_size * page_size;
+    if (begin >= end) return true;
+
+    static constexpr size_t bits = 8 * sizeof(unsigned long);
+    size_t id = node_ids_[node];
+    std::vector<unsigned long> mask(id / bits + 1);
+    mask[id / bits] |= 1ul << (id % bits);
+
+    // the kernel considers one bit less than maxnode
+    long r = syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED,
+                     mask.data(), mask.size() * bits + 1, MPOL_MF_MOVE);
+    if (r != 0) {
+        LOG1 << "NumaTopology::BindMemory() mbind() failed: "
+             << strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    UNUSED(addr);
+    UNUSED(size);
+    UNUSED(node);
+    return false;
+#endif
+}
+
+size_t NumaTopology::MemoryNode(const void* addr, size_t size) const {
+    if (num_nodes() == 1) return 0;
+#if __linux__ && defined(SYS_move_pages)
+    static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+    static constexpr size_t max_pages = 16;
+    if (size == 0) return size_t(-1);
+
+    // query up to max_pages pages evenly spread over the area
+    uintptr_t begin = reinterpret_cast<uintptr_t>(addr) / page_size;
+    uintptr_t end = (reinterpret_cast<uintptr_t>(addr) + size - 1) / page_size;
+    size_t num_pages = std::min<size_t>(end - begin + 1, max_pages);
+
+    std::vector<void*> pages(num_pages);
+    for (size_t i = 0; i < num_pages; ++i) {
+        pages[i] = reinterpret_cast<void*>(
+            (begin + i * (end - begin + 1) / num_pages) * page_size);
+    }
+
+    // without target nodes, move_pages() only returns the page's nodes
+    std::vector<int> status(num_pages);
+    long r = syscall(SYS_move_pages, 0, num_pages, pages.data(), nullptr,
+                     status.data(), 0);
+    if (r != 0) return size_t(-1);
+
+    std::vector<size_t> count(num_nodes());
+    for (const int& s : status) {
+        // negative status: page is not resident
+        if (s < 0) continue;
+        for (size_t n = 0; n < num_nodes(); ++n) {
+            if (node_ids_[n] == static_cast<size_t>(s)) ++count[n];
+        }
+    }
+
+    std::vector<size_t>::iterator it = std::max_element(
+        count.begin(), count.end());
+    if (*it == 0) return size_t(-1);
+    return it - count.begin();
+#else
+    UNUSED(addr);
+    UNUSED(size);
+    return size_t(-1);
+#endif
+}
+
+std::vector<size_t> NumaTopology::ParseCpuList(const std::string& str) {
+    std::vector<size_t> cpus;
+    const char* p = str.c_str();
+    while (*p) {
+        char* endptr;
+        size_t first = std::strtoul(p, &endptr, 10);
+        if (endptr == p) break;
+        size_t last = first;
+        p = endptr;
+        if (*p == '-') {
+            ++p;
+            last = std::strtoul(p, &endptr, 10);
+            if (endptr == p) break;
+            p = endptr;
+        }
+        for (size_t c = first; c <= last; ++c) cpus.push_back(c);
+        if (*p != ',') break;
+        ++p;
+    }
+    return cpus;
+}
+
+} // namespace common
+} // namespace thrill
+
+/******************************************************************************/
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * thrill/common/numa.hpp
+ *
+ * Detection of the NUMA topology and binding of memory to NUMA nodes.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_COMMON_NUMA_HEADER
+#define THRILL_COMMON_NUMA_HEADER
+
+#include <string>
+#include <vector>
+
+namespace thrill {
+namespace common {
+
+/*!
+ * NUMA topology of the machine: the cpus attached to each memory node, as
+ * listed in /sys/devices/system/node. Cpus which are not in the process's
+ * affinity mask are ignored, as are nodes without usable cpus. If no topology
+ * is available, or THRILL_NUMA=0 is set, a single node containing all cpus is
+ * assumed.
+ *
+ * Nodes are numbered consecutively from zero in this class, node_id() returns
+ * the kernel's number of a node.
+ */
+class NumaTopology
+{
+public:
+    //! detect the topology of this machine
+    NumaTopology();
+
+    //! construct a topology from the kernel's node ids and the cpus of each
+    //! node, e.g. for tests.
+    NumaTopology(const std::vector<size_t>& node_ids,
+                 const std::vector<std::vector<size_t> >& node_cpus);
+
+    //! the topology of this machine, detected on first use.
+    static const NumaTopology& Machine();
+
+    //! number of NUMA nodes
+    size_t num_nodes() const { return node_cpus_.size(); }
+
+    //! number of usable cpus on all nodes
+    size_t num_cpus() const { return cpu_order_.size(); }
+
+    //! kernel's id of a NUMA node
+    size_t node_id(size_t node) const { return node_ids_[node]; }
+
+    //! cpus of a NUMA node
+    const std::vector<size_t>& node_cpus(size_t node) const {
+        return node_cpus_[node];
+    }
+
+    //! Return the cpu for the worker thread with the given machine-wide
+    //! index. Cpus are enumerated node by node, hence consecutive workers
+    //! share a node and its memory before the next node is used.
+    size_t WorkerCpu(size_t index) const {
+        return cpu_order_[index % cpu_order_.size()];
+    }
+
+    //! Return the NUMA node of WorkerCpu(index).
+    size_t WorkerNode(size_t index) const {
+        return cpu_order_node_[index % cpu_order_node_.size()];
+    }
+
+    //! Set the preferred NUMA node of the whole pages inside a memory area,
+    //! such that they are placed on the node when first touched. Pages which
+    //! are already resident, e.g. reused by the allocator, are migrated to the
+    //! node. Returns false if this failed or is not supported.
+    bool BindMemory(void* addr, size_t size, size_t node) const;
+
+    //! Return the NUMA node on which most of the resident pages of a memory
+    //! area actually are, or size_t(-1) if no page is resident or this is not
+    //! supported.
+    size_t MemoryNode(const void* addr, size_t size) const;
+
+    //! Parse a cpu list in the kernel's format, e.g. "0-3,8,10-11".
+    static std::vector<size_t> ParseCpuList(const std::string& str);
+
+private:
+    //! kernel's ids of the nodes
+    std::vector<size_t> node_ids_;
+
+    //! cpus of each node
+    std::vector<std::vector<size_t> > node_cpus_;
+
+    //! all cpus, enumerated node by node
+    std::vector<size_t> cpu_order_;
+
+    //! node of each cpu in cpu_order_
+    std::vector<size_t> cpu_order_node_;
+
+    //! fill cpu_order_ from node_cpus_
+    void MakeCpuOrder();
+};
+
+} // namespace common
+} // namespace thrill
+
+#endif // !THRILL_COMMON_NUMA_HEADER
+
+/******************************************************************************/
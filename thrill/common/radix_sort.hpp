@@ -19,8 +19,11 @@
 #include <thrill/common/logger.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <iterator>
 #include <type_traits>
+#include <vector>
 
 namespace thrill {
 namespace common {
@@ -160,6 +163,95 @@ private:
     const size_t K_;
 };
 
+/*!
+ * LSD radix sort of the iterator range [begin,end) containing integral values.
+ * Sorts by 8-bit digits from least to most significant byte, scattering items
+ * back and forth between the range and a temporary buffer of equal size. Passes
+ * in which all items have the same digit are skipped, hence small values in
+ * wide types sort quickly. Signed integers are ordered correctly by flipping
+ * the sign bit of the key. The iterators must point into contiguous memory.
+ */
+template <typename Iterator>
+static inline
+void radix_sort_integer(Iterator begin, Iterator end) {
+
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    using key_type = typename std::make_unsigned<value_type>::type;
+
+    static_assert(std::is_integral<value_type>::value,
+                  "radix_sort_integer() requires integral values");
+
+    static constexpr size_t kDigits = sizeof(value_type);
+    static constexpr key_type kSignFlip =
+        std::is_signed<value_type>::value
+        ? key_type(key_type(1) << (8 * sizeof(value_type) - 1)) : key_type(0);
+
+    const size_t size = end - begin;
+    if (size < 64)
+        return std::sort(begin, end);
+
+    // count occurrences of all digits in one pass
+    std::vector<size_t> bkt(kDigits * 256, 0);
+    for (Iterator it = begin; it != end; ++it) {
+        key_type key = static_cast<key_type>(*it) ^ kSignFlip;
+        for (size_t d = 0; d < kDigits; ++d)
+            ++bkt[d * 256 + ((key >> (8 * d)) & 0xFF)];
+    }
+
+    std::vector<value_type> buffer(size);
+    value_type* src = &*begin;
+    value_type* dst = buffer.data();
+
+    for (size_t d = 0; d < kDigits; ++d) {
+        size_t* bkt_index = bkt.data() + d * 256;
+
+        // skip digit if all items fall into the same bucket
+        key_type first = static_cast<key_type>(*src) ^ kSignFlip;
+        if (bkt_index[(first >> (8 * d)) & 0xFF] == size)
+            continue;
+
+        // exclusive prefix sum
+        size_t sum = 0;
+        for (size_t i = 0; i < 256; ++i) {
+            size_t c = bkt_index[i];
+            bkt_index[i] = sum;
+            sum += c;
+        }
+
+        // scatter items stably into destination
+        for (const value_type* v = src; v != src + size; ++v) {
+            key_type key = static_cast<key_type>(*v) ^ kSignFlip;
+            dst[bkt_index[(key >> (8 * d)) & 0xFF]++] = *v;
+        }
+
+        std::swap(src, dst);
+    }
+
+    // copy back if the last pass ended in the buffer
+    if (src != &*begin)
+        std::copy(src, src + size, begin);
+}
+
+/*!
+ * Type trait whether items of Type can be radix sorted automatically by
+ * radix_sort_CI(): Type must provide an at_radix(depth) method returning an
+ * 8-bit unsigned character, and a static constexpr size_t radix_depth member
+ * containing the number of characters of the fixed-width key. The ordering
+ * defined by the characters must match Type's operator <.
+ */
+template <typename Type, typename = void>
+struct has_radix_key : public std::false_type { };
+
+template <typename Type>
+struct has_radix_key<
+    Type, typename std::enable_if<
+        std::is_same<
+            typename std::decay<
+                decltype(std::declval<const Type&>().at_radix(0))>::type,
+            uint8_t>::value &&
+        (Type::radix_depth > 0)>::type>
+    : public std::true_type { };
+
 } // namespace common
 } // namespace thrill
 
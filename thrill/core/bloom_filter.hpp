@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * thrill/core/bloom_filter.hpp
+ *
+ * Bloom filter on key hashes, which can be merged by an AllReduce.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_CORE_BLOOM_FILTER_HEADER
+#define THRILL_CORE_BLOOM_FILTER_HEADER
+
+#include <thrill/core/reduce_functional.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace thrill {
+namespace core {
+
+/*!
+ * A Bloom filter on 64-bit key hashes. The num_hashes bit positions of a key
+ * are derived from its hash by double hashing. Contains() never returns false
+ * for an inserted hash, but may return true for others with a probability of
+ * roughly 1% using ten bits per key.
+ *
+ * The bit array is a plain vector of words, hence the filters of all workers,
+ * which must have been constructed with equal parameters, are merged by an
+ * AllReduce with Union().
+ */
+class BloomFilter
+{
+public:
+    //! bit array of the filter
+    using Words = std::vector<uint64_t>;
+
+    //! Construct an empty filter sized for num_keys keys.
+    explicit BloomFilter(size_t num_keys = 0, size_t bits_per_key = 10)
+        : words_(std::max<size_t>(1, (num_keys * bits_per_key + 63) / 64), 0),
+          // the optimal number of hash functions is ln(2) * bits_per_key
+          num_hashes_(std::max<size_t>(1, bits_per_key * 69 / 100)) { }
+
+    //! Insert a key hash.
+    void Insert(const uint64_t& hash) {
+        uint64_t a = Hash128to64(0, hash), b = Hash128to64(1, hash) | 1;
+        for (size_t i = 0; i < num_hashes_; ++i, a += b) {
+            size_t bit = a % num_bits();
+            words_[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+    }
+
+    //! Test if a key hash was possibly inserted.
+    bool Contains(const uint64_t& hash) const {
+        uint64_t a = Hash128to64(0, hash), b = Hash128to64(1, hash) | 1;
+        for (size_t i = 0; i < num_hashes_; ++i, a += b) {
+            size_t bit = a % num_bits();
+            if (!(words_[bit / 64] & (uint64_t(1) << (bit % 64))))
+                return false;
+        }
+        return true;
+    }
+
+    //! Returns the number of bits in the filter.
+    size_t num_bits() const { return words_.size() * 64; }
+
+    //! Returns the bit array.
+    const Words& words() const { return words_; }
+
+    //! Replace the bit array, e.g. by the union of those of all workers.
+    void set_words(const Words& words) {
+        assert(words.size() == words_.size());
+        words_ = words;
+    }
+
+    //! Merge two bit arrays, usable as sum operation of an AllReduce.
+    static Words Union(const Words& a, const Words& b) {
+        assert(a.size() == b.size());
+        Words out(a);
+        for (size_t i = 0; i < out.size(); ++i)
+            out[i] |= b[i];
+        return out;
+    }
+
+private:
+    //! bit array
+    Words words_;
+
+    //! number of bits set per key
+    size_t num_hashes_;
+};
+
+} // namespace core
+} // namespace thrill
+
+#endif // !THRILL_CORE_BLOOM_FILTER_HEADER
+
+/******************************************************************************/
@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * thrill/core/hot_key_sketch.hpp
+ *
+ * Count-Min sketch detecting heavy hitter keys for skew splitting.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_CORE_HOT_KEY_SKETCH_HEADER
+#define THRILL_CORE_HOT_KEY_SKETCH_HEADER
+
+#include <thrill/core/reduce_functional.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace thrill {
+namespace core {
+
+/*!
+ * Detects heavy hitters among a stream of key hashes using a Count-Min sketch
+ * with conservative update. A key is hot if its estimated count is at least
+ * hot_fraction of all counted keys, after at least min_items keys were
+ * counted. As Count-Min only overestimates, every key exceeding the threshold
+ * is found, but some cold keys may be reported hot due to collisions.
+ *
+ * The width of the rows is derived from the threshold, such that collisions
+ * overestimate a count by at most epsilon * hot_fraction of all counted keys
+ * with probability 1 - e^-depth. The hot keys are kept as a small sorted vector
+ * of hashes, which is also the format in which the hot sets of all workers are
+ * merged. It is capped at max_hot() keys: a key stays hot once it was reported,
+ * since its items may already have been spread, hence keys turning hot after
+ * the set is full are treated as cold.
+ */
+class HotKeySketch
+{
+public:
+    //! sorted vector of the hashes of hot keys
+    using HotSet = std::vector<uint64_t>;
+
+    HotKeySketch(double hot_fraction, size_t min_items,
+                 double epsilon = 0.25, size_t depth = 4)
+        : hot_fraction_(hot_fraction), min_items_(min_items),
+          width_(Width(hot_fraction, epsilon)), depth_(depth),
+          max_hot_(MaxHot(hot_fraction, epsilon)),
+          counters_(width_ * depth_, 0) {
+        assert(depth_ > 0);
+    }
+
+    //! Number of counters per row, such that the expected overestimate is at
+    //! most epsilon * hot_fraction of all counted keys: ceil(e / (hot_fraction
+    //! * epsilon)).
+    static size_t Width(double hot_fraction, double epsilon) {
+        assert(hot_fraction > 0 && epsilon > 0);
+        return static_cast<size_t>(
+            std::ceil(std::exp(1.0) / (hot_fraction * epsilon)));
+    }
+
+    //! Maximum number of hot keys: as estimates exceed true counts by less
+    //! than epsilon * hot_fraction, only keys with at least (1 - epsilon) *
+    //! hot_fraction of all counted keys are hot, and there are few of them.
+    static size_t MaxHot(double hot_fraction, double epsilon) {
+        assert(hot_fraction > 0 && epsilon < 1);
+        return static_cast<size_t>(
+            std::ceil(1.0 / ((1.0 - epsilon) * hot_fraction)));
+    }
+
+    //! Count an occurrence of a key hash, returns true if the key is hot.
+    bool Insert(const uint64_t& hash) {
+        ++num_items_;
+
+        // conservative update: increment only the minimal counters, which
+        // reduces the overestimation of Count-Min.
+        size_t estimate = Estimate(hash);
+        for (size_t r = 0; r < depth_; ++r) {
+            size_t& c = counters_[Cell(r, hash)];
+            if (c == estimate) ++c;
+        }
+        ++estimate;
+
+        if (num_items_ < min_items_ ||
+            static_cast<double>(estimate)
+            < hot_fraction_ * static_cast<double>(num_items_))
+            return IsHot(hash);
+
+        HotSet::iterator it = std::lower_bound(hot_.begin(), hot_.end(), hash);
+        if (it == hot_.end() || *it != hash) {
+            if (hot_.size() >= max_hot_) return false;
+            hot_.insert(it, hash);
+        }
+        return true;
+    }
+
+    //! Estimated number of occurrences of a key hash.
+    size_t Estimate(const uint64_t& hash) const {
+        size_t estimate = counters_[Cell(0, hash)];
+        for (size_t r = 1; r < depth_; ++r)
+            estimate = std::min(estimate, counters_[Cell(r, hash)]);
+        return estimate;
+    }
+
+    //! Returns true if the key hash was found hot.
+    bool IsHot(const uint64_t& hash) const {
+        return !hot_.empty() &&
+               std::binary_search(hot_.begin(), hot_.end(), hash);
+    }
+
+    //! Returns the sorted hashes of the hot keys.
+    const HotSet& hot() const { return hot_; }
+
+    //! Replace the hot keys, e.g. by the union of those of all workers.
+    void set_hot(const HotSet& hot) {
+        assert(std::is_sorted(hot.begin(), hot.end()));
+        hot_ = hot;
+    }
+
+    //! Returns the number of counted keys.
+    size_t num_items() const { return num_items_; }
+
+    //! Returns the maximum number of locally hot keys.
+    size_t max_hot() const { return max_hot_; }
+
+    //! Merge two sorted hot sets, usable as sum operation of an AllReduce.
+    static HotSet Union(const HotSet& a, const HotSet& b) {
+        HotSet out;
+        out.reserve(a.size() + b.size());
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                       std::back_inserter(out));
+        return out;
+    }
+
+private:
+    //! fraction of all counted keys above which a key is hot
+    double hot_fraction_;
+
+    //! minimum number of counted keys before keys are classified hot
+    size_t min_items_;
+
+    //! number of counters per row
+    size_t width_;
+
+    //! number of rows, each with an independent hash function
+    size_t depth_;
+
+    //! maximum number of keys in hot_
+    size_t max_hot_;
+
+    //! depth_ rows of width_ counters
+    std::vector<size_t> counters_;
+
+    //! number of counted keys
+    size_t num_items_ = 0;
+
+    //! hashes of the hot keys
+    HotSet hot_;
+
+    //! index of the counter of a key hash in row r
+    size_t Cell(size_t r, const uint64_t& hash) const {
+        return r * width_ + Hash128to64(r, hash) % width_;
+    }
+};
+
+} // namespace core
+} // namespace thrill
+
+#endif // !THRILL_CORE_HOT_KEY_SKETCH_HEADER
+
+/******************************************************************************/
@@ -0,0 +1,232 @@
+/*******************************************************************************
+ * thrill/core/parallel_multiway_merge.hpp
+ *
+ * Parallel multiway merge of sorted Files: the runs are split into disjoint key
+ * ranges by a sample-based multi-sequence selection, and the ranges are merged
+ * concurrently into separate output Files.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_CORE_PARALLEL_MULTIWAY_MERGE_HEADER
+#define THRILL_CORE_PARALLEL_MULTIWAY_MERGE_HEADER
+
+#include <thrill/common/logger.hpp>
+#include <thrill/common/thread_pool.hpp>
+#include <thrill/core/multiway_merge.hpp>
+#include <thrill/data/file.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace thrill {
+namespace core {
+
+/*!
+ * Calculate the split positions of sorted Files [files_begin,files_end) into
+ * num_parts disjoint key ranges of approximately equal size. Returns a matrix
+ * split[f][j] containing the index of the first item of File f belonging to
+ * part j, with split[f][0] = 0 and split[f][num_parts] = num_items.
+ *
+ * Splitters are selected from a weighted sample of oversample * num_parts
+ * equidistant items from each File. For each splitter the split position in a
+ * File is the first item not less than the splitter, hence equal items are
+ * never separated into different parts.
+ */
+template <typename ValueType, typename FileIterator, typename Comparator>
+std::vector<std::vector<size_t> > multisequence_partition(
+    FileIterator files_begin, FileIterator files_end,
+    size_t num_parts, const Comparator& comp, size_t oversample = 16) {
+
+    const size_t num_files = files_end - files_begin;
+
+    // draw weighted sample from all Files
+    std::vector<std::pair<ValueType, size_t> > samples;
+    size_t total_items = 0;
+
+    for (FileIterator f = files_begin; f != files_end; ++f) {
+        const size_t n = f->num_items();
+        const size_t s = std::min(n, oversample * num_parts);
+        total_items += n;
+        for (size_t i = 0; i < s; ++i) {
+            samples.emplace_back(
+                f->template GetItemAt<ValueType>(i * n / s), n / s);
+        }
+    }
+
+    std::sort(samples.begin(), samples.end(),
+              [&comp](const std::pair<ValueType, size_t>& a,
+                      const std::pair<ValueType, size_t>& b) {
+                  return comp(a.first, b.first);
+              });
+
+    // select num_parts - 1 splitters at equidistant weight ranks
+    std::vector<ValueType> splitters;
+    size_t weight = 0, next_part = 1;
+    for (size_t i = 0; i < samples.size() && next_part < num_parts; ++i) {
+        weight += samples[i].second;
+        while (next_part < num_parts &&
+               weight >= next_part * total_items / num_parts) {
+            splitters.emplace_back(samples[i].first);
+            ++next_part;
+        }
+    }
+    std::vector<std::vector<size_t> > split(
+        num_files, std::vector<size_t>(num_parts + 1));
+
+    // binary search for splitters in each File
+    size_t fi = 0;
+    for (FileIterator f = files_begin; f != files_end; ++f, ++fi) {
+        const size_t n = f->num_items();
+        size_t left = 0;
+        split[fi][0] = 0;
+        for (size_t j = 0; j < splitters.size(); ++j) {
+            size_t lo = left, hi = n;
+            while (lo < hi) {
+                size_t mid = (lo + hi) / 2;
+                if (comp(f->template GetItemAt<ValueType>(mid), splitters[j]))
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            split[fi][j + 1] = left = lo;
+        }
+        // pad with empty parts if there were too few samples
+        for (size_t j = splitters.size() + 1; j <= num_parts; ++j)
+            split[fi][j] = n;
+    }
+
+    return split;
+}
+
+/*!
+ * Calculate the number of parts for parallel_multiway_merge() given the number
+ * of threads, the number of Files to merge and their total size in bytes, the
+ * memory budget, and the prefetch degree per File. Unlike a streaming merge,
+ * the parallel merge materializes its whole output, hence the input must fit
+ * into the budget together with the prefetched Blocks of all parts. Returns 1
+ * if a parallel merge is not possible.
+ */
+static inline
+size_t parallel_merge_degree(size_t num_threads, size_t num_files,
+                             size_t total_bytes, size_t mem_limit,
+                             size_t prefetch) {
+    if (num_threads <= 1 || total_bytes >= mem_limit) return 1;
+
+    const size_t avail_blocks =
+        (mem_limit - total_bytes) / data::default_block_size;
+    const size_t blocks_per_part = num_files * (prefetch + 1) + 1;
+    return std::max<size_t>(
+        1, std::min(num_threads, avail_blocks / blocks_per_part));
+}
+
+/*!
+ * Merge the sorted Files [files_begin,files_end) into one sorted File using
+ * num_parts threads. The items are split into num_parts disjoint key ranges,
+ * each of which is merged by one thread with a MultiwayMergeTree into a
+ * separate File, and the Blocks of these are finally concatenated. Each thread
+ * reads from each input File with the given prefetch degree, hence about
+ * num_parts * (num_files * (prefetch + 1) + 1) Blocks are required.
+ *
+ * The input Files are cleared after their Blocks were handed to the parts,
+ * which consume them while merging. Hence each input Block is released as soon
+ * as all parts sharing it passed it, and the merge never holds much more than
+ * the size of the input. New Files are created using file_factory, which is
+ * only called from the calling thread.
+ */
+template <typename ValueType, typename FileIterator, typename Comparator,
+          typename FileFactory>
+data::File parallel_multiway_merge(
+    FileIterator files_begin, FileIterator files_end,
+    size_t num_parts, size_t prefetch, const Comparator& comp,
+    const FileFactory& file_factory) {
+
+    static constexpr bool debug = false;
+
+    const size_t num_files = files_end - files_begin;
+    assert(num_parts >= 1);
+
+    std::vector<std::vector<size_t> > split =
+        multisequence_partition<ValueType>(
+            files_begin, files_end, num_parts, comp);
+
+    // construct Files referencing the item ranges of each part
+    std::vector<std::vector<data::File> > parts(num_parts);
+    std::vector<data::File> out;
+    out.reserve(num_parts);
+
+    for (size_t j = 0; j < num_parts; ++j) {
+        size_t fi = 0;
+        for (FileIterator f = files_begin; f != files_end; ++f, ++fi) {
+            size_t begin = split[fi][j], end = split[fi][j + 1];
+            if (begin == end) continue;
+
+            parts[j].emplace_back(file_factory());
+            for (const data::Block& b :
+                 f->template GetItemRange<ValueType>(begin, end)) {
+                parts[j].back().AppendBlock(b);
+            }
+        }
+        out.emplace_back(file_factory());
+
+        sLOG << "parallel_multiway_merge() part" << j
+             << "from" << parts[j].size() << "of" << num_files << "files";
+    }
+
+    // the parts hold the only references to the input Blocks now
+    for (FileIterator f = files_begin; f != files_end; ++f)
+        f->Clear();
+
+    common::ThreadPool pool(num_parts);
+
+    for (size_t j = 0; j < num_parts; ++j) {
+        if (parts[j].size() == 0) continue;
+
+        pool.Enqueue(
+            [&parts, &out, &comp, j, prefetch]() {
+                std::vector<data::File::ConsumeReader> seq;
+                seq.reserve(parts[j].size());
+
+                for (data::File& file : parts[j])
+                    seq.emplace_back(file.GetConsumeReader(0));
+
+                data::StartPrefetch(seq, prefetch);
+
+                auto puller = make_multiway_merge_tree<ValueType>(
+                    seq.begin(), seq.end(), comp);
+
+                auto writer = out[j].GetWriter();
+                while (puller.HasNext()) {
+                    writer.Put(puller.Next());
+                }
+                writer.Close();
+
+                // release references to the part files.
+                seq.clear();
+                parts[j].clear();
+            });
+    }
+    pool.LoopUntilEmpty();
+
+    // concatenate the sorted key ranges
+    data::File result = file_factory();
+    for (data::File& file : out) {
+        for (const data::Block& b : file.blocks())
+            result.AppendBlock(b);
+    }
+
+    return result;
+}
+
+} // namespace core
+} // namespace thrill
+
+#endif // !THRILL_CORE_PARALLEL_MULTIWAY_MERGE_HEADER
+
+/******************************************************************************/
@@ -18,10 +18,12 @@
 
 #include <thrill/api/context.hpp>
 #include <thrill/common/logger.hpp>
+#include <thrill/common/thread_pool.hpp>
 #include <thrill/core/reduce_bucket_hash_table.hpp>
 #include <thrill/core/reduce_functional.hpp>
 #include <thrill/core/reduce_old_probing_hash_table.hpp>
 #include <thrill/core/reduce_probing_hash_table.hpp>
+#include <thrill/core/reduce_swiss_probing_hash_table.hpp>
 #include <thrill/data/file.hpp>
 
 #include <algorithm>
@@ -29,6 +31,7 @@
 #include <cmath>
 #include <functional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -74,7 +77,7 @@ public:
           emitter_(emit),
           table_(ctx, dia_id,
                  key_extractor, reduce_function, emitter_,
-                 /* num_partitions */ 32, /* TODO(tb): parameterize */
+                 size_t(ReduceConfig::post_min_partitions_),
                  config, /* immediate_flush */ false,
                  index_function, key_equal_function) { }
 
@@ -84,9 +87,21 @@ public:
     ReduceByHashPostPhase& operator = (const ReduceByHashPostPhase&) = delete;
 
     void Initialize(size_t limit_memory_bytes) {
+        table_.set_num_partitions(num_partitions(limit_memory_bytes));
         table_.Initialize(limit_memory_bytes);
     }
 
+    //! Calculate the number of partitions of a table with the given memory
+    //! limit such that each partition can hold a minimum number of items.
+    static size_t num_partitions(size_t limit_memory_bytes) {
+        return std::max(
+            size_t(ReduceConfig::post_min_partitions_),
+            std::min(
+                size_t(ReduceConfig::post_max_partitions_),
+                limit_memory_bytes / sizeof(TableItem)
+                / ReduceConfig::post_min_items_per_partition_));
+    }
+
     void Insert(const TableItem& kv) {
         return table_.Insert(kv);
     }
@@ -146,7 +161,81 @@ public:
         assert(consume && "Items were spilled hence Flushing must consume");
 
         // if partially reduce files remain, create new hash tables to process
-        // them iteratively.
+        // them iteratively. independent files are re-reduced by helper threads
+        // into separate Files, which are emitted in order afterwards.
+
+        size_t num_threads = std::min(
+            remaining_files.size(),
+            ReduceConfig::post_flush_threads_ != 0
+            ? size_t(ReduceConfig::post_flush_threads_)
+            : std::max<size_t>(
+                1, std::thread::hardware_concurrency()
+                / table_.ctx().workers_per_host()));
+
+        auto emit =
+            [this, writer](const size_t& partition_id, const TableItem& p) {
+                if (DoCache) writer->Put(p);
+                emitter_.Emit(partition_id, p);
+            };
+
+        if (num_threads <= 1) {
+            ReduceRemainingFiles(
+                remaining_files, table_.limit_memory_bytes(), emit);
+            LOG << "Flushed items";
+            return;
+        }
+
+        sLOG << "ReducePostPhase: re-reducing" << remaining_files.size()
+             << "spilled files with" << num_threads << "threads";
+
+        std::vector<data::File> outputs;
+        for (size_t i = 0; i < remaining_files.size(); ++i)
+            outputs.emplace_back(table_.ctx().GetFile(table_.dia_id()));
+
+        const size_t limit_memory_bytes =
+            table_.limit_memory_bytes() / num_threads;
+
+        common::ThreadPool pool(num_threads);
+
+        for (size_t i = 0; i < remaining_files.size(); ++i) {
+            pool.Enqueue(
+                [this, &remaining_files, &outputs, i, limit_memory_bytes]() {
+                    std::vector<data::File> files;
+                    files.emplace_back(std::move(remaining_files[i]));
+
+                    data::File::Writer out = outputs[i].GetWriter();
+                    ReduceRemainingFiles(
+                        files, limit_memory_bytes,
+                        [&out](const size_t& /* partition_id */,
+                               const TableItem& p) {
+                            out.Put(p);
+                        });
+                    out.Close();
+                });
+        }
+        pool.LoopUntilEmpty();
+
+        for (data::File& file : outputs) {
+            data::File::ConsumeReader reader = file.GetConsumeReader();
+            while (reader.HasNext()) {
+                TableItem p = reader.Next<TableItem>();
+                if (DoCache) writer->Put(p);
+                emitter_.Emit(p);
+            }
+        }
+
+        LOG << "Flushed items";
+    }
+
+    /*!
+     * Re-reduce partially reduced files iteratively using new hash tables
+     * limited to limit_memory_bytes, and emit fully reduced items to emit.
+     * Items spilled again are processed in the next iteration with a different
+     * hash salt.
+     */
+    template <typename Emit>
+    void ReduceRemainingFiles(std::vector<data::File>& remaining_files,
+                              size_t limit_memory_bytes, const Emit& emit) {
 
         size_t iteration = 1;
 
@@ -162,11 +251,12 @@ public:
             Table subtable(
                 table_.ctx(), table_.dia_id(),
                 table_.key_extractor(), table_.reduce_function(), emitter_,
-                /* num_partitions */ 32, config_, /* immediate_flush */ false,
+                num_partitions(limit_memory_bytes), config_,
+                /* immediate_flush */ false,
                 IndexFunction(iteration, table_.index_function()),
                 table_.key_equal_function());
 
-            subtable.Initialize(table_.limit_memory_bytes());
+            subtable.Initialize(limit_memory_bytes);
 
             size_t num_subfile = 0;
 
@@ -207,12 +297,7 @@ public:
                              << "fully reduced items";
 
                         subtable.FlushPartitionEmit(
-                            id, /* consume */ true, /* grow */ false,
-                            [this, writer](
-                                const size_t& partition_id, const TableItem& p) {
-                                if (DoCache) writer->Put(p);
-                                emitter_.Emit(partition_id, p);
-                            });
+                            id, /* consume */ true, /* grow */ false, emit);
                     }
                 }
             }
@@ -220,8 +305,6 @@ public:
             remaining_files = std::move(next_remaining_files);
             ++iteration;
         }
-
-        LOG << "Flushed items";
     }
 
     //! Push data into emitter
@@ -48,8 +48,14 @@ public:
     using PhaseEmitter = ReducePostPhaseEmitter<
               TableItem, Value, Emitter, VolatileKey>;
 
+    //! the SWISS_PROBING table does not emit items in order of their index,
+    //! which is required to fill holes, hence it is replaced by PROBING.
+    static constexpr ReduceTableImpl table_impl_ =
+        ReduceConfig::table_impl_ == ReduceTableImpl::SWISS_PROBING
+        ? ReduceTableImpl::PROBING : ReduceConfig::table_impl_;
+
     using Table = typename ReduceTableSelect<
-              ReduceConfig::table_impl_,
+              table_impl_,
               TableItem, Key, Value,
               KeyExtractor, ReduceFunction, PhaseEmitter,
               VolatileKey, ReduceConfig,
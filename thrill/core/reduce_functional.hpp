@@ -88,6 +88,42 @@ private:
     HashFunction hash_function_;
 };
 
+/*!
+ * A reduce index function for the second stage of host-level combining in
+ * ReduceByKey. All items reaching it were partitioned among stride combining
+ * workers by ReduceByHash, hence they have the same ReduceByHash partition
+ * modulo stride. It returns the ReduceByHash partition among num_partitions *
+ * stride partitions divided by stride, which is the host of the worker
+ * receiving the item without combining.
+ */
+template <typename Key, typename HashFunction = std::hash<Key> >
+class ReduceByHashStrided
+{
+public:
+    using IndexFunction = ReduceByHash<Key, HashFunction>;
+    using Result = typename IndexFunction::Result;
+
+    ReduceByHashStrided(const IndexFunction& index_function, size_t stride)
+        : index_function_(index_function), stride_(stride) { }
+
+    Result operator () (
+        const Key& k,
+        const size_t& num_partitions,
+        const size_t& num_buckets_per_partition,
+        const size_t& num_buckets_per_table) const {
+
+        Result r = index_function_(
+            k, num_partitions * stride_,
+            num_buckets_per_partition, num_buckets_per_table);
+        r.partition_id /= stride_;
+        return r;
+    }
+
+private:
+    IndexFunction index_function_;
+    size_t stride_;
+};
+
 /*!
  * A reduce index function, which determines a bucket depending on the current
  * index range [begin,end). It is used by ReduceToIndex.
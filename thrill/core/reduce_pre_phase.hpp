@@ -16,12 +16,17 @@
 #ifndef THRILL_CORE_REDUCE_PRE_PHASE_HEADER
 #define THRILL_CORE_REDUCE_PRE_PHASE_HEADER
 
+#include <thrill/common/defines.hpp>
+#include <thrill/common/delegate.hpp>
+#include <thrill/common/item_serialization_tools.hpp>
 #include <thrill/common/logger.hpp>
 #include <thrill/core/reduce_bucket_hash_table.hpp>
 #include <thrill/core/reduce_functional.hpp>
 #include <thrill/core/reduce_old_probing_hash_table.hpp>
 #include <thrill/core/reduce_probing_hash_table.hpp>
+#include <thrill/core/reduce_swiss_probing_hash_table.hpp>
 #include <thrill/data/block_writer.hpp>
+#include <thrill/data/serialization.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -43,6 +48,10 @@ class ReducePrePhaseEmitter
     static constexpr bool debug = false;
 
 public:
+    //! function selecting the partition an item is sent to, given the item and
+    //! the partition of its key.
+    using Router = common::Delegate<size_t(const size_t&, const TableItem&)>;
+
     explicit ReducePrePhaseEmitter(std::vector<data::DynBlockWriter>& writer)
         : writer_(writer),
           stats_(writer.size(), 0) { }
@@ -51,8 +60,20 @@ public:
     //! non-robust keys
     void Emit(const size_t& partition_id, const TableItem& p) {
         assert(partition_id < writer_.size());
-        stats_[partition_id]++;
-        writer_[partition_id].Put(p);
+        size_t target = partition_id;
+        if (THRILL_UNLIKELY(routed_)) {
+            target = router_(partition_id, p);
+            assert(target < writer_.size());
+        }
+        stats_[target]++;
+        writer_[target].Put(p);
+    }
+
+    //! Install a Router, which may send items to other partitions than those
+    //! of their keys, e.g. to spread hot keys over several workers.
+    void set_router(const Router& router) {
+        router_ = router;
+        routed_ = true;
     }
 
     void Flush(size_t partition_id) {
@@ -60,6 +81,13 @@ public:
         writer_[partition_id].Flush();
     }
 
+    //! Returns the total number of items emitted to all partitions.
+    size_t num_emitted() const {
+        size_t total = 0;
+        for (const size_t& s : stats_) total += s;
+        return total;
+    }
+
     void CloseAll() {
         sLOG << "emit stats:";
         size_t i = 0;
@@ -75,6 +103,41 @@ public:
 
     //! Emitter stats.
     std::vector<size_t> stats_;
+
+    //! optional Router of the items
+    Router router_;
+
+    //! whether router_ is set
+    bool routed_ = false;
+};
+
+//! Archive which only counts the bytes of serialized items, used to measure
+//! the size of items sent over the network without writing them twice.
+class ReduceByteCounter
+    : public common::ItemWriterToolsBase<ReduceByteCounter>
+{
+public:
+    ReduceByteCounter& PutByte(uint8_t /* data */) {
+        ++size_;
+        return *this;
+    }
+
+    ReduceByteCounter& Append(const void* /* data */, size_t size) {
+        size_ += size;
+        return *this;
+    }
+
+    template <typename Type>
+    ReduceByteCounter& PutRaw(const Type& /* item */) {
+        size_ += sizeof(Type);
+        return *this;
+    }
+
+    //! number of bytes counted
+    size_t size() const { return size_; }
+
+private:
+    size_t size_ = 0;
 };
 
 template <typename TableItem, typename Key, typename Value,
@@ -111,7 +174,8 @@ public:
                    const ReduceConfig& config = ReduceConfig(),
                    const IndexFunction& index_function = IndexFunction(),
                    const KeyEqualFunction& key_equal_function = KeyEqualFunction())
-        : emit_(emit),
+        : config_(config),
+          emit_(emit),
           table_(ctx, dia_id,
                  key_extractor, reduce_function, emit_,
                  num_partitions, config, /* immediate_flush */ true,
@@ -132,7 +196,19 @@ public:
 
     void Insert(const Value& v) {
         // for VolatileKey this makes std::pair and extracts the key
-        return table_.Insert(MakeTableItem::Make(v, table_.key_extractor()));
+        return InsertItem(MakeTableItem::Make(v, table_.key_extractor()));
+    }
+
+    //! Insert a TableItem, e.g. a pre-reduced item received from another
+    //! worker for combining.
+    void InsertItem(const TableItem& kv) {
+        if (THRILL_UNLIKELY(bypass_))
+            return EmitBypass(kv);
+
+        table_.Insert(kv);
+
+        if (THRILL_UNLIKELY(++num_inserted_ == next_bypass_check_))
+            CheckBypass();
     }
 
     //! Flush all partitions
@@ -151,6 +227,11 @@ public:
         emit_.Flush(partition_id);
     }
 
+    //! Install a Router into the Emitter, see ReducePrePhaseEmitter.
+    void set_router(const typename Emitter::Router& router) {
+        emit_.set_router(router);
+    }
+
     //! Closes all emitter
     void CloseAll() {
         emit_.CloseAll();
@@ -163,6 +244,27 @@ public:
     //! Returns the total num of items in the table.
     size_t num_items() const { return table_.num_items(); }
 
+    //! Returns whether the hash table is bypassed
+    bool bypass() const { return bypass_; }
+
+    //! Returns the number of items inserted into the hash table before
+    //! switching to the bypass, or all inserted items if not bypassed.
+    size_t num_inserted() const { return num_inserted_; }
+
+    //! Returns the number of items passed directly to the emitters.
+    size_t num_bypassed() const { return num_bypassed_; }
+
+    //! Returns the serialized size of the items passed directly to the
+    //! emitters.
+    size_t bypassed_bytes() const {
+        if (ByteSerialization::is_fixed_size)
+            return num_bypassed_ * ByteSerialization::fixed_size;
+        return bypassed_bytes_.size();
+    }
+
+    //! Returns the number of items emitted to all partitions.
+    size_t num_emitted() const { return emit_.num_emitted(); }
+
     //! calculate key range for the given output partition
     common::Range key_range(size_t partition_id)
     { return table_.key_range(partition_id); }
@@ -170,11 +272,72 @@ public:
     //! \}
 
 private:
+    //! Config of the pre-phase and hash table
+    ReduceConfig config_;
+
     //! Emitters used to parameterize hash table for output to network.
     Emitter emit_;
 
     //! the first-level hash table implementation
     Table table_;
+
+    //! whether items are passed directly to the emitters
+    bool bypass_ = false;
+
+    //! number of items inserted into the hash table
+    size_t num_inserted_ = 0;
+
+    //! number of items passed directly to the emitters
+    size_t num_bypassed_ = 0;
+
+    //! serialization of items into the byte counter
+    using ByteSerialization = data::Serialization<ReduceByteCounter, TableItem>;
+
+    //! counts the serialized size of variable size bypassed items
+    ReduceByteCounter bypassed_bytes_;
+
+    //! number of inserted items at which to check the reduction rate next
+    size_t next_bypass_check_ = ReduceConfig::bypass_check_items_;
+
+    //! Check the reduction rate achieved by the hash table, and if it is below
+    //! the threshold, flush the table and switch to the bypass. The rate is
+    //! only checked once the table has started flushing items, since before
+    //! that all items are still held for reduction.
+    void CheckBypass() {
+        next_bypass_check_ += ReduceConfig::bypass_check_items_;
+
+        size_t num_emitted = emit_.num_emitted();
+        if (num_emitted == 0) return;
+
+        double rate =
+            1.0 - static_cast<double>(num_emitted + table_.num_items())
+            / static_cast<double>(num_inserted_);
+
+        sLOG << "ReducePrePhase: reduction rate" << rate
+             << "after" << num_inserted_ << "items";
+
+        if (rate >= config_.bypass_reduction_rate()) return;
+
+        sLOG << "ReducePrePhase: switching to bypass after"
+             << num_inserted_ << "items";
+
+        FlushAll();
+        bypass_ = true;
+    }
+
+    //! Emit an item directly into its partition's emitter.
+    void EmitBypass(const TableItem& kv) {
+        typename IndexFunction::Result h = table_.index_function()(
+            MakeTableItem::GetKey(kv, table_.key_extractor()),
+            table_.num_partitions(),
+            table_.num_buckets_per_partition(), table_.num_buckets());
+
+        emit_.Emit(h.partition_id, kv);
+        ++num_bypassed_;
+
+        if (!ByteSerialization::is_fixed_size)
+            ByteSerialization::Serialize(kv, bypassed_bytes_);
+    }
 };
 
 } // namespace core
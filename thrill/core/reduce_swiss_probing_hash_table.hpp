@@ -0,0 +1,462 @@
+/*******************************************************************************
+ * thrill/core/reduce_swiss_probing_hash_table.hpp
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_CORE_REDUCE_SWISS_PROBING_HASH_TABLE_HEADER
+#define THRILL_CORE_REDUCE_SWISS_PROBING_HASH_TABLE_HEADER
+
+#include <thrill/common/math.hpp>
+#include <thrill/core/reduce_functional.hpp>
+#include <thrill/core/reduce_table.hpp>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace thrill {
+namespace core {
+
+/*!
+ * A reduce hash table with open addressing in the style of Swiss tables: a
+ * separate array of one control byte per slot contains either an empty marker
+ * or a 7-bit tag derived from the key's hash. The slots are probed in groups of
+ * 16 by comparing all control bytes of a group with the tag at once using SSE2
+ * instructions, and only slots with matching tags are compared by key. The
+ * items are stored in a separate array, which is only accessed for candidate
+ * slots, hence most probes touch only the small control byte array.
+ *
+ * The table is split into partitions like ReduceProbingHashTable. Each
+ * partition probes group-wise starting at the group containing the item's
+ * local index, wrapping around at the end of the partition. As items are never
+ * removed individually, no tombstones are needed: a group containing an empty
+ * slot terminates the probe sequence.
+ *
+ * Contrary to ReduceProbingHashTable, no sentinel key is reserved, since empty
+ * slots are marked in the control bytes. The items within a partition are not
+ * stored in order of their local index, hence this table is not suitable for
+ * the ReduceToIndex post-phase.
+ */
+template <typename TableItem, typename Key, typename Value,
+          typename KeyExtractor, typename ReduceFunction, typename Emitter,
+          const bool VolatileKey,
+          typename ReduceConfig_,
+          typename IndexFunction,
+          typename KeyEqualFunction = std::equal_to<Key> >
+class ReduceSwissProbingHashTable
+    : public ReduceTable<TableItem, Key, Value,
+                         KeyExtractor, ReduceFunction, Emitter,
+                         VolatileKey, ReduceConfig_,
+                         IndexFunction, KeyEqualFunction>
+{
+    using Super = ReduceTable<TableItem, Key, Value,
+                              KeyExtractor, ReduceFunction, Emitter,
+                              VolatileKey, ReduceConfig_, IndexFunction,
+                              KeyEqualFunction>;
+    using Super::debug;
+
+    //! number of slots probed at once
+    static constexpr size_t group_size_ = 16;
+
+    //! control byte of an empty slot, full slots contain a 7-bit tag
+    static constexpr uint8_t ctrl_empty_ = 0x80;
+
+public:
+    using ReduceConfig = ReduceConfig_;
+
+    ReduceSwissProbingHashTable(
+        Context& ctx, size_t dia_id,
+        const KeyExtractor& key_extractor,
+        const ReduceFunction& reduce_function,
+        Emitter& emitter,
+        size_t num_partitions,
+        const ReduceConfig& config = ReduceConfig(),
+        bool immediate_flush = false,
+        const IndexFunction& index_function = IndexFunction(),
+        const KeyEqualFunction& key_equal_function = KeyEqualFunction())
+        : Super(ctx, dia_id,
+                key_extractor, reduce_function, emitter,
+                num_partitions, config, immediate_flush,
+                index_function, key_equal_function)
+    { assert(num_partitions > 0); }
+
+    //! Construct the hash table itself and mark all slots as empty.
+    void Initialize(size_t limit_memory_bytes) {
+        assert(!items_);
+
+        limit_memory_bytes_ = limit_memory_bytes;
+
+        // calculate num_buckets_per_partition_ from the memory limit and the
+        // number of partitions required, each slot needs a control byte. the
+        // partition size must be a multiple of the group size.
+
+        num_buckets_per_partition_ = static_cast<size_t>(
+            static_cast<double>(limit_memory_bytes_)
+            / static_cast<double>(sizeof(TableItem) + 1)
+            / static_cast<double>(num_partitions_));
+
+        num_buckets_per_partition_ = std::max(
+            size_t(group_size_),
+            num_buckets_per_partition_ / group_size_ * group_size_);
+
+        num_buckets_ = num_buckets_per_partition_ * num_partitions_;
+
+        partition_size_.resize(
+            num_partitions_,
+            std::min(common::RoundUpToPowerOfTwo(
+                         std::max(
+                             size_t(config_.initial_items_per_partition_),
+                             size_t(group_size_))),
+                     num_buckets_per_partition_));
+
+        // calculate limit on the number of items in a partition before these
+        // are spilled to disk or flushed to network.
+
+        double limit_fill_rate = config_.limit_partition_fill_rate();
+
+        assert(limit_fill_rate >= 0.0 && limit_fill_rate <= 1.0
+               && "limit_partition_fill_rate must be between 0.0 and 1.0. "
+               "with a fill rate of 0.0, items are immediately flushed.");
+
+        limit_items_per_partition_.resize(
+            num_partitions_,
+            static_cast<size_t>(
+                static_cast<double>(partition_size_[0]) * limit_fill_rate));
+
+        // allocate the item array uninitialized and the control bytes.
+
+        items_ = static_cast<TableItem*>(
+            operator new (num_buckets_ * sizeof(TableItem)));
+
+        ctrl_ = new uint8_t[num_buckets_];
+        std::fill(ctrl_, ctrl_ + num_buckets_, uint8_t(ctrl_empty_));
+    }
+
+    ~ReduceSwissProbingHashTable() {
+        if (items_) Dispose();
+    }
+
+    /*!
+     * Inserts a value into the table, potentially reducing it in case both the
+     * key of the value already in the table and the key of the value to be
+     * inserted are the same.
+     *
+     * An insert may trigger a spill of the partition, if the partition's fill
+     * limit is reached or all its slots are occupied.
+     *
+     * \param kv Value to be inserted into the table.
+     */
+    void Insert(const TableItem& kv) {
+
+        while (THRILL_UNLIKELY(mem::memory_exceeded && num_items_ != 0))
+            SpillAnyPartition();
+
+        typename IndexFunction::Result h = index_function_(
+            key(kv), num_partitions_,
+            num_buckets_per_partition_, num_buckets_);
+
+        assert(h.partition_id < num_partitions_);
+
+        const size_t partition_id = h.partition_id;
+        const uint8_t tag = CalculateTag(h);
+
+        uint8_t* pctrl = ctrl_ + partition_id * num_buckets_per_partition_;
+        TableItem* pitems = items_ + partition_id * num_buckets_per_partition_;
+
+        const size_t num_groups = partition_size_[partition_id] / group_size_;
+        size_t group =
+            h.local_index(partition_size_[partition_id]) / group_size_;
+
+        for (size_t probe = 0; probe < num_groups; ++probe)
+        {
+            uint8_t* gctrl = pctrl + group * group_size_;
+            TableItem* gitems = pitems + group * group_size_;
+
+            // compare keys of all slots with matching tag
+            for (unsigned match = MatchGroup(gctrl, tag); match != 0;
+                 match &= match - 1)
+            {
+                TableItem& slot = gitems[common::ffs(match) - 1];
+                if (key_equal_function_(key(slot), key(kv))) {
+                    slot = reduce(slot, kv);
+                    return;
+                }
+            }
+
+            // insert into first empty slot, if the group has one
+            unsigned empty = MatchGroup(gctrl, ctrl_empty_);
+            if (empty != 0) {
+                size_t i = common::ffs(empty) - 1;
+                new (gitems + i)TableItem(kv);
+                gctrl[i] = tag;
+
+                // increase counter for partition
+                ++items_per_partition_[partition_id];
+                ++num_items_;
+
+                while (THRILL_UNLIKELY(
+                           items_per_partition_[partition_id] >=
+                           limit_items_per_partition_[partition_id])) {
+                    LOG << "Spill due to "
+                        << items_per_partition_[partition_id] << " >= "
+                        << limit_items_per_partition_[partition_id]
+                        << " among " << partition_size_[partition_id];
+                    SpillPartition(partition_id);
+                }
+                return;
+            }
+
+            // wrap around if beyond the current partition
+            if (++group == num_groups) group = 0;
+        }
+
+        // flush partition and retry, if all slots are reserved
+        SpillPartition(partition_id);
+        return Insert(kv);
+    }
+
+    //! Deallocate items and memory
+    void Dispose() {
+        if (!items_) return;
+
+        // dispose the items by destructor
+
+        for (size_t id = 0; id < num_partitions_; ++id) {
+            uint8_t* pctrl = ctrl_ + id * num_buckets_per_partition_;
+            TableItem* pitems = items_ + id * num_buckets_per_partition_;
+
+            for (size_t i = 0; i < partition_size_[id]; ++i) {
+                if (pctrl[i] != ctrl_empty_)
+                    pitems[i].~TableItem();
+            }
+        }
+
+        operator delete (items_);
+        items_ = nullptr;
+
+        delete[] ctrl_;
+        ctrl_ = nullptr;
+
+        Super::Dispose();
+    }
+
+    //! Grow a partition after a spill or flush (if possible). Only empty
+    //! partitions are grown, as the items are not rehashed.
+    void GrowPartition(size_t partition_id) {
+
+        if (partition_size_[partition_id] == num_buckets_per_partition_ ||
+            items_per_partition_[partition_id] != 0)
+            return;
+
+        size_t new_size = std::min(
+            num_buckets_per_partition_, 2 * partition_size_[partition_id]);
+
+        sLOG << "Growing partition" << partition_id
+             << "from" << partition_size_[partition_id] << "to" << new_size
+             << "limit_items" << new_size * config_.limit_partition_fill_rate();
+
+        // control bytes of the new slots are already empty
+        partition_size_[partition_id] = new_size;
+        limit_items_per_partition_[partition_id]
+            = new_size * config_.limit_partition_fill_rate();
+    }
+
+    //! \name Spilling Mechanisms to External Memory Files
+    //! \{
+
+    //! Spill all items of a partition into an external memory File.
+    void SpillPartition(size_t partition_id) {
+
+        if (immediate_flush_) {
+            return FlushPartition(
+                partition_id, /* consume */ true, /* grow */ true);
+        }
+
+        LOG << "Spilling " << items_per_partition_[partition_id]
+            << " items of partition with id: " << partition_id;
+
+        if (items_per_partition_[partition_id] == 0)
+            return;
+
+        data::File::Writer writer = partition_files_[partition_id].GetWriter();
+
+        FlushPartitionEmit(
+            partition_id, /* consume */ true, /* grow */ true,
+            [&writer](const size_t& /* partition_id */, const TableItem& p) {
+                writer.Put(p);
+            });
+
+        LOG << "Spilled items of partition with id: " << partition_id;
+    }
+
+    //! Spill all items of an arbitrary partition into an external memory File.
+    void SpillAnyPartition() {
+        return SpillLargestPartition();
+    }
+
+    //! Spill all items of the largest partition into an external memory File.
+    void SpillLargestPartition() {
+        // get partition with max size
+        size_t size_max = 0, index = 0;
+
+        for (size_t i = 0; i < num_partitions_; ++i)
+        {
+            if (items_per_partition_[i] > size_max)
+            {
+                size_max = items_per_partition_[i];
+                index = i;
+            }
+        }
+
+        if (size_max == 0) {
+            return;
+        }
+
+        return SpillPartition(index);
+    }
+
+    //! \}
+
+    //! \name Flushing Mechanisms to Next Stage or Phase
+    //! \{
+
+    template <typename Emit>
+    void FlushPartitionEmit(
+        size_t partition_id, bool consume, bool grow, Emit emit) {
+
+        LOG << "Flushing " << items_per_partition_[partition_id]
+            << " items of partition: " << partition_id;
+
+        uint8_t* pctrl = ctrl_ + partition_id * num_buckets_per_partition_;
+        TableItem* pitems = items_ + partition_id * num_buckets_per_partition_;
+
+        for (size_t i = 0; i < partition_size_[partition_id]; ++i)
+        {
+            if (pctrl[i] == ctrl_empty_) continue;
+
+            emit(partition_id, pitems[i]);
+
+            if (consume) {
+                pitems[i].~TableItem();
+                pctrl[i] = ctrl_empty_;
+            }
+        }
+
+        if (consume) {
+            // reset partition specific counter
+            num_items_ -= items_per_partition_[partition_id];
+            items_per_partition_[partition_id] = 0;
+            assert(num_items_ == this->num_items_calc());
+        }
+
+        LOG << "Done flushed items of partition: " << partition_id;
+
+        if (grow)
+            GrowPartition(partition_id);
+    }
+
+    void FlushPartition(size_t partition_id, bool consume, bool grow) {
+        FlushPartitionEmit(
+            partition_id, consume, grow,
+            [this](const size_t& partition_id, const TableItem& p) {
+                this->emitter_.Emit(partition_id, p);
+            });
+    }
+
+    void FlushAll() {
+        for (size_t i = 0; i < num_partitions_; ++i) {
+            FlushPartition(i, /* consume */ true, /* grow */ false);
+        }
+    }
+
+    //! \}
+
+private:
+    using Super::config_;
+    using Super::immediate_flush_;
+    using Super::index_function_;
+    using Super::items_per_partition_;
+    using Super::key;
+    using Super::key_equal_function_;
+    using Super::limit_memory_bytes_;
+    using Super::num_buckets_;
+    using Super::num_buckets_per_partition_;
+    using Super::num_items_;
+    using Super::num_partitions_;
+    using Super::partition_files_;
+    using Super::reduce;
+
+    //! Storing the items of the hash table, constructed only in full slots.
+    TableItem* items_ = nullptr;
+
+    //! Control bytes of the slots: ctrl_empty_ or a 7-bit tag.
+    uint8_t* ctrl_ = nullptr;
+
+    //! Current sizes of the partitions because the valid allocated areas grow
+    std::vector<size_t> partition_size_;
+
+    //! Current limits on the number of items in a partitions, different for
+    //! different partitions, because the valid allocated areas grow.
+    std::vector<size_t> limit_items_per_partition_;
+
+    //! Calculate the 7-bit tag of a key from bits of the index function result
+    //! which are independent of the local index inside the partition.
+    static uint8_t CalculateTag(const typename IndexFunction::Result& h) {
+        uint64_t x = h.local_index(size_t(1) << 32);
+        return static_cast<uint8_t>((x * 0x9E3779B97F4A7C15ull) >> 57);
+    }
+
+    //! Return bit mask of the slots in the group ctrl[0,group_size_) whose
+    //! control byte equals c.
+    static unsigned MatchGroup(const uint8_t* ctrl, uint8_t c) {
+#if defined(__SSE2__)
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return static_cast<unsigned>(_mm_movemask_epi8(
+                                         _mm_cmpeq_epi8(
+                                             group,
+                                             _mm_set1_epi8(static_cast<char>(c)))));
+#else
+        unsigned mask = 0;
+        for (size_t i = 0; i < group_size_; ++i)
+            mask |= static_cast<unsigned>(ctrl[i] == c) << i;
+        return mask;
+#endif
+    }
+};
+
+template <typename TableItem, typename Key, typename Value,
+          typename KeyExtractor, typename ReduceFunction,
+          typename Emitter, const bool VolatileKey,
+          typename ReduceConfig, typename IndexFunction,
+          typename KeyEqualFunction>
+class ReduceTableSelect<
+        ReduceTableImpl::SWISS_PROBING,
+        TableItem, Key, Value, KeyExtractor, ReduceFunction,
+        Emitter, VolatileKey, ReduceConfig, IndexFunction, KeyEqualFunction>
+{
+public:
+    using type = ReduceSwissProbingHashTable<
+              TableItem, Key, Value, KeyExtractor, ReduceFunction,
+              Emitter, VolatileKey, ReduceConfig,
+              IndexFunction, KeyEqualFunction>;
+};
+
+} // namespace core
+} // namespace thrill
+
+#endif // !THRILL_CORE_REDUCE_SWISS_PROBING_HASH_TABLE_HEADER
+
+/******************************************************************************/
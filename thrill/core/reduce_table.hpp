@@ -27,7 +27,7 @@ namespace core {
 
 //! Enum class to select a hash table implementation.
 enum class ReduceTableImpl {
-    PROBING, OLD_PROBING, BUCKET
+    PROBING, OLD_PROBING, BUCKET, SWISS_PROBING
 };
 
 /*!
@@ -46,6 +46,15 @@ public:
     //! relative to the maximum possible number.
     double bucket_rate_ = 0.6;
 
+    //! only for ReducePrePhase: switch to passing items directly to the
+    //! partition emitters if the hash table reduced fewer than this fraction
+    //! of the inserted items, e.g. 0.1. 0.0 disables the bypass.
+    double bypass_reduction_rate_ = 0.0;
+
+    //! only for ReduceNode with use_skew_split_: a key is hot if it makes up at
+    //! least this fraction of the average number of items per worker.
+    double skew_hot_fraction_ = 0.5;
+
     //! select the hash table in the reduce phase by enum
     static constexpr ReduceTableImpl table_impl_ = ReduceTableImpl::PROBING;
 
@@ -56,6 +65,27 @@ public:
     //! (must be a static constexpr)
     static constexpr size_t bucket_block_size_ = 512;
 
+    //! only for ReducePrePhase: number of items inserted between checks of the
+    //! reduction rate for switching to the bypass.
+    static constexpr size_t bypass_check_items_ = 65536;
+
+    //! only for ReduceByHashPostPhase: minimum number of items fitting into a
+    //! partition, which determines the number of partitions from the memory
+    //! limit and the item size.
+    static constexpr size_t post_min_items_per_partition_ = 65536;
+
+    //! only for ReduceByHashPostPhase: minimum number of partitions. Items
+    //! spilled from a partition are re-reduced in a table which again splits
+    //! them among this many partitions.
+    static constexpr size_t post_min_partitions_ = 32;
+
+    //! only for ReduceByHashPostPhase: maximum number of partitions.
+    static constexpr size_t post_max_partitions_ = 1024;
+
+    //! only for ReduceByHashPostPhase: number of threads re-reducing spilled
+    //! partitions, 0 selects the hardware threads per local worker.
+    static constexpr size_t post_flush_threads_ = 0;
+
     //! use MixStream instead of CatStream in ReduceNodes: this makes the order
     //! of items delivered in the ReduceFunction arbitrary.
     static constexpr bool use_mix_stream_ = true;
@@ -64,6 +94,25 @@ public:
     //! the pre and post phases simultaneously.
     static constexpr bool use_post_thread_ = true;
 
+    //! only for ReduceNode: combine the pre-reduced items of all local workers
+    //! on a host via loopback before the shuffle, such that each key is sent
+    //! at most once per host over the network.
+    static constexpr bool use_host_combine_ = false;
+
+    //! only for ReduceNode: detect hot keys in the pre phase and spread their
+    //! items over all workers, which send their partial results to the key's
+    //! worker for a final combine. Cannot be combined with use_host_combine_.
+    static constexpr bool use_skew_split_ = false;
+
+    //! only for ReduceNode with use_skew_split_: number of items inserted into
+    //! the pre phase before any key is considered hot.
+    static constexpr size_t skew_min_items_ = 4096;
+
+    //! only for ReduceNode with use_skew_split_: error of the Count-Min sketch
+    //! detecting hot keys relative to the hot threshold, which determines the
+    //! width of its rows and the maximum number of hot keys.
+    static constexpr double skew_sketch_error_ = 0.25;
+
     //! \name Accessors
     //! \{
 
@@ -74,6 +123,12 @@ public:
     //! Returns bucket_rate_
     double bucket_rate() const { return bucket_rate_; }
 
+    //! Returns bypass_reduction_rate_
+    double bypass_reduction_rate() const { return bypass_reduction_rate_; }
+
+    //! Returns skew_hot_fraction_
+    double skew_hot_fraction() const { return skew_hot_fraction_; }
+
     //! \}
 };
 
@@ -186,6 +241,22 @@ public:
     //! Returns the number of partitions
     size_t num_partitions() { return num_partitions_; }
 
+    //! Change the number of partitions, only possible before Initialize().
+    void set_num_partitions(size_t num_partitions) {
+        assert(num_partitions > 0);
+        assert(num_items_ == 0);
+
+        num_partitions_ = num_partitions;
+        items_per_partition_.assign(num_partitions_, 0);
+
+        if (!immediate_flush_) {
+            partition_files_.clear();
+            for (size_t i = 0; i < num_partitions_; i++) {
+                partition_files_.push_back(ctx_.GetFile(dia_id_));
+            }
+        }
+    }
+
     //! Returns num_buckets_
     size_t num_buckets() const { return num_buckets_; }
 
@@ -279,7 +350,7 @@ protected:
     //! \{
 
     //! Number of partitions
-    const size_t num_partitions_;
+    size_t num_partitions_;
 
     //! config of reduce table
     ReduceConfig config_;
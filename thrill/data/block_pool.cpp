@@ -10,16 +10,19 @@
 
 #include <thrill/common/die.hpp>
 #include <thrill/common/logger.hpp>
-#include <thrill/common/lru_cache.hpp>
+#include <thrill/common/lz_compress.hpp>
 #include <thrill/common/math.hpp>
+#include <thrill/common/numa.hpp>
 #include <thrill/data/block.hpp>
 #include <thrill/data/block_pool.hpp>
+#include <thrill/data/eviction_policy.hpp>
 #include <thrill/io/file_base.hpp>
 #include <thrill/io/iostats.hpp>
 #include <thrill/mem/aligned_allocator.hpp>
 #include <thrill/mem/pool.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <limits>
 #include <thread>
@@ -43,6 +46,19 @@ static constexpr bool debug_mem = false;
 //! debug block eviction: evict, write complete, read complete
 static constexpr bool debug_em = false;
 
+//! round a size up to the alignment of external memory blocks
+static inline size_t RoundUpToAlign(size_t size) {
+    return common::IntegerDivRoundUp<size_t>(size, THRILL_DEFAULT_ALIGN)
+           * THRILL_DEFAULT_ALIGN;
+}
+
+//! size of the buffer for compressing a block of the given size: compressing
+//! is only worthwhile if it saves at least one aligned page.
+static inline size_t CompressCapacity(size_t size) {
+    size = size / THRILL_DEFAULT_ALIGN * THRILL_DEFAULT_ALIGN;
+    return size > THRILL_DEFAULT_ALIGN ? size - THRILL_DEFAULT_ALIGN : 0;
+}
+
 /******************************************************************************/
 // std::new_handler() which gets called when malloc() returns nullptr
 
@@ -233,6 +249,9 @@ public:
     //! For waiting on hard memory limit
     std::condition_variable cv_memory_change_;
 
+    //! For waiting on blocks being compressed outside of the mutex
+    std::condition_variable cv_compress_complete_;
+
     //! Soft limit for the block pool, blocks will be written to disk if this
     //! limit is reached. 0 for no limit.
     size_t soft_ram_limit_;
@@ -241,9 +260,12 @@ public:
     //! is reached. 0 for no limit.
     size_t hard_ram_limit_;
 
-    //! list of all blocks that are _in_memory_ but are _not_ pinned.
-    common::LruCacheSet<
-        ByteBlock*, mem::GPoolAllocator<ByteBlock*> > unpinned_blocks_;
+    //! Compress ByteBlocks written to external memory.
+    bool compress_swap_;
+
+    //! set of all blocks that are _in_memory_ but are _not_ pinned, which
+    //! selects the next block to evict.
+    std::unique_ptr<EvictionPolicy> unpinned_blocks_;
 
     //! set of ByteBlocks currently begin written to EM.
     WritingMap writing_;
@@ -306,6 +328,58 @@ public:
     //! also additionally reserved memory via BlockPoolMemoryHolder.
     Counter total_ram_bytes_;
 
+    //! number of read-only memory mapped ByteBlocks
+    size_t mapped_blocks_ = 0;
+
+    //! total number of bytes in read-only memory mapped ByteBlocks, which are
+    //! served by the page cache and not counted in total_bytes_.
+    Counter mapped_bytes_;
+
+    //! \name Compression Statistics
+    //! \{
+
+    //! total number of bytes passed to the compressor during eviction
+    size_t compress_in_bytes_ = 0;
+
+    //! total number of compressed bytes written to external memory
+    size_t compress_out_bytes_ = 0;
+
+    //! total microseconds spent in compressing evicted blocks
+    size_t compress_time_ = 0;
+
+    //! total microseconds spent in decompressing blocks read back
+    size_t decompress_time_ = 0;
+
+    //! \}
+
+    //! \name NUMA Sub-Pools
+    //! \{
+
+    //! ByteBlock memory and accesses of the sub-pool of one NUMA node
+    struct NumaPool {
+        //! bytes of ByteBlocks in memory on the node
+        Counter bytes;
+        //! number of pins by workers on the same node
+        size_t  local_pins = 0;
+        //! number of pins by workers on other nodes
+        size_t  remote_pins = 0;
+    };
+
+    //! NUMA topology of the machine
+    const common::NumaTopology& numa_;
+
+    //! whether to bind ByteBlock memory to the node of its sub-pool, disabled
+    //! on single node machines or if binding fails.
+    std::atomic<bool> numa_bind_;
+
+    //! NUMA node of each local worker
+    std::vector<size_t> worker_numa_node_;
+
+    //! sub-pool per NUMA node
+    std::vector<NumaPool> numa_pool_;
+
+    //! \}
+
     //! last time statistics where outputted
     std::chrono::steady_clock::time_point tp_last_
         = std::chrono::steady_clock::now();
@@ -313,12 +387,33 @@ public:
 public:
     Data(BlockPool& block_pool,
          size_t soft_ram_limit, size_t hard_ram_limit,
-         size_t workers_per_host)
+         size_t workers_per_host, bool compress_swap,
+         const std::string& eviction_policy)
         : soft_ram_limit_(soft_ram_limit),
           hard_ram_limit_(hard_ram_limit),
+          compress_swap_(compress_swap),
+          unpinned_blocks_(EvictionPolicy::Make(eviction_policy)),
           bm_(io::BlockManager::GetInstance()),
           aligned_alloc_(mem::Allocator<char>(block_pool.mem_manager_)),
-          pin_count_(workers_per_host) { }
+          pin_count_(workers_per_host),
+          numa_(common::NumaTopology::Machine()),
+          numa_bind_(numa_.num_nodes() > 1),
+          worker_numa_node_(workers_per_host),
+          numa_pool_(numa_.num_nodes()) { }
+
+    //! Allocate memory for a ByteBlock in the sub-pool of a NUMA node. Called
+    //! without holding the mutex.
+    Byte * AllocateOnNode(size_t size, size_t numa_node);
+
+    //! Release the memory of a ByteBlock to its sub-pool.
+    void IntDeallocateBlock(ByteBlock* block_ptr);
+
+    //! Count a pin of a block in memory as local or remote NUMA access.
+    void IntCountNumaPin(ByteBlock* block_ptr, size_t local_worker_id);
+
+    //! move a block to the sub-pool of the NUMA node its pages were actually
+    //! placed on, and count the access of the worker which touched them.
+    void IntMeasureNumaNode(ByteBlock* block_ptr);
 
     //! Updates the memory manager for internal memory. If the hard limit is
     //! reached, the call is blocked intil memory is free'd
@@ -334,11 +429,25 @@ public:
         BlockPool& bp, ByteBlock* block_ptr, size_t local_worker_id);
 
     //! Evict a block from the lru list into external memory
-    io::RequestPtr IntEvictBlockLRU();
+    io::RequestPtr IntEvictBlockLRU(std::unique_lock<std::mutex>& lock);
 
     //! Evict a block into external memory. The block must be unpinned and not
-    //! swapped.
-    io::RequestPtr IntEvictBlock(ByteBlock* block_ptr);
+    //! swapped. The lock may be released temporarily to compress the block.
+    io::RequestPtr IntEvictBlock(
+        std::unique_lock<std::mutex>& lock, ByteBlock* block_ptr);
+
+    //! Compress a block into em_buffer_ prior to writing it to external
+    //! memory, releasing the lock while compressing. The buffer is counted as
+    //! internal memory. Returns false if it is not compressible.
+    bool IntCompressBlock(
+        std::unique_lock<std::mutex>& lock, ByteBlock* block_ptr);
+
+    //! Wait until a block being compressed by another thread is written.
+    void IntWaitCompressBlock(
+        std::unique_lock<std::mutex>& lock, ByteBlock* block_ptr);
+
+    //! Release the buffer of compressed data of a block and its memory.
+    void IntReleaseCompressBuffer(ByteBlock* block_ptr, size_t size);
 
     //! \name Block Statistics
     //! \{
@@ -360,14 +469,19 @@ BlockPool::BlockPool(size_t workers_per_host)
 
 BlockPool::BlockPool(size_t soft_ram_limit, size_t hard_ram_limit,
                      common::JsonLogger* logger, mem::Manager* mem_manager,
-                     size_t workers_per_host)
+                     size_t workers_per_host, bool compress_swap,
+                     const std::string& eviction_policy)
     : logger_(logger),
       mem_manager_(mem_manager, "BlockPool"),
       workers_per_host_(workers_per_host),
       d_(std::make_unique<Data>(
-             *this, soft_ram_limit, hard_ram_limit, workers_per_host)) {
+             *this, soft_ram_limit, hard_ram_limit, workers_per_host,
+             compress_swap, eviction_policy)) {
 
     die_unless(hard_ram_limit >= soft_ram_limit);
+    if (!d_->unpinned_blocks_)
+        die("BlockPool: unknown eviction policy " << eviction_policy);
+    eviction_hints_ = d_->unpinned_blocks_->uses_hints();
     {
         std::unique_lock<std::recursive_mutex> lock(s_new_mutex);
         // register BlockPool as method of OurNewHandler to free memory.
@@ -383,7 +497,21 @@ BlockPool::BlockPool(size_t soft_ram_limit, size_t hard_ram_limit,
     logger_ << "class" << "BlockPool"
             << "event" << "create"
             << "soft_ram_limit" << soft_ram_limit
-            << "hard_ram_limit" << hard_ram_limit;
+            << "hard_ram_limit" << hard_ram_limit
+            << "compress_swap" << compress_swap
+            << "eviction_policy" << eviction_policy;
+}
+
+void BlockPool::SetWorkerNumaNode(size_t local_worker_id, size_t numa_node) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    assert(local_worker_id < workers_per_host_);
+    die_unless(numa_node < d_->numa_pool_.size());
+    d_->worker_numa_node_[local_worker_id] = numa_node;
+}
+
+size_t BlockPool::worker_numa_node(size_t local_worker_id) const {
+    assert(local_worker_id < workers_per_host_);
+    return d_->worker_numa_node_[local_worker_id];
 }
 
 BlockPool::~BlockPool() {
@@ -448,17 +576,25 @@ BlockPool::~BlockPool() {
     d_->pin_count_.AssertZero();
     die_unequal(d_->total_ram_bytes_, 0u);
     die_unequal(d_->total_bytes_, 0u);
-    die_unequal(d_->unpinned_blocks_.size(), 0u);
+    die_unequal(d_->unpinned_blocks_->size(), 0u);
 
     LOGC(debug_pin)
         << "~BlockPool()"
         << " max_pin=" << d_->pin_count_.max_pins
         << " max_pinned_bytes=" << d_->pin_count_.max_pinned_bytes;
 
+    size_t numa_local_pins = 0, numa_remote_pins = 0;
+    for (const Data::NumaPool& p : d_->numa_pool_) {
+        numa_local_pins += p.local_pins;
+        numa_remote_pins += p.remote_pins;
+    }
+
     logger_ << "class" << "BlockPool"
             << "event" << "destroy"
             << "max_pins" << d_->pin_count_.max_pins
-            << "max_pinned_bytes" << d_->pin_count_.max_pinned_bytes;
+            << "max_pinned_bytes" << d_->pin_count_.max_pinned_bytes
+            << "numa_local_pins" << numa_local_pins
+            << "numa_remote_pins" << numa_remote_pins;
 
     std::unique_lock<std::recursive_mutex> s_new_lock(s_new_mutex);
     s_blockpools.erase(
@@ -480,15 +616,19 @@ BlockPool::AllocateByteBlock(size_t size, size_t local_worker_id) {
 
     d_->IntRequestInternalMemory(lock, size);
 
-    // allocate block memory. -- unlock mutex for that time, since it may
-    // require block eviction.
+    // allocate block memory in the worker's NUMA node. -- unlock mutex for that
+    // time, since it may require block eviction.
+    size_t numa_node = d_->worker_numa_node_[local_worker_id];
     lock.unlock();
-    Byte* data = d_->aligned_alloc_.allocate(size);
+    Byte* data = d_->AllocateOnNode(size, numa_node);
     lock.lock();
 
     // create common::CountingPtr, no need for special make_shared()-equivalent
     PinnedByteBlockPtr block_ptr(
         mem::GPool().make<ByteBlock>(this, data, size), local_worker_id);
+    block_ptr->numa_node_ = numa_node;
+    block_ptr->numa_unmeasured_worker_ = local_worker_id;
+    d_->numa_pool_[numa_node].bytes += size;
     ++d_->total_byte_blocks_;
     d_->total_bytes_ += size;
     d_->max_total_bytes_ = std::max(d_->max_total_bytes_, d_->total_bytes_.value);
@@ -527,6 +667,27 @@ ByteBlockPtr BlockPool::MapExternalBlock(
     return block_ptr;
 }
 
+#if THRILL_HAVE_MMAP_FILE
+ByteBlockPtr BlockPool::MapMemoryBlock(
+    const io::MappedRangePtr& mapping, size_t offset, size_t size) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // create common::CountingPtr, no need for special make_shared()-equivalent
+    ByteBlockPtr block_ptr(
+        mem::GPool().make<ByteBlock>(this, mapping, offset, size));
+    ++d_->total_byte_blocks_;
+    ++d_->mapped_blocks_;
+    d_->mapped_bytes_ += size;
+
+    LOGC(debug_blc)
+        << "BlockPool::MapMemoryBlock()"
+        << " ptr=" << block_ptr.get()
+        << " offset=" << offset
+        << " size=" << size;
+
+    return block_ptr;
+}
+#endif
+
 //! Pins a block by swapping it in if required.
 PinRequestPtr BlockPool::PinBlock(const Block& block, size_t local_worker_id) {
     assert(local_worker_id < workers_per_host_);
@@ -534,12 +695,29 @@ PinRequestPtr BlockPool::PinBlock(const Block& block, size_t local_worker_id) {
 
     ByteBlock* block_ptr = block.byte_block().get();
 
+    if (block_ptr->is_mapped()) {
+        // read-only mapped blocks are always accessible, they only count pins
+        // to keep the per-thread invariants.
+        IntIncBlockPinCount(block_ptr, local_worker_id);
+
+        LOGC(debug_pin)
+            << "BlockPool::PinBlock block=" << &block
+            << " pinned from memory mapping";
+
+        return PinRequestPtr(mem::GPool().make<PinRequest>(
+                                 this, PinnedBlock(block, local_worker_id)));
+    }
+
+    // an announced block is now used by the reader
+    if (block_ptr->eviction_hint_ == EvictionHint::Announced)
+        block_ptr->eviction_hint_ = EvictionHint::None;
+
     if (block_ptr->pin_count_[local_worker_id] > 0) {
         // We may get a Block who's underlying is already pinned, since
         // PinnedBlock become Blocks when transfered between Files or delivered
         // via GetItemRange() or Scatter().
 
-        die_unless(!d_->unpinned_blocks_.exists(block_ptr));
+        die_unless(!d_->unpinned_blocks_->exists(block_ptr));
         die_unless(d_->reading_.find(block_ptr) == d_->reading_.end());
 
         LOGC(debug_pin)
@@ -547,6 +725,7 @@ PinRequestPtr BlockPool::PinBlock(const Block& block, size_t local_worker_id) {
             << " already pinned by thread";
 
         IntIncBlockPinCount(block_ptr, local_worker_id);
+        d_->IntCountNumaPin(block_ptr, local_worker_id);
 
         return PinRequestPtr(mem::GPool().make<PinRequest>(
                                  this, PinnedBlock(block, local_worker_id)));
@@ -556,7 +735,7 @@ PinRequestPtr BlockPool::PinBlock(const Block& block, size_t local_worker_id) {
         // This block was already pinned by another thread, hence we only need
         // to get a pin for the new thread.
 
-        die_unless(!d_->unpinned_blocks_.exists(block_ptr));
+        die_unless(!d_->unpinned_blocks_->exists(block_ptr));
         die_unless(d_->reading_.find(block_ptr) == d_->reading_.end());
 
         LOGC(debug_pin)
@@ -565,13 +744,16 @@ PinRequestPtr BlockPool::PinBlock(const Block& block, size_t local_worker_id) {
             << d_->pin_count_;
 
         IntIncBlockPinCount(block_ptr, local_worker_id);
+        d_->IntCountNumaPin(block_ptr, local_worker_id);
         d_->pin_count_.Increment(local_worker_id, block_ptr->size());
 
         return PinRequestPtr(mem::GPool().make<PinRequest>(
                                  this, PinnedBlock(block, local_worker_id)));
     }
 
-    // check that not writing the block.
+    // check that not compressing or writing the block.
+    d_->IntWaitCompressBlock(lock, block_ptr);
+
     WritingMap::iterator write_it;
     while ((write_it = d_->writing_.find(block_ptr)) != d_->writing_.end()) {
 
@@ -619,11 +801,12 @@ PinRequestPtr BlockPool::PinBlock(const Block& block, size_t local_worker_id) {
         // unpinned block in memory, no need to load from EM.
 
         // remove from unpinned list
-        die_unless(d_->unpinned_blocks_.exists(block_ptr));
-        d_->unpinned_blocks_.erase(block_ptr);
+        die_unless(d_->unpinned_blocks_->exists(block_ptr));
+        d_->unpinned_blocks_->erase(block_ptr);
         d_->unpinned_bytes_ -= block_ptr->size();
 
         IntIncBlockPinCount(block_ptr, local_worker_id);
+        d_->IntCountNumaPin(block_ptr, local_worker_id);
         d_->pin_count_.Increment(local_worker_id, block_ptr->size());
 
         LOGC(debug_pin)
@@ -640,8 +823,10 @@ PinRequestPtr BlockPool::PinBlock(const Block& block, size_t local_worker_id) {
     die_unless(block_ptr->em_bid_.storage);
 
     // maybe blocking call until memory is available, this also swaps out other
-    // blocks.
-    d_->IntRequestInternalMemory(lock, block_ptr->size());
+    // blocks. compressed blocks additionally need a buffer to read into.
+    d_->IntRequestInternalMemory(
+        lock, block_ptr->size()
+        + (block_ptr->em_compressed_size_ ? block_ptr->em_bid_.size : 0));
 
     // the requested memory is already counted as a pin.
     d_->pin_count_.Increment(local_worker_id, block_ptr->size());
@@ -653,12 +838,22 @@ PinRequestPtr BlockPool::PinBlock(const Block& block, size_t local_worker_id) {
             this, PinnedBlock(block, local_worker_id), /* ready */ false));
     d_->reading_[block_ptr] = read;
 
-    // allocate block memory.
+    // allocate block memory in the worker's NUMA node, and a buffer to read
+    // compressed data into.
+    size_t numa_node = d_->worker_numa_node_[local_worker_id];
     lock.unlock();
     Byte* data = read->byte_block()->data_ =
-                     d_->aligned_alloc_.allocate(block_ptr->size());
+                     d_->AllocateOnNode(block_ptr->size(), numa_node);
+    if (block_ptr->em_compressed_size_) {
+        data = block_ptr->em_buffer_ =
+                   d_->aligned_alloc_.allocate(block_ptr->em_bid_.size);
+    }
     lock.lock();
 
+    block_ptr->numa_node_ = numa_node;
+    block_ptr->numa_unmeasured_worker_ = local_worker_id;
+    d_->numa_pool_[numa_node].bytes += block_ptr->size();
+
     if (!block_ptr->ext_file_) {
         d_->swapped_.erase(block_ptr);
         d_->swapped_bytes_ -= block_ptr->size();
@@ -673,7 +868,7 @@ PinRequestPtr BlockPool::PinBlock(const Block& block, size_t local_worker_id) {
     read->req_ =
         block_ptr->em_bid_.storage->aread(
             // parameters for the read
-            data, block_ptr->em_bid_.offset, block_ptr->size(),
+            data, block_ptr->em_bid_.offset, block_ptr->em_bid_.size,
             // construct an immediate CompletionHandler callback
             io::CompletionHandler::make<
                 PinRequest, & PinRequest::OnComplete>(*read));
@@ -689,11 +884,28 @@ void PinRequest::OnComplete(io::Request* req, bool success) {
 
 void BlockPool::OnReadComplete(
     PinRequest* read, io::Request* req, bool success) {
-    std::unique_lock<std::mutex> lock(mutex_);
 
     ByteBlock* block_ptr = read->block_.byte_block().get();
     size_t block_size = block_ptr->size();
 
+    // decompress data read from external memory outside of the lock, the
+    // block is not accessed by other threads until the read is ready.
+    size_t decompress_time = 0;
+    if (success && block_ptr->em_compressed_size_) {
+        req->check_error();
+
+        auto t0 = std::chrono::steady_clock::now();
+        die_unless(common::LzDecompress(
+                       block_ptr->em_buffer_,
+                       block_ptr->em_compressed_size_,
+                       block_ptr->data_, block_size));
+        decompress_time =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - t0).count();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
     LOGC(debug_em)
         << "OnReadComplete():"
         << " req " << req << " block " << block_ptr
@@ -712,7 +924,9 @@ void BlockPool::OnReadComplete(
         }
 
         // release memory
-        d_->aligned_alloc_.deallocate(read->byte_block()->data_, block_size);
+        d_->IntDeallocateBlock(block_ptr);
+        if (block_ptr->em_buffer_)
+            d_->IntReleaseCompressBuffer(block_ptr, block_ptr->em_bid_.size);
 
         d_->IntReleaseInternalMemory(block_size);
 
@@ -724,6 +938,12 @@ void BlockPool::OnReadComplete(
     }
     else    // success
     {
+        if (block_ptr->em_compressed_size_) {
+            d_->decompress_time_ += decompress_time;
+            d_->IntReleaseCompressBuffer(block_ptr, block_ptr->em_bid_.size);
+            block_ptr->em_compressed_size_ = 0;
+        }
+
         // set pin on ByteBlock
         IntIncBlockPinCount(block_ptr, read->block_.local_worker_id_);
 
@@ -799,6 +1019,9 @@ void BlockPool::Data::IntUnpinBlock(
     // decrease per-thread total pin count (memory locked by thread)
     die_unless(block_ptr->pin_count(local_worker_id) == 0);
 
+    // read-only mapped blocks are not accounted and cannot be swapped out.
+    if (block_ptr->is_mapped()) return;
+
     pin_count_.Decrement(local_worker_id, block_ptr->size());
 
     if (block_ptr->total_pins_ != 0) {
@@ -808,9 +1031,12 @@ void BlockPool::Data::IntUnpinBlock(
         return;
     }
 
+    // the block's data was written or read, hence its pages are in place.
+    IntMeasureNumaNode(block_ptr);
+
     // if all per-thread pins are zero, allow this Block to be swapped out.
-    die_unless(!unpinned_blocks_.exists(block_ptr));
-    unpinned_blocks_.put(block_ptr);
+    die_unless(!unpinned_blocks_->exists(block_ptr));
+    unpinned_blocks_->put(block_ptr);
     unpinned_bytes_ += block_ptr->size();
 
     LOGC(debug_pin)
@@ -829,14 +1055,15 @@ size_t BlockPool::Data::int_total_blocks() noexcept {
 
     LOG << "BlockPool::total_blocks()"
         << " pinned_blocks_=" << pin_count_.total_pins_
-        << " unpinned_blocks_=" << unpinned_blocks_.size()
+        << " unpinned_blocks_=" << unpinned_blocks_->size()
         << " writing_.size()=" << writing_.size()
         << " swapped_.size()=" << swapped_.size()
-        << " reading_.size()=" << reading_.size();
+        << " reading_.size()=" << reading_.size()
+        << " mapped_blocks_=" << mapped_blocks_;
 
     return pin_count_.total_pins_
-           + unpinned_blocks_.size() + writing_.size()
-           + swapped_.size() + reading_.size();
+           + unpinned_blocks_->size() + writing_.size()
+           + swapped_.size() + reading_.size() + mapped_blocks_;
 }
 
 size_t BlockPool::hard_ram_limit() noexcept {
@@ -854,6 +1081,11 @@ size_t BlockPool::max_total_bytes() noexcept {
     return d_->max_total_bytes_;
 }
 
+size_t BlockPool::mapped_bytes() noexcept {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return d_->mapped_bytes_;
+}
+
 size_t BlockPool::Data::int_total_bytes() noexcept {
     LOG << "BlockPool::total_bytes()"
         << " pinned_bytes_=" << pin_count_.total_pinned_bytes_
@@ -874,7 +1106,7 @@ size_t BlockPool::pinned_blocks() noexcept {
 
 size_t BlockPool::unpinned_blocks() noexcept {
     std::unique_lock<std::mutex> lock(mutex_);
-    return d_->unpinned_blocks_.size();
+    return d_->unpinned_blocks_->size();
 }
 
 size_t BlockPool::writing_blocks() noexcept {
@@ -892,6 +1124,22 @@ size_t BlockPool::reading_blocks() noexcept {
     return d_->reading_.size();
 }
 
+size_t BlockPool::numa_local_pins() noexcept {
+    std::unique_lock<std::mutex> lock(mutex_);
+    size_t pins = 0;
+    for (const Data::NumaPool& p : d_->numa_pool_)
+        pins += p.local_pins;
+    return pins;
+}
+
+size_t BlockPool::numa_remote_pins() noexcept {
+    std::unique_lock<std::mutex> lock(mutex_);
+    size_t pins = 0;
+    for (const Data::NumaPool& p : d_->numa_pool_)
+        pins += p.remote_pins;
+    return pins;
+}
+
 void BlockPool::DestroyBlock(ByteBlock* block_ptr) {
     LOGC(debug_blc)
         << "BlockPool::DestroyBlock() block_ptr=" << block_ptr
@@ -904,7 +1152,31 @@ void BlockPool::DestroyBlock(ByteBlock* block_ptr) {
     // pinned blocks cannot be destroyed since they are always unpinned first
     die_unless(block_ptr->total_pins_ == 0);
 
+    if (block_ptr->is_mapped())
+    {
+        LOGC(debug_blc)
+            << "BlockPool::DestroyBlock() block_ptr=" << block_ptr
+            << " memory mapped block: release reference to mapping.";
+
+        assert(d_->mapped_blocks_ > 0);
+        assert(d_->mapped_bytes_ >= block_ptr->size());
+        --d_->mapped_blocks_;
+        d_->mapped_bytes_ -= block_ptr->size();
+        // the mapping itself is unmapped with the last ByteBlock using it
+
+        assert(d_->total_byte_blocks_ > 0);
+        --d_->total_byte_blocks_;
+        d_->cv_total_byte_blocks_.notify_all();
+        return;
+    }
+
     do {
+        if (block_ptr->em_compressing_) {
+            // block is being compressed for eviction, wait until it is written
+            d_->IntWaitCompressBlock(lock, block_ptr);
+            continue;
+        }
+
         if (block_ptr->in_memory())
         {
             // block was evicted, may still be writing to EM.
@@ -958,13 +1230,12 @@ void BlockPool::DestroyBlock(ByteBlock* block_ptr) {
             << "BlockPool::DestroyBlock() block_ptr=" << block_ptr
             << " external block, in memory: release memory.";
 
-        die_unless(d_->unpinned_blocks_.exists(block_ptr));
-        d_->unpinned_blocks_.erase(block_ptr);
+        die_unless(d_->unpinned_blocks_->exists(block_ptr));
+        d_->unpinned_blocks_->erase(block_ptr);
         d_->unpinned_bytes_ -= block_ptr->size();
 
         // release memory
-        d_->aligned_alloc_.deallocate(block_ptr->data_, block_ptr->size());
-        block_ptr->data_ = nullptr;
+        d_->IntDeallocateBlock(block_ptr);
 
         d_->IntReleaseInternalMemory(block_ptr->size());
     }
@@ -981,13 +1252,12 @@ void BlockPool::DestroyBlock(ByteBlock* block_ptr) {
             << "BlockPool::DestroyBlock() block_ptr=" << block_ptr
             << " unpinned block in memory, remove from list";
 
-        die_unless(d_->unpinned_blocks_.exists(block_ptr));
-        d_->unpinned_blocks_.erase(block_ptr);
+        die_unless(d_->unpinned_blocks_->exists(block_ptr));
+        d_->unpinned_blocks_->erase(block_ptr);
         d_->unpinned_bytes_ -= block_ptr->size();
 
         // release memory
-        d_->aligned_alloc_.deallocate(block_ptr->data_, block_ptr->size());
-        block_ptr->data_ = nullptr;
+        d_->IntDeallocateBlock(block_ptr);
 
         d_->IntReleaseInternalMemory(block_ptr->size());
     }
@@ -1033,15 +1303,15 @@ void BlockPool::Data::IntRequestInternalMemory(
         << " soft_ram_limit_=" << soft_ram_limit_
         << " hard_ram_limit_=" << hard_ram_limit_
         << pin_count_
-        << " unpinned_blocks_.size()=" << unpinned_blocks_.size()
+        << " unpinned_blocks_.size()=" << unpinned_blocks_->size()
         << " swapped_.size()=" << swapped_.size();
 
     while (soft_ram_limit_ != 0 &&
-           unpinned_blocks_.size() &&
+           unpinned_blocks_->size() &&
            total_ram_bytes_ + requested_bytes_ > soft_ram_limit_ + writing_bytes_)
     {
         // evict blocks: schedule async writing which increases writing_bytes_.
-        IntEvictBlockLRU();
+        IntEvictBlockLRU(lock);
     }
 
     // wait up to 60 seconds for other threads to free up memory or pins
@@ -1053,11 +1323,11 @@ void BlockPool::Data::IntRequestInternalMemory(
     while (hard_ram_limit_ != 0 && total_ram_bytes_ + size > hard_ram_limit_)
     {
         while (hard_ram_limit_ != 0 &&
-               unpinned_blocks_.size() &&
+               unpinned_blocks_->size() &&
                total_ram_bytes_ + requested_bytes_ > hard_ram_limit_ + writing_bytes_)
         {
             // evict blocks: schedule async writing which increases writing_bytes_.
-            IntEvictBlockLRU();
+            IntEvictBlockLRU(lock);
         }
 
         cv_memory_change_.wait_for(lock, std::chrono::seconds(1));
@@ -1070,7 +1340,7 @@ void BlockPool::Data::IntRequestInternalMemory(
             << " soft_ram_limit_=" << soft_ram_limit_
             << " hard_ram_limit_=" << hard_ram_limit_
             << pin_count_
-            << " unpinned_blocks_.size()=" << unpinned_blocks_.size()
+            << " unpinned_blocks_.size()=" << unpinned_blocks_->size()
             << " swapped_.size()=" << swapped_.size();
 
         if (writing_bytes_ == 0 &&
@@ -1083,7 +1353,7 @@ void BlockPool::Data::IntRequestInternalMemory(
                  << " soft_ram_limit_=" << soft_ram_limit_
                  << " hard_ram_limit_=" << hard_ram_limit_
                  << pin_count_
-                 << " unpinned_blocks_.size()=" << unpinned_blocks_.size()
+                 << " unpinned_blocks_.size()=" << unpinned_blocks_->size()
                  << " swapped_.size()=" << swapped_.size();
 
             if (writing_bytes_ == last_writing_bytes) {
@@ -1113,14 +1383,14 @@ void BlockPool::AdviseFree(size_t size) {
         << " soft_ram_limit_=" << d_->soft_ram_limit_
         << " hard_ram_limit_=" << d_->hard_ram_limit_
         << d_->pin_count_
-        << " unpinned_blocks_.size()=" << d_->unpinned_blocks_.size()
+        << " unpinned_blocks_.size()=" << d_->unpinned_blocks_->size()
         << " swapped_.size()=" << d_->swapped_.size();
 
-    while (d_->soft_ram_limit_ != 0 && d_->unpinned_blocks_.size() &&
+    while (d_->soft_ram_limit_ != 0 && d_->unpinned_blocks_->size() &&
            d_->total_ram_bytes_ + d_->requested_bytes_ + size > d_->hard_ram_limit_ + d_->writing_bytes_)
     {
         // evict blocks: schedule async writing which increases writing_bytes_.
-        d_->IntEvictBlockLRU();
+        d_->IntEvictBlockLRU(lock);
     }
 }
 void BlockPool::ReleaseInternalMemory(size_t size) {
@@ -1146,11 +1416,11 @@ void BlockPool::EvictBlock(ByteBlock* block_ptr) {
 
     die_unless(block_ptr->in_memory());
 
-    die_unless(d_->unpinned_blocks_.exists(block_ptr));
-    d_->unpinned_blocks_.erase(block_ptr);
+    die_unless(d_->unpinned_blocks_->exists(block_ptr));
+    d_->unpinned_blocks_->erase(block_ptr);
     d_->unpinned_bytes_ -= block_ptr->size();
 
-    d_->IntEvictBlock(block_ptr);
+    d_->IntEvictBlock(lock, block_ptr);
 }
 
 io::RequestPtr BlockPool::GetAnyWriting() {
@@ -1159,23 +1429,94 @@ io::RequestPtr BlockPool::GetAnyWriting() {
     return d_->writing_.begin()->second;
 }
 
+void BlockPool::IntSetEvictionHint(ByteBlock* block_ptr, EvictionHint hint) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (block_ptr->eviction_hint_ == hint) return;
+    block_ptr->eviction_hint_ = hint;
+    if (d_->unpinned_blocks_->exists(block_ptr))
+        d_->unpinned_blocks_->update(block_ptr);
+}
+
+void BlockPool::IntSetBlockDiaId(ByteBlock* block_ptr, size_t dia_id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (block_ptr->dia_id_ == dia_id) return;
+    block_ptr->dia_id_ = dia_id;
+    if (d_->unpinned_blocks_->exists(block_ptr))
+        d_->unpinned_blocks_->update(block_ptr);
+}
+
+void BlockPool::SetDiaEvictionPriority(
+    size_t dia_id, int priority, size_t local_worker_id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    d_->unpinned_blocks_->SetDiaPriority(dia_id, priority, local_worker_id);
+}
+
+void BlockPool::ClearDiaEvictionPriority(
+    size_t dia_id, size_t local_worker_id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    d_->unpinned_blocks_->ClearDiaPriority(dia_id, local_worker_id);
+}
+
 io::RequestPtr BlockPool::EvictBlockLRU() {
     std::unique_lock<std::mutex> lock(mutex_);
-    return d_->IntEvictBlockLRU();
+    return d_->IntEvictBlockLRU(lock);
 }
 
-io::RequestPtr BlockPool::Data::IntEvictBlockLRU() {
+io::RequestPtr BlockPool::Data::IntEvictBlockLRU(
+    std::unique_lock<std::mutex>& lock) {
 
-    if (!unpinned_blocks_.size()) return io::RequestPtr();
+    if (!unpinned_blocks_->size()) return io::RequestPtr();
 
-    ByteBlock* block_ptr = unpinned_blocks_.pop();
+    ByteBlock* block_ptr = unpinned_blocks_->pop();
     die_unless(block_ptr);
     unpinned_bytes_ -= block_ptr->size();
 
-    return IntEvictBlock(block_ptr);
+    return IntEvictBlock(lock, block_ptr);
 }
 
-io::RequestPtr BlockPool::Data::IntEvictBlock(ByteBlock* block_ptr) {
+Byte* BlockPool::Data::AllocateOnNode(size_t size, size_t numa_node) {
+    Byte* data = aligned_alloc_.allocate(size);
+    // set the policy before the pages are first touched
+    if (numa_bind_ && !numa_.BindMemory(data, size, numa_node))
+        numa_bind_ = false;
+    return data;
+}
+
+void BlockPool::Data::IntDeallocateBlock(ByteBlock* block_ptr) {
+    aligned_alloc_.deallocate(block_ptr->data_, block_ptr->size());
+    block_ptr->data_ = nullptr;
+    numa_pool_[block_ptr->numa_node_].bytes -= block_ptr->size();
+}
+
+void BlockPool::Data::IntCountNumaPin(
+    ByteBlock* block_ptr, size_t local_worker_id) {
+    IntMeasureNumaNode(block_ptr);
+    NumaPool& pool = numa_pool_[block_ptr->numa_node_];
+    if (block_ptr->numa_node_ == worker_numa_node_[local_worker_id])
+        ++pool.local_pins;
+    else
+        ++pool.remote_pins;
+}
+
+void BlockPool::Data::IntMeasureNumaNode(ByteBlock* block_ptr) {
+    size_t local_worker_id = block_ptr->numa_unmeasured_worker_;
+    if (local_worker_id == size_t(-1)) return;
+    block_ptr->numa_unmeasured_worker_ = size_t(-1);
+
+    // the preferred node is only a hint to the kernel, check where the pages
+    // written by the worker really are.
+    size_t node = numa_.MemoryNode(block_ptr->data_, block_ptr->size());
+    if (node != size_t(-1) && node != block_ptr->numa_node_) {
+        numa_pool_[block_ptr->numa_node_].bytes -= block_ptr->size();
+        numa_pool_[node].bytes += block_ptr->size();
+        block_ptr->numa_node_ = node;
+    }
+
+    IntCountNumaPin(block_ptr, local_worker_id);
+}
+
+io::RequestPtr BlockPool::Data::IntEvictBlock(
+    std::unique_lock<std::mutex>& lock, ByteBlock* block_ptr) {
 
     // die_unless(block_ptr->block_pool_ == this);
 
@@ -1187,8 +1528,7 @@ io::RequestPtr BlockPool::Data::IntEvictBlock(ByteBlock* block_ptr) {
             << " from ext_file " << block_ptr->ext_file_;
 
         // release memory
-        aligned_alloc_.deallocate(block_ptr->data_, block_ptr->size());
-        block_ptr->data_ = nullptr;
+        IntDeallocateBlock(block_ptr);
 
         IntReleaseInternalMemory(block_ptr->size());
         return io::RequestPtr();
@@ -1196,20 +1536,29 @@ io::RequestPtr BlockPool::Data::IntEvictBlock(ByteBlock* block_ptr) {
 
     die_unless(block_ptr->em_bid_.storage == nullptr);
 
-    // allocate EM block
-    block_ptr->em_bid_.size = block_ptr->size();
+    // count the block as being written, since compression may release the
+    // lock while requests for memory are waiting for the eviction.
+    writing_bytes_ += block_ptr->size();
+
+    // compress block, if enabled, and allocate EM block for the data
+    if (compress_swap_ && IntCompressBlock(lock, block_ptr)) {
+        block_ptr->em_bid_.size = RoundUpToAlign(
+            block_ptr->em_compressed_size_);
+    }
+    else {
+        block_ptr->em_bid_.size = block_ptr->size();
+    }
     bm_->new_block(io::FullyRandom(), block_ptr->em_bid_);
 
     LOGC(debug_em)
         << "EvictBlock(): " << block_ptr << " - " << *block_ptr
         << " to em_bid " << block_ptr->em_bid_;
 
-    writing_bytes_ += block_ptr->size();
-
     // initiate writing to EM.
     io::RequestPtr req =
         block_ptr->em_bid_.storage->awrite(
-            block_ptr->data_, block_ptr->em_bid_.offset, block_ptr->size(),
+            block_ptr->em_buffer_ ? block_ptr->em_buffer_ : block_ptr->data_,
+            block_ptr->em_bid_.offset, block_ptr->em_bid_.size,
             // construct an immediate CompletionHandler callback
             io::CompletionHandler::make<
                 ByteBlock, & ByteBlock::OnWriteComplete>(block_ptr));
@@ -1217,6 +1566,72 @@ io::RequestPtr BlockPool::Data::IntEvictBlock(ByteBlock* block_ptr) {
     return (writing_[block_ptr] = std::move(req));
 }
 
+bool BlockPool::Data::IntCompressBlock(
+    std::unique_lock<std::mutex>& lock, ByteBlock* block_ptr) {
+    assert(!block_ptr->em_buffer_);
+
+    size_t capacity = CompressCapacity(block_ptr->size());
+    if (capacity == 0) return false;
+
+    // count the buffer as internal memory without waiting for the limit,
+    // since the eviction is what frees memory.
+    total_ram_bytes_ += capacity;
+
+    // compress outside of the lock: the block is neither pinned nor in the
+    // unpinned set, and PinBlock() and DestroyBlock() wait for the flag.
+    block_ptr->em_compressing_ = true;
+    lock.unlock();
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    Byte* buffer = aligned_alloc_.allocate(capacity);
+    size_t size = common::LzCompress(
+        block_ptr->data_, block_ptr->size(), buffer, capacity);
+
+    if (size == 0) {
+        aligned_alloc_.deallocate(buffer, capacity);
+        buffer = nullptr;
+    }
+    else {
+        // zero the padding up to the aligned size written to EM.
+        std::fill(buffer + size, buffer + RoundUpToAlign(size), 0);
+    }
+
+    size_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+
+    lock.lock();
+    block_ptr->em_compressing_ = false;
+    cv_compress_complete_.notify_all();
+
+    compress_time_ += elapsed;
+    compress_in_bytes_ += block_ptr->size();
+
+    if (size == 0) {
+        IntReleaseInternalMemory(capacity);
+        compress_out_bytes_ += block_ptr->size();
+        return false;
+    }
+    compress_out_bytes_ += size;
+
+    block_ptr->em_buffer_ = buffer;
+    block_ptr->em_compressed_size_ = size;
+    return true;
+}
+
+void BlockPool::Data::IntWaitCompressBlock(
+    std::unique_lock<std::mutex>& lock, ByteBlock* block_ptr) {
+    cv_compress_complete_.wait(
+        lock, [block_ptr]() { return !block_ptr->em_compressing_; });
+}
+
+void BlockPool::Data::IntReleaseCompressBuffer(
+    ByteBlock* block_ptr, size_t size) {
+    aligned_alloc_.deallocate(block_ptr->em_buffer_, size);
+    block_ptr->em_buffer_ = nullptr;
+    IntReleaseInternalMemory(size);
+}
+
 void BlockPool::OnWriteComplete(
     ByteBlock* block_ptr, io::Request* req, bool success) {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -1235,10 +1650,16 @@ void BlockPool::OnWriteComplete(
         // request was canceled. this is not an I/O error, but intentional,
         // e.g. because the block was deleted.
 
-        die_unless(!d_->unpinned_blocks_.exists(block_ptr));
-        d_->unpinned_blocks_.put(block_ptr);
+        die_unless(!d_->unpinned_blocks_->exists(block_ptr));
+        d_->unpinned_blocks_->put(block_ptr);
         d_->unpinned_bytes_ += block_ptr->size();
 
+        if (block_ptr->em_buffer_) {
+            d_->IntReleaseCompressBuffer(
+                block_ptr, CompressCapacity(block_ptr->size()));
+        }
+        block_ptr->em_compressed_size_ = 0;
+
         d_->bm_->delete_block(block_ptr->em_bid_);
         block_ptr->em_bid_ = io::BID<0>();
     }
@@ -1247,9 +1668,13 @@ void BlockPool::OnWriteComplete(
         d_->swapped_.insert(block_ptr);
         d_->swapped_bytes_ += block_ptr->size();
 
+        if (block_ptr->em_buffer_) {
+            d_->IntReleaseCompressBuffer(
+                block_ptr, CompressCapacity(block_ptr->size()));
+        }
+
         // release memory
-        d_->aligned_alloc_.deallocate(block_ptr->data_, block_ptr->size());
-        block_ptr->data_ = nullptr;
+        d_->IntDeallocateBlock(block_ptr);
 
         d_->IntReleaseInternalMemory(block_ptr->size());
     }
@@ -1276,6 +1701,13 @@ void BlockPool::RunTask(const std::chrono::steady_clock::time_point& tp) {
     size_t reading_bytes = d_->reading_bytes_.hmax_update();
     size_t pinned_bytes = d_->pin_count_.total_pinned_bytes_.hmax_update();
 
+    std::vector<size_t> numa_bytes, numa_local_pins, numa_remote_pins;
+    for (Data::NumaPool& p : d_->numa_pool_) {
+        numa_bytes.push_back(p.bytes.hmax_update());
+        numa_local_pins.push_back(p.local_pins);
+        numa_remote_pins.push_back(p.remote_pins);
+    }
+
     logger_ << "class" << "BlockPool"
             << "event" << "profile"
             << "total_blocks" << d_->int_total_blocks()
@@ -1286,10 +1718,12 @@ void BlockPool::RunTask(const std::chrono::steady_clock::time_point& tp) {
             << (unpinned_bytes + pinned_bytes + writing_bytes + reading_bytes)
             << "pinned_blocks" << d_->pin_count_.total_pins_
             << "pinned_bytes" << pinned_bytes
-            << "unpinned_blocks" << d_->unpinned_blocks_.size()
+            << "unpinned_blocks" << d_->unpinned_blocks_->size()
             << "unpinned_bytes" << unpinned_bytes
             << "swapped_blocks" << d_->swapped_.size()
             << "swapped_bytes" << d_->swapped_bytes_.hmax_update()
+            << "mapped_blocks" << d_->mapped_blocks_
+            << "mapped_bytes" << d_->mapped_bytes_.hmax_update()
             << "max_pinned_blocks" << d_->pin_count_.max_pins
             << "max_pinned_bytes" << d_->pin_count_.max_pinned_bytes
             << "writing_blocks" << d_->writing_.size()
@@ -1306,7 +1740,19 @@ void BlockPool::RunTask(const std::chrono::steady_clock::time_point& tp) {
             << "wr_ops" << stp.write_ops()
             << "wr_bytes" << stp.write_volume()
             << "wr_speed" << static_cast<double>(stp.write_volume()) / elapsed
-            << "disk_allocation" << d_->bm_->current_allocation();
+            << "disk_allocation" << d_->bm_->current_allocation()
+            << "compress_in_bytes" << d_->compress_in_bytes_
+            << "compress_out_bytes" << d_->compress_out_bytes_
+            << "compress_ratio"
+            << (d_->compress_in_bytes_ == 0 ? 1.0 :
+                static_cast<double>(d_->compress_out_bytes_)
+                / static_cast<double>(d_->compress_in_bytes_))
+            << "compress_time" << static_cast<double>(d_->compress_time_) / 1e6
+            << "decompress_time"
+            << static_cast<double>(d_->decompress_time_) / 1e6
+            << "numa_bytes" << numa_bytes
+            << "numa_local_pins" << numa_local_pins
+            << "numa_remote_pins" << numa_remote_pins;
 }
 
 size_t BlockPool::next_file_id() {
@@ -16,6 +16,7 @@
 #include <thrill/common/profile_task.hpp>
 #include <thrill/data/block.hpp>
 #include <thrill/data/byte_block.hpp>
+#include <thrill/data/eviction_policy.hpp>
 #include <thrill/io/block_manager.hpp>
 #include <thrill/io/request.hpp>
 #include <thrill/mem/manager.hpp>
@@ -68,10 +69,17 @@ public:
      * allocated. the BlockPool will create a child manager.
      *
      * \param workers_per_host number of workers on this host.
+     *
+     * \param compress_swap compress ByteBlocks written to external memory.
+     *
+     * \param eviction_policy name of the EvictionPolicy selecting blocks to
+     * write to external memory, see EvictionPolicy::Make().
      */
     BlockPool(size_t soft_ram_limit, size_t hard_ram_limit,
               common::JsonLogger* logger,
-              mem::Manager* mem_manager, size_t workers_per_host);
+              mem::Manager* mem_manager, size_t workers_per_host,
+              bool compress_swap = false,
+              const std::string& eviction_policy = "lru");
 
     //! Checks that all blocks were freed
     ~BlockPool();
@@ -79,6 +87,14 @@ public:
     //! return number of workers per host
     size_t workers_per_host() const { return workers_per_host_; }
 
+    //! Set the NUMA node of a local worker, whose ByteBlocks are then
+    //! allocated in the sub-pool of the node. Must be called before the worker
+    //! thread uses the BlockPool.
+    void SetWorkerNumaNode(size_t local_worker_id, size_t numa_node);
+
+    //! return the NUMA node of a local worker
+    size_t worker_numa_node(size_t local_worker_id) const;
+
     //! Returns logger_
     common::JsonLogger& logger() { return logger_; }
 
@@ -100,8 +116,9 @@ public:
     //! Return any currently being written block (for waiting on completion)
     io::RequestPtr GetAnyWriting();
 
-    //! Evict a Block from the LRU chain into external memory. This can return
-    //! nullptr if no blocks available, or if the Block was not dirty.
+    //! Evict the Block selected by the EvictionPolicy (by default the least
+    //! recently used) into external memory. This can return nullptr if no
+    //! blocks available, or if the Block was not dirty.
     io::RequestPtr EvictBlockLRU();
 
     //! Allocates a byte block with the request size. May block this thread if
@@ -115,6 +132,15 @@ public:
     ByteBlockPtr MapExternalBlock(
         const io::FileBasePtr& file, int64_t offset, size_t size);
 
+#if THRILL_HAVE_MMAP_FILE
+    //! Allocate a read-only byte block pointing into a memory mapping of a
+    //! file, used to map local system files to data::File without copying
+    //! them. These blocks are always in memory, are never evicted, and are not
+    //! counted against the RAM limit.
+    ByteBlockPtr MapMemoryBlock(
+        const io::MappedRangePtr& mapping, size_t offset, size_t size);
+#endif
+
     //! Increment a ByteBlock's pin count, requires the pin count to be > 0.
     void IncBlockPinCount(ByteBlock* block_ptr, size_t local_worker_id);
 
@@ -124,6 +150,32 @@ public:
     //! Destroys the block. Called by ByteBlockPtr's deleter.
     void DestroyBlock(ByteBlock* block_ptr);
 
+    //! \name Eviction Policy Hints
+    //! \{
+
+    //! Set a reader's hint about the next use of a block. Ignored unless the
+    //! EvictionPolicy uses hints.
+    void SetEvictionHint(ByteBlock* block_ptr, EvictionHint hint) {
+        if (eviction_hints_) IntSetEvictionHint(block_ptr, hint);
+    }
+
+    //! Record the DIA whose File a block is appended to. Ignored unless the
+    //! EvictionPolicy uses hints.
+    void SetBlockDiaId(ByteBlock* block_ptr, size_t dia_id) {
+        if (eviction_hints_) IntSetBlockDiaId(block_ptr, dia_id);
+    }
+
+    //! Set the eviction priority of blocks of a DIA on behalf of a local
+    //! worker: blocks with lower priority are evicted first, the default
+    //! priority is zero. If the workers differ, the lowest priority applies.
+    void SetDiaEvictionPriority(
+        size_t dia_id, int priority, size_t local_worker_id);
+
+    //! Forget the eviction priority a local worker set for a disposed DIA.
+    void ClearDiaEvictionPriority(size_t dia_id, size_t local_worker_id);
+
+    //! \}
+
     //! Evict a block into external memory. The block must be unpinned and not
     //! swapped.
     void EvictBlock(ByteBlock* block_ptr);
@@ -143,6 +195,10 @@ public:
     //! Maximum total number of bytes allocated in blocks of this block pool
     size_t max_total_bytes() noexcept;
 
+    //! Total number of bytes in read-only memory mapped blocks, which are not
+    //! included in total_bytes().
+    size_t mapped_bytes() noexcept;
+
     //! Total number of pinned blocks of this block pool
     size_t pinned_blocks() noexcept;
 
@@ -158,6 +214,13 @@ public:
     //! Total number of blocks currently begin read from EM.
     size_t reading_blocks() noexcept;
 
+    //! Total number of pins of blocks in the NUMA node of the pinning worker
+    size_t numa_local_pins() noexcept;
+
+    //! Total number of pins of blocks in another NUMA node than the one of the
+    //! pinning worker
+    size_t numa_remote_pins() noexcept;
+
     //! \}
 
     //! \name Methods for ProfileTask
@@ -187,6 +250,9 @@ private:
     //! number of workers per host
     size_t workers_per_host_;
 
+    //! whether the EvictionPolicy uses hints, constant after construction.
+    bool eviction_hints_ = false;
+
     //! a counter pair where one value is held as the max until written to stats
     struct Counter;
 
@@ -202,6 +268,12 @@ private:
     //! Increment a ByteBlock's pin count - without locking the mutex
     void IntIncBlockPinCount(ByteBlock* block_ptr, size_t local_worker_id);
 
+    //! Set a reader's hint about the next use of a block.
+    void IntSetEvictionHint(ByteBlock* block_ptr, EvictionHint hint);
+
+    //! Record the DIA whose File a block is appended to.
+    void IntSetBlockDiaId(ByteBlock* block_ptr, size_t dia_id);
+
     //! callback for async write of blocks during eviction
     void OnWriteComplete(ByteBlock* block_ptr, io::Request* req, bool success);
 
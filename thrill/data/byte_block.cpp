@@ -12,6 +12,7 @@
 #include <thrill/data/byte_block.hpp>
 #include <thrill/mem/pool.hpp>
 
+#include <cassert>
 #include <sstream>
 #include <string>
 
@@ -37,6 +38,18 @@ ByteBlock::ByteBlock(
       ext_file_(ext_file)
 { }
 
+#if THRILL_HAVE_MMAP_FILE
+ByteBlock::ByteBlock(
+    BlockPool* block_pool, const io::MappedRangePtr& mapping,
+    size_t offset, size_t size)
+    : data_(const_cast<Byte*>(mapping->data() + offset)), size_(size),
+      block_pool_(block_pool),
+      pin_count_(block_pool_->workers_per_host()),
+      mapping_(mapping) {
+    assert(offset + size <= mapping->size());
+}
+#endif
+
 void ByteBlock::Deleter::operator () (ByteBlock* bb) const {
     sLOG << "ByteBlock[" << bb << "]::deleter()"
          << "pin_count_" << bb->pin_count_str();
@@ -76,7 +89,8 @@ std::ostream& operator << (std::ostream& os, const ByteBlock& b) {
        << " size_=" << b.size_
        << " block_pool_=" << b.block_pool_
        << " total_pins_=" << b.total_pins_
-       << " ext_file_=" << b.ext_file_;
+       << " ext_file_=" << b.ext_file_
+       << " mapped=" << b.is_mapped();
     return os << "]";
 }
 
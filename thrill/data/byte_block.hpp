@@ -13,8 +13,10 @@
 #define THRILL_DATA_BYTE_BLOCK_HEADER
 
 #include <thrill/common/counting_ptr.hpp>
+#include <thrill/data/eviction_policy.hpp>
 #include <thrill/io/bid.hpp>
 #include <thrill/io/file_base.hpp>
+#include <thrill/io/mapped_range.hpp>
 #include <thrill/mem/pool.hpp>
 
 #include <string>
@@ -85,6 +87,16 @@ public:
     //! Returns whether the ByteBlock is in an external file.
     bool has_ext_file() const { return ext_file_.get() != nullptr; }
 
+    //! Returns whether the ByteBlock points into a read-only memory mapping of
+    //! a file, which is neither evicted nor counted against the RAM limit.
+    bool is_mapped() const {
+#if THRILL_HAVE_MMAP_FILE
+        return mapping_.get() != nullptr;
+#else
+        return false;
+#endif
+    }
+
     //! return current pin count
     size_t pin_count(size_t local_worker_id) const {
         return pin_count_[local_worker_id];
@@ -98,6 +110,12 @@ public:
         return data_ != nullptr;
     }
 
+    //! id of the DIA whose File the block was last appended to, or zero.
+    size_t dia_id() const { return dia_id_; }
+
+    //! hint for the BlockPool's EvictionPolicy given by readers.
+    EvictionHint eviction_hint() const { return eviction_hint_; }
+
     //! increment pin count, must be >= 1 before.
     void IncPinCount(size_t local_worker_id);
 
@@ -130,6 +148,36 @@ private:
     //! was created for directly reading binary files.
     io::FileBasePtr ext_file_;
 
+    //! size of the compressed data in external memory, or 0 if the block was
+    //! written uncompressed.
+    size_t em_compressed_size_ = 0;
+
+    //! buffer holding the compressed data while it is written to or read from
+    //! external memory.
+    Byte* em_buffer_ = nullptr;
+
+    //! whether the block is being compressed for eviction outside of the
+    //! BlockPool's mutex.
+    bool em_compressing_ = false;
+
+    //! NUMA node whose BlockPool sub-pool holds the memory of data_.
+    size_t numa_node_ = 0;
+
+    //! local worker which allocated or read data_. Its access is counted once
+    //! numa_node_ was measured from the touched pages, size_t(-1) afterwards.
+    size_t numa_unmeasured_worker_ = size_t(-1);
+
+    //! id of the DIA whose File the block was last appended to, or zero.
+    size_t dia_id_ = 0;
+
+    //! hint for the BlockPool's EvictionPolicy given by readers.
+    EvictionHint eviction_hint_ = EvictionHint::None;
+
+#if THRILL_HAVE_MMAP_FILE
+    //! read-only memory mapping which data_ points into, if != nullptr.
+    io::MappedRangePtr mapping_;
+#endif
+
     // BlockPool is a friend to call ctor and to manipulate data_.
     friend class BlockPool;
     // Block is a friend to call {Increase,Reduce}PinCount()
@@ -156,6 +204,13 @@ private:
     ByteBlock(BlockPool* block_pool, const io::FileBasePtr& ext_file,
               int64_t offset, size_t size);
 
+#if THRILL_HAVE_MMAP_FILE
+    //! Constructor to initialize ByteBlock as a part of a read-only memory
+    //! mapping of a file, starting at offset inside the mapping.
+    ByteBlock(BlockPool* block_pool, const io::MappedRangePtr& mapping,
+              size_t offset, size_t size);
+#endif
+
     friend std::ostream& operator << (std::ostream& os, const ByteBlock& b);
 
     //! forwarded to block_pool_
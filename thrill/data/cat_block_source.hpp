@@ -58,6 +58,12 @@ public:
         return PinnedBlock();
     }
 
+    //! Forward the prefetch size to the current source.
+    void Prefetch(size_t prefetch) {
+        if (current_ < sources_.size())
+            sources_[current_].Prefetch(prefetch);
+    }
+
 private:
     //! vector containing block sources
     std::vector<BlockSource> sources_;
@@ -0,0 +1,390 @@
+/*******************************************************************************
+ * thrill/data/columnar.hpp
+ *
+ * Columnar (struct-of-arrays) Block layout for fixed-size tuple items.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_DATA_COLUMNAR_HEADER
+#define THRILL_DATA_COLUMNAR_HEADER
+
+#include <thrill/common/config.hpp>
+#include <thrill/common/defines.hpp>
+#include <thrill/common/die.hpp>
+#include <thrill/common/functional.hpp>
+#include <thrill/common/logger.hpp>
+#include <thrill/common/meta.hpp>
+#include <thrill/data/block.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace thrill {
+namespace data {
+
+//! \addtogroup data_layer
+//! \{
+
+namespace detail {
+
+//! sum of the sizes of the first Index columns of Tuple
+template <typename Tuple, size_t Index>
+struct ColumnarItemSize {
+    static constexpr size_t value =
+        sizeof(typename std::tuple_element<Index - 1, Tuple>::type)
+        + ColumnarItemSize<Tuple, Index - 1>::value;
+};
+
+template <typename Tuple>
+struct ColumnarItemSize<Tuple, 0>{
+    static constexpr size_t value = 0;
+};
+
+//! whether the first Index columns of Tuple are plain old data
+template <typename Tuple, size_t Index>
+struct ColumnarIsPod {
+    using Type = typename std::tuple_element<Index - 1, Tuple>::type;
+    static constexpr bool value =
+        std::is_pod<Type>::value && !std::is_pointer<Type>::value
+        && ColumnarIsPod<Tuple, Index - 1>::value;
+};
+
+template <typename Tuple>
+struct ColumnarIsPod<Tuple, 0>{
+    static constexpr bool value = true;
+};
+
+} // namespace detail
+
+/*!
+ * Columnar layout of a Block containing num_items items of a std::pair or
+ * std::tuple of plain old data types: the values of each field are stored
+ * consecutively in a column, and the columns are stored one after another,
+ * each starting at a multiple of column_align bytes from the beginning of the
+ * Block. The layout is determined by the number of items alone, hence columnar
+ * Blocks contain only whole items and must not be split.
+ */
+template <typename Tuple>
+class ColumnarLayout
+{
+public:
+    //! number of fields of each item
+    static constexpr size_t num_columns = std::tuple_size<Tuple>::value;
+
+    //! type of the values in a column
+    template <size_t Index>
+    using ColumnType = typename std::tuple_element<Index, Tuple>::type;
+
+    //! total size of the fields of an item
+    static constexpr size_t item_size =
+        detail::ColumnarItemSize<Tuple, num_columns>::value;
+
+    //! alignment of the beginning of each column
+    static constexpr size_t column_align = 64;
+
+    //! whether Tuple can be stored in columns
+    static constexpr bool is_supported =
+        num_columns > 0 && detail::ColumnarIsPod<Tuple, num_columns>::value;
+
+    //! byte offset of column Index in a Block containing num_items items
+    template <size_t Index>
+    static size_t ColumnOffset(size_t num_items) {
+        return ColumnOffsetImpl(
+            num_items, std::integral_constant<size_t, Index>());
+    }
+
+    //! size of a Block containing num_items items
+    static size_t BlockSize(size_t num_items) {
+        return ColumnOffset<num_columns - 1>(num_items)
+               + num_items * sizeof(ColumnType<num_columns - 1>);
+    }
+
+    //! maximum number of items in a Block of block_size bytes
+    static size_t Capacity(size_t block_size) {
+        // each column wastes less than column_align bytes for padding
+        if (block_size <= num_columns * column_align) return 0;
+        return (block_size - num_columns * column_align) / item_size;
+    }
+
+private:
+    static size_t ColumnOffsetImpl(
+        size_t /* num_items */, std::integral_constant<size_t, 0>) {
+        return 0;
+    }
+
+    template <size_t Index>
+    static size_t ColumnOffsetImpl(
+        size_t num_items, std::integral_constant<size_t, Index>) {
+        size_t end = ColumnOffset<Index - 1>(num_items)
+                     + num_items * sizeof(ColumnType<Index - 1>);
+        return (end + column_align - 1) / column_align * column_align;
+    }
+};
+
+/*!
+ * ColumnarWriter stores items of a std::pair or std::tuple of plain old data
+ * types field-wise into Blocks with a ColumnarLayout, and emits full Blocks to
+ * an attached BlockSink, like a File. Such Blocks must be read with a
+ * ColumnarReader.
+ */
+template <typename Tuple, typename BlockSink>
+class ColumnarWriter
+{
+public:
+    static constexpr bool debug = false;
+
+    using Layout = ColumnarLayout<Tuple>;
+
+    static_assert(Layout::is_supported,
+                  "ColumnarWriter requires a pair or tuple of POD types");
+
+    //! Start writing Blocks of block_size to a BlockSink
+    explicit ColumnarWriter(BlockSink* sink,
+                            size_t block_size = default_block_size)
+        : sink_(sink), block_size_(block_size),
+          capacity_(Layout::Capacity(block_size)) {
+        die_unless(capacity_ > 0);
+    }
+
+    //! non-copyable: delete copy-constructor
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    //! non-copyable: delete assignment operator
+    ColumnarWriter& operator = (const ColumnarWriter&) = delete;
+
+    //! move-constructor
+    ColumnarWriter(ColumnarWriter&& cw) noexcept
+        : sink_(cw.sink_), block_size_(cw.block_size_),
+          capacity_(cw.capacity_), bytes_(std::move(cw.bytes_)),
+          nitems_(cw.nitems_), closed_(cw.closed_) {
+        // set closed flag -> disables destructor
+        cw.closed_ = true;
+    }
+
+    //! On destruction, the last partial block is flushed.
+    ~ColumnarWriter() {
+        if (!closed_)
+            Close();
+    }
+
+    //! Explicitly close the writer
+    void Close() {
+        if (closed_) return;
+        closed_ = true;
+        Flush();
+        sink_->Close();
+    }
+
+    //! Append an item by storing each field into its column.
+    THRILL_ATTRIBUTE_ALWAYS_INLINE
+    ColumnarWriter& Put(const Tuple& item) {
+        if (!bytes_) {
+            bytes_ = sink_->AllocateByteBlock(block_size_);
+            die_unless(bytes_);
+        }
+
+        Byte* data = bytes_->data();
+        size_t n = nitems_;
+        common::VariadicCallEnumerate<Layout::num_columns>(
+            [&](auto index) {
+                static constexpr size_t I = decltype(index)::index;
+                using Type = typename Layout::template ColumnType<I>;
+                std::memcpy(
+                    data + Layout::template ColumnOffset<I>(capacity_)
+                    + n * sizeof(Type),
+                    &std::get<I>(item), sizeof(Type));
+            });
+
+        if (++nitems_ == capacity_)
+            Flush();
+
+        return *this;
+    }
+
+    //! Emit the current Block to the BlockSink.
+    void Flush() {
+        if (!bytes_ || nitems_ == 0) return;
+
+        if (nitems_ < capacity_) {
+            // move the columns of the partial block together.
+            Byte* data = bytes_->data();
+            size_t n = nitems_;
+            common::VariadicCallEnumerate<1, Layout::num_columns>(
+                [&](auto index) {
+                    static constexpr size_t I = decltype(index)::index;
+                    using Type = typename Layout::template ColumnType<I>;
+                    std::memmove(
+                        data + Layout::template ColumnOffset<I>(n),
+                        data + Layout::template ColumnOffset<I>(capacity_),
+                        n * sizeof(Type));
+                });
+        }
+
+        sLOG << "ColumnarWriter::Flush()" << nitems_ << "items";
+
+        size_t size = Layout::BlockSize(nitems_);
+        sink_->AppendPinnedBlock(
+            PinnedBlock(std::move(bytes_), 0, size, 0, nitems_,
+                        /* typecode_verify */ false),
+            /* is_last_block */ closed_);
+
+        nitems_ = 0;
+        bytes_ = PinnedByteBlockPtr();
+    }
+
+private:
+    //! sink to emit Blocks to
+    BlockSink* sink_;
+
+    //! size of the ByteBlocks to allocate
+    size_t block_size_;
+
+    //! number of items in a full Block
+    size_t capacity_;
+
+    //! current block, whose columns are laid out for capacity_ items.
+    PinnedByteBlockPtr bytes_;
+
+    //! number of items in the current block
+    size_t nitems_ = 0;
+
+    //! Flag if Close was called explicitly
+    bool closed_ = false;
+};
+
+/*!
+ * ColumnarReader takes columnar Blocks written by a ColumnarWriter from a
+ * BlockSource and reads either whole items, or only one field of each item
+ * without touching the other columns. Additionally, the columns of the current
+ * Block can be accessed as arrays for field-wise loops, which the compiler can
+ * vectorize.
+ */
+template <typename Tuple, typename BlockSource>
+class ColumnarReader
+{
+public:
+    using Layout = ColumnarLayout<Tuple>;
+
+    static_assert(Layout::is_supported,
+                  "ColumnarReader requires a pair or tuple of POD types");
+
+    //! type of the values in a column
+    template <size_t Index>
+    using ColumnType = typename Layout::template ColumnType<Index>;
+
+    //! Start reading a BlockSource
+    explicit ColumnarReader(BlockSource&& source)
+        : source_(std::move(source)) { }
+
+    //! non-copyable: delete copy-constructor
+    ColumnarReader(const ColumnarReader&) = delete;
+    //! non-copyable: delete assignment operator
+    ColumnarReader& operator = (const ColumnarReader&) = delete;
+
+    //! move-constructor: default
+    ColumnarReader(ColumnarReader&&) = default;
+    //! move-assignment operator: default
+    ColumnarReader& operator = (ColumnarReader&&) = default;
+
+    //! HasNext() returns true if at least one more item is available.
+    THRILL_ATTRIBUTE_ALWAYS_INLINE
+    bool HasNext() {
+        while (current_ == num_items_) {
+            if (!NextBlock()) return false;
+        }
+        return true;
+    }
+
+    //! Next() reads a complete item from all columns.
+    THRILL_ATTRIBUTE_ALWAYS_INLINE
+    Tuple Next() {
+        assert(HasNext());
+        return GetItem(current_++,
+                       common::make_index_sequence<Layout::num_columns>());
+    }
+
+    //! NextField() reads only the field Index of the next item.
+    template <size_t Index>
+    THRILL_ATTRIBUTE_ALWAYS_INLINE
+    ColumnType<Index> NextField() {
+        assert(HasNext());
+        return GetField<Index>(current_++);
+    }
+
+    //! \name Block-wise Access to Columns
+    //! \{
+
+    //! Advance to the next non-empty Block. Returns false at the end.
+    bool NextBlock() {
+        // first release old pin.
+        block_.Reset();
+        current_ = num_items_ = 0;
+        while (num_items_ == 0) {
+            block_ = source_.NextBlock();
+            if (!block_.IsValid()) return false;
+            num_items_ = block_.num_items();
+            die_unequal(block_.size(), Layout::BlockSize(num_items_));
+        }
+        return true;
+    }
+
+    //! number of items in the current Block.
+    size_t block_num_items() const { return num_items_; }
+
+    //! Pointer to the values of column Index of the current Block, which are
+    //! aligned to ColumnarLayout::column_align bytes if the Block begins at
+    //! such an address.
+    template <size_t Index>
+    const ColumnType<Index> * Column() const {
+        return reinterpret_cast<const ColumnType<Index>*>(
+            block_.data_begin()
+            + Layout::template ColumnOffset<Index>(num_items_));
+    }
+
+    //! \}
+
+private:
+    //! Instance of BlockSource.
+    BlockSource source_;
+
+    //! The current block being read.
+    PinnedBlock block_;
+
+    //! index of the next item in the current block
+    size_t current_ = 0;
+
+    //! number of items in the current block
+    size_t num_items_ = 0;
+
+    template <size_t Index>
+    ColumnType<Index> GetField(size_t i) const {
+        ColumnType<Index> value;
+        std::memcpy(
+            &value, block_.data_begin()
+            + Layout::template ColumnOffset<Index>(num_items_)
+            + i * sizeof(ColumnType<Index>), sizeof(value));
+        return value;
+    }
+
+    template <size_t ... Is>
+    Tuple GetItem(size_t i, common::index_sequence<Is ...>) const {
+        return Tuple(GetField<Is>(i) ...);
+    }
+};
+
+//! \}
+
+} // namespace data
+} // namespace thrill
+
+#endif // !THRILL_DATA_COLUMNAR_HEADER
+
+/******************************************************************************/
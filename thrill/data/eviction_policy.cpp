@@ -0,0 +1,246 @@
+/*******************************************************************************
+ * thrill/data/eviction_policy.cpp
+ *
+ * Policies selecting which unpinned ByteBlock the BlockPool evicts next.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <thrill/common/lru_cache.hpp>
+#include <thrill/data/byte_block.hpp>
+#include <thrill/data/eviction_policy.hpp>
+#include <thrill/mem/pool.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+namespace thrill {
+namespace data {
+
+//! LRU set of ByteBlocks allocated from the global pool
+using ByteBlockLruSet = common::LruCacheSet<
+          ByteBlock*, mem::GPoolAllocator<ByteBlock*> >;
+
+/******************************************************************************/
+// LruEvictionPolicy
+
+/*!
+ * Evict the least recently unpinned block.
+ */
+class LruEvictionPolicy final : public EvictionPolicy
+{
+public:
+    void put(ByteBlock* block_ptr) final { lru_.put(block_ptr); }
+    void erase(ByteBlock* block_ptr) final { lru_.erase(block_ptr); }
+    bool exists(ByteBlock* block_ptr) const final {
+        return lru_.exists(block_ptr);
+    }
+    size_t size() const final { return lru_.size(); }
+    ByteBlock * pop() final { return lru_.pop(); }
+
+private:
+    //! all unpinned blocks in LRU order
+    ByteBlockLruSet lru_;
+};
+
+/******************************************************************************/
+// ConsumeEvictionPolicy
+
+/*!
+ * Consumption-aware policy: evict blocks which readers already consumed first,
+ * then blocks without hint, and blocks that readers announced to need next
+ * last. Within each class, the least recently unpinned block is evicted.
+ *
+ * This keeps the heads of runs in a multiway merge in memory, while plain LRU
+ * would evict them in favour of blocks just consumed by other readers.
+ */
+class ConsumeEvictionPolicy final : public EvictionPolicy
+{
+public:
+    void put(ByteBlock* block_ptr) final {
+        lru_[Class(block_ptr)].put(block_ptr);
+    }
+    void erase(ByteBlock* block_ptr) final {
+        for (ByteBlockLruSet& lru : lru_) {
+            if (!lru.exists(block_ptr)) continue;
+            lru.erase(block_ptr);
+            return;
+        }
+        assert(!"ConsumeEvictionPolicy::erase() block not contained");
+    }
+    bool exists(ByteBlock* block_ptr) const final {
+        for (const ByteBlockLruSet& lru : lru_) {
+            if (lru.exists(block_ptr)) return true;
+        }
+        return false;
+    }
+    size_t size() const final {
+        return lru_[0].size() + lru_[1].size() + lru_[2].size();
+    }
+    ByteBlock * pop() final {
+        for (ByteBlockLruSet& lru : lru_) {
+            if (lru.size()) return lru.pop();
+        }
+        assert(!"ConsumeEvictionPolicy::pop() on empty set");
+        return nullptr;
+    }
+
+    bool uses_hints() const final { return true; }
+
+    void update(ByteBlock* block_ptr) final {
+        erase(block_ptr);
+        put(block_ptr);
+    }
+
+private:
+    //! unpinned blocks in eviction order: consumed, without hint, announced.
+    ByteBlockLruSet lru_[3];
+
+    //! index into lru_ of a block
+    static size_t Class(ByteBlock* block_ptr) {
+        switch (block_ptr->eviction_hint()) {
+        case EvictionHint::Consumed:
+            return 0;
+        case EvictionHint::None:
+            return 1;
+        default:
+            return 2;
+        }
+    }
+};
+
+/******************************************************************************/
+// PriorityEvictionPolicy
+
+/*!
+ * Per-DIA priority policy: evict blocks of the DIA with the lowest eviction
+ * priority first, the least recently unpinned block among them. Ties are
+ * broken by the smaller DIA id, which is the older DIA. Blocks of DIAs which
+ * will be disposed soon have priority kDisposeSoon and are evicted last, as
+ * writing them out would be wasted I/O.
+ *
+ * The local workers share DIA ids and the blocks of a DIA, hence each worker
+ * sets its own priority, and the lowest one of them applies. A DIA disposed
+ * by one worker thus keeps the priorities of the others.
+ */
+class PriorityEvictionPolicy final : public EvictionPolicy
+{
+public:
+    void put(ByteBlock* block_ptr) final {
+        assert(!dia_of_.count(block_ptr));
+        dia_of_[block_ptr] = block_ptr->dia_id();
+        buckets_[block_ptr->dia_id()].put(block_ptr);
+        ++size_;
+    }
+    void erase(ByteBlock* block_ptr) final {
+        auto it = dia_of_.find(block_ptr);
+        assert(it != dia_of_.end());
+        auto bucket = buckets_.find(it->second);
+        bucket->second.erase(block_ptr);
+        if (bucket->second.size() == 0)
+            buckets_.erase(bucket);
+        dia_of_.erase(it);
+        --size_;
+    }
+    bool exists(ByteBlock* block_ptr) const final {
+        return dia_of_.count(block_ptr) != 0;
+    }
+    size_t size() const final { return size_; }
+    ByteBlock * pop() final {
+        assert(size_);
+        // select the bucket with the lowest priority, there are only as many
+        // buckets as DIAs with unpinned blocks.
+        auto victim = buckets_.begin();
+        int victim_priority = Priority(victim->first);
+        for (auto it = std::next(victim); it != buckets_.end(); ++it) {
+            int p = Priority(it->first);
+            if (p < victim_priority)
+                victim = it, victim_priority = p;
+        }
+        ByteBlock* block_ptr = victim->second.pop();
+        if (victim->second.size() == 0)
+            buckets_.erase(victim);
+        dia_of_.erase(block_ptr);
+        --size_;
+        return block_ptr;
+    }
+
+    bool uses_hints() const final { return true; }
+
+    void update(ByteBlock* block_ptr) final {
+        if (dia_of_[block_ptr] == block_ptr->dia_id()) return;
+        erase(block_ptr);
+        put(block_ptr);
+    }
+
+    void SetDiaPriority(size_t dia_id, int priority,
+                        size_t local_worker_id) final {
+        priority_[dia_id][local_worker_id] = priority;
+    }
+
+    void ClearDiaPriority(size_t dia_id, size_t local_worker_id) final {
+        auto it = priority_.find(dia_id);
+        if (it == priority_.end()) return;
+        it->second.erase(local_worker_id);
+        if (it->second.empty())
+            priority_.erase(it);
+    }
+
+private:
+    using DiaMap = std::unordered_map<
+              ByteBlock*, size_t, std::hash<ByteBlock*>,
+              std::equal_to<ByteBlock*>,
+              mem::GPoolAllocator<std::pair<ByteBlock* const, size_t> > >;
+
+    using BucketMap = std::map<
+              size_t, ByteBlockLruSet, std::less<size_t>,
+              mem::GPoolAllocator<std::pair<const size_t, ByteBlockLruSet> > >;
+
+    //! unpinned blocks per DIA id in LRU order
+    BucketMap buckets_;
+
+    //! DIA id of the bucket containing each block
+    DiaMap dia_of_;
+
+    //! eviction priority of DIAs set by each local worker, default zero.
+    std::unordered_map<size_t, std::map<size_t, int> > priority_;
+
+    //! total number of blocks in buckets_
+    size_t size_ = 0;
+
+    //! priority of a DIA: the lowest one set by the local workers
+    int Priority(size_t dia_id) const {
+        auto it = priority_.find(dia_id);
+        if (it == priority_.end()) return 0;
+        int priority = it->second.begin()->second;
+        for (const auto& p : it->second)
+            priority = std::min(priority, p.second);
+        return priority;
+    }
+};
+
+/******************************************************************************/
+// EvictionPolicy
+
+std::unique_ptr<EvictionPolicy> EvictionPolicy::Make(const std::string& name) {
+    if (name == "" || name == "lru")
+        return std::make_unique<LruEvictionPolicy>();
+    if (name == "consume")
+        return std::make_unique<ConsumeEvictionPolicy>();
+    if (name == "priority")
+        return std::make_unique<PriorityEvictionPolicy>();
+    return nullptr;
+}
+
+} // namespace data
+} // namespace thrill
+
+/******************************************************************************/
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * thrill/data/eviction_policy.hpp
+ *
+ * Policies selecting which unpinned ByteBlock the BlockPool evicts next.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_DATA_EVICTION_POLICY_HEADER
+#define THRILL_DATA_EVICTION_POLICY_HEADER
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+
+namespace thrill {
+namespace data {
+
+//! \addtogroup data_layer
+//! \{
+
+class ByteBlock;
+
+//! Hint given by readers about the next use of a ByteBlock.
+enum class EvictionHint : uint8_t {
+    //! nothing is known about the next use.
+    None,
+    //! a reader announced that it will pin the block soon.
+    Announced,
+    //! a reader consumed the block, it is probably not needed again soon.
+    Consumed
+};
+
+/*!
+ * Interface of the policies which keep the set of ByteBlocks that are in
+ * memory but not pinned, and select the victim to evict into external memory
+ * when the BlockPool runs out of RAM. All methods are called while holding the
+ * BlockPool's mutex.
+ *
+ * Policies may consider the EvictionHint of a block, which is set by File
+ * readers, and the eviction priority of the DIA whose File a block was last
+ * appended to.
+ */
+class EvictionPolicy
+{
+public:
+    //! eviction priority of blocks of DIAs which will be disposed after the
+    //! current PushData(), hence they are evicted last.
+    static constexpr int kDisposeSoon = std::numeric_limits<int>::max();
+
+    virtual ~EvictionPolicy() { }
+
+    //! Insert an unpinned block, which may now be evicted.
+    virtual void put(ByteBlock* block_ptr) = 0;
+
+    //! Remove a block, which was pinned or destroyed.
+    virtual void erase(ByteBlock* block_ptr) = 0;
+
+    //! Test if a block is contained.
+    virtual bool exists(ByteBlock* block_ptr) const = 0;
+
+    //! Number of blocks contained.
+    virtual size_t size() const = 0;
+
+    //! Select the next victim, remove and return it. Requires size() > 0.
+    virtual ByteBlock * pop() = 0;
+
+    //! Whether the policy uses eviction hints or DIA priorities. Otherwise the
+    //! BlockPool skips tracking them.
+    virtual bool uses_hints() const { return false; }
+
+    //! The hint or DIA of a contained block changed.
+    virtual void update(ByteBlock* /* block_ptr */) { }
+
+    //! Set the eviction priority of blocks of a DIA on behalf of a local
+    //! worker: blocks with lower priority are evicted first, the default
+    //! priority is zero.
+    virtual void SetDiaPriority(size_t /* dia_id */, int /* priority */,
+                                size_t /* local_worker_id */) { }
+
+    //! Forget the eviction priority a local worker set for a disposed DIA.
+    virtual void ClearDiaPriority(size_t /* dia_id */,
+                                  size_t /* local_worker_id */) { }
+
+    //! Construct a policy by name: "lru" (the default), "consume", or
+    //! "priority". Returns nullptr for unknown names.
+    static std::unique_ptr<EvictionPolicy> Make(const std::string& name);
+};
+
+//! \}
+
+} // namespace data
+} // namespace thrill
+
+#endif // !THRILL_DATA_EVICTION_POLICY_HEADER
+
+/******************************************************************************/
@@ -135,7 +135,9 @@ PinnedBlock KeepFileBlockSource::NextBlock() {
     if (num_prefetch_ == 0)
     {
         // operate without prefetching
-        return NextUnpinnedBlock().PinWait(local_worker_id_);
+        PinnedBlock b = NextUnpinnedBlock().PinWait(local_worker_id_);
+        SetEvictionHints(b);
+        return b;
     }
     else
     {
@@ -150,10 +152,26 @@ PinnedBlock KeepFileBlockSource::NextBlock() {
         // this might block if the prefetching is not finished
         PinnedBlock b = fetching_blocks_.front()->Wait();
         fetching_blocks_.pop_front();
+        SetEvictionHints(b);
         return b;
     }
 }
 
+void KeepFileBlockSource::SetEvictionHints(const PinnedBlock& b) {
+    BlockPool* block_pool = file_.block_pool();
+    // the delivered block is consumed when the reader releases it, and the
+    // block after the prefetched ones is needed next.
+    if (b.IsValid()) {
+        block_pool->SetEvictionHint(
+            b.byte_block().get(), EvictionHint::Consumed);
+    }
+    if (current_block_ < file_.num_blocks()) {
+        block_pool->SetEvictionHint(
+            file_.block(current_block_).byte_block().get(),
+            EvictionHint::Announced);
+    }
+}
+
 //! Determine current unpinned Block to deliver via NextBlock()
 Block KeepFileBlockSource::NextUnpinnedBlock() {
     if (current_block_ == first_block_) {
@@ -209,7 +227,9 @@ PinnedBlock ConsumeFileBlockSource::NextBlock() {
     if (num_prefetch_ == 0) {
         PinRequestPtr f = file_->blocks_.front().Pin(local_worker_id_);
         file_->blocks_.pop_front();
-        return f->Wait();
+        PinnedBlock b = f->Wait();
+        SetEvictionHints(b);
+        return b;
     }
 
     // prefetch #desired blocks
@@ -222,9 +242,25 @@ PinnedBlock ConsumeFileBlockSource::NextBlock() {
     // this might block if the prefetching is not finished
     PinnedBlock b = fetching_blocks_.front()->Wait();
     fetching_blocks_.pop_front();
+    SetEvictionHints(b);
     return b;
 }
 
+void ConsumeFileBlockSource::SetEvictionHints(const PinnedBlock& b) {
+    BlockPool* block_pool = file_->block_pool();
+    // the delivered block is consumed (it may still be referenced by other
+    // Files), and the next block in the File is needed next.
+    if (b.IsValid()) {
+        block_pool->SetEvictionHint(
+            b.byte_block().get(), EvictionHint::Consumed);
+    }
+    if (!file_->blocks_.empty()) {
+        block_pool->SetEvictionHint(
+            file_->blocks_.front().byte_block().get(),
+            EvictionHint::Announced);
+    }
+}
+
 ConsumeFileBlockSource::~ConsumeFileBlockSource() {
     if (file_) {
         file_->Clear();
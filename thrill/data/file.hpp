@@ -88,6 +88,7 @@ public:
         size_bytes_ += b.size();
         stats_bytes_ += b.size();
         stats_items_ += b.num_items();
+        if (dia_id_) block_pool()->SetBlockDiaId(b.byte_block().get(), dia_id_);
         blocks_.push_back(b);
     }
 
@@ -99,6 +100,7 @@ public:
         size_bytes_ += b.size();
         stats_bytes_ += b.size();
         stats_items_ += b.num_items();
+        if (dia_id_) block_pool()->SetBlockDiaId(b.byte_block().get(), dia_id_);
         blocks_.emplace_back(std::move(b));
     }
 
@@ -311,6 +313,9 @@ protected:
     //! Determine current unpinned Block to deliver via NextBlock()
     Block NextUnpinnedBlock();
 
+    //! Give the BlockPool's EvictionPolicy hints after delivering a block.
+    void SetEvictionHints(const PinnedBlock& b);
+
 private:
     //! sentinel value for not changing the first_item item
     static constexpr size_t keep_first_item = size_t(-1);
@@ -383,6 +388,9 @@ private:
 
     //! current prefetch operations
     std::deque<PinRequestPtr> fetching_blocks_;
+
+    //! Give the BlockPool's EvictionPolicy hints after delivering a block.
+    void SetEvictionHints(const PinnedBlock& b);
 };
 
 //! Get BlockReader seeked to the corresponding item index
@@ -11,6 +11,8 @@
 
 #include <thrill/data/multiplexer.hpp>
 
+#include <thrill/common/lz_compress.hpp>
+#include <thrill/common/math.hpp>
 #include <thrill/data/cat_stream.hpp>
 #include <thrill/data/mix_stream.hpp>
 #include <thrill/data/multiplexer_header.hpp>
@@ -241,7 +243,7 @@ void Multiplexer::OnMultiplexerHeader(Connection& s, net::Buffer&& buffer) {
     size_t local_worker = header.receiver_local_worker;
 
     // round of allocation size to next power of two
-    size_t alloc_size = header.size;
+    size_t alloc_size = header.wire_size();
     if (alloc_size < THRILL_DEFAULT_ALIGN) alloc_size = THRILL_DEFAULT_ALIGN;
     alloc_size = common::RoundUpToPowerOfTwo(alloc_size);
 
@@ -268,7 +270,7 @@ void Multiplexer::OnMultiplexerHeader(Connection& s, net::Buffer&& buffer) {
                 alloc_size, local_worker);
 
             dispatcher_.AsyncRead(
-                s, header.size, std::move(bytes),
+                s, header.wire_size(), std::move(bytes),
                 [this, header, stream](Connection& s, PinnedByteBlockPtr&& bytes) {
                     OnCatStreamBlock(s, header, stream, std::move(bytes));
                 });
@@ -297,7 +299,7 @@ void Multiplexer::OnMultiplexerHeader(Connection& s, net::Buffer&& buffer) {
                 alloc_size, local_worker);
 
             dispatcher_.AsyncRead(
-                s, header.size, std::move(bytes),
+                s, header.wire_size(), std::move(bytes),
                 [this, header, stream](Connection& s, PinnedByteBlockPtr&& bytes) mutable {
                     OnMixStreamBlock(s, header, stream, std::move(bytes));
                 });
@@ -317,6 +319,9 @@ void Multiplexer::OnCatStreamBlock(
          << "in CatStream" << header.stream_id
          << "from worker" << header.sender_worker;
 
+    if (header.is_compressed())
+        bytes = DecompressBlock(header, std::move(bytes));
+
     stream->OnStreamBlock(
         header.sender_worker,
         PinnedBlock(std::move(bytes), 0, header.size,
@@ -338,6 +343,9 @@ void Multiplexer::OnMixStreamBlock(
          << "in MixStream" << header.stream_id
          << "from worker" << header.sender_worker;
 
+    if (header.is_compressed())
+        bytes = DecompressBlock(header, std::move(bytes));
+
     stream->OnStreamBlock(
         header.sender_worker,
         PinnedBlock(std::move(bytes), 0, header.size,
@@ -350,6 +358,23 @@ void Multiplexer::OnMixStreamBlock(
     AsyncReadMultiplexerHeader(s);
 }
 
+PinnedByteBlockPtr Multiplexer::DecompressBlock(
+    const StreamMultiplexerHeader& header, PinnedByteBlockPtr&& bytes) {
+
+    size_t alloc_size = header.size;
+    if (alloc_size < THRILL_DEFAULT_ALIGN) alloc_size = THRILL_DEFAULT_ALIGN;
+    alloc_size = common::RoundUpToPowerOfTwo(alloc_size);
+
+    PinnedByteBlockPtr output = block_pool_.AllocateByteBlock(
+        alloc_size, header.receiver_local_worker);
+
+    die_unless(common::LzDecompress(
+                   bytes->begin(), header.compressed_size,
+                   output->begin(), header.size));
+
+    return output;
+}
+
 BlockQueue* Multiplexer::CatLoopback(
     size_t stream_id, size_t from_worker_id, size_t to_worker_id) {
     std::unique_lock<std::mutex> lock(mutex_);
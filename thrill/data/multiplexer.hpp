@@ -213,6 +213,10 @@ private:
     void OnMixStreamBlock(
         Connection& s, const StreamMultiplexerHeader& header,
         const MixStreamPtr& stream, PinnedByteBlockPtr&& bytes);
+
+    //! Decompresses a received compressed Block into a new ByteBlock
+    PinnedByteBlockPtr DecompressBlock(
+        const StreamMultiplexerHeader& header, PinnedByteBlockPtr&& bytes);
 };
 
 //! \}
@@ -47,6 +47,8 @@ public:
     uint32_t typecode_verify : 1;
     //! is last block piggybacked indicator
     uint32_t is_last_block : 1;
+    //! size of the block's data on the wire if it is compressed, otherwise 0.
+    uint32_t compressed_size = 0;
 
     MultiplexerHeader() = default;
 
@@ -60,8 +62,18 @@ public:
             assert(!typecode_verify);
     }
 
+    //! Indicates if the block's data is compressed
+    bool is_compressed() const {
+        return compressed_size != 0;
+    }
+
+    //! Size of the block's data following the header on the wire
+    size_t wire_size() const {
+        return is_compressed() ? compressed_size : size;
+    }
+
     static constexpr size_t header_size =
-        sizeof(MagicByte) + 3 * sizeof(uint32_t);
+        sizeof(MagicByte) + 4 * sizeof(uint32_t);
 
     static constexpr size_t total_size =
         header_size + 3 * sizeof(size_t);
@@ -44,6 +44,8 @@ void Stream::OnAllClosed(const char* stream_type) {
         << "tx_net_items" << tx_net_items_
         << "tx_net_bytes" << tx_net_bytes_
         << "tx_net_blocks" << tx_net_blocks_
+        << "tx_net_compress_in" << tx_net_compress_in_
+        << "tx_net_compress_out" << tx_net_compress_out_
         << "rx_int_items" << rx_int_items_
         << "rx_int_bytes" << rx_int_bytes_
         << "rx_int_blocks" << rx_int_blocks_
@@ -68,6 +68,14 @@ public:
 
     void OnAllClosed(const char* stream_type);
 
+    //! Enable compression of Blocks sent over the network. Receivers detect
+    //! compressed Blocks by their MultiplexerHeader, hence only the senders
+    //! need to enable it. Must be called before the writers send data.
+    void set_compress(bool compress) { compress_ = compress; }
+
+    //! Returns whether Blocks sent over the network are compressed.
+    bool compress() const { return compress_; }
+
     //! shuts the stream down.
     virtual void Close() = 0;
 
@@ -156,6 +164,11 @@ public:
     std::atomic<size_t>
     tx_net_items_ { 0 }, tx_net_bytes_ { 0 }, tx_net_blocks_ { 0 };
 
+    //! StatsCounters for outgoing compressed data transfer - shared by all
+    //! sinks. Counts the bytes of Blocks before and after compression.
+    std::atomic<size_t>
+    tx_net_compress_in_ { 0 }, tx_net_compress_out_ { 0 };
+
     //! StatsCounter for incoming data transfer.  Exclusively contains only
     //! loopback (internal) data transfer
     std::atomic<size_t>
@@ -193,6 +206,9 @@ protected:
     //! number of received stream closing Blocks.
     common::Semaphore sem_closing_blocks_;
 
+    //! whether to compress Blocks sent over the network
+    bool compress_ = false;
+
     //! friends for access to multiplexer_
     friend class StreamSink;
 };
@@ -10,10 +10,15 @@
 
 #include <thrill/data/stream_sink.hpp>
 
+#include <thrill/common/lz_compress.hpp>
+#include <thrill/common/math.hpp>
 #include <thrill/data/cat_stream.hpp>
 #include <thrill/data/mix_stream.hpp>
 #include <thrill/data/multiplexer_header.hpp>
 #include <thrill/data/stream.hpp>
+#include <thrill/mem/aligned_allocator.hpp>
+
+#include <algorithm>
 
 namespace thrill {
 namespace data {
@@ -78,6 +83,10 @@ void StreamSink::AppendPinnedBlock(const PinnedBlock& block, bool is_last_block)
     header.receiver_local_worker = peer_local_worker_;
     header.is_last_block = is_last_block;
 
+    PinnedBlock compressed = CompressBlock(block);
+    if (compressed.IsValid())
+        header.compressed_size = static_cast<uint32_t>(compressed.size());
+
     net::BufferBuilder bb;
     header.Serialize(bb);
 
@@ -85,13 +94,14 @@ void StreamSink::AppendPinnedBlock(const PinnedBlock& block, bool is_last_block)
     assert(buffer.size() == MultiplexerHeader::total_size);
 
     item_counter_ += block.num_items();
-    byte_counter_ += buffer.size() + block.size();
+    byte_counter_ += buffer.size() + header.wire_size();
     ++block_counter_;
 
     stream_.multiplexer_.dispatcher_.AsyncWrite(
         *connection_,
         // send out Buffer and Block, guaranteed to be successive
-        std::move(buffer), PinnedBlock(block),
+        std::move(buffer),
+        compressed.IsValid() ? std::move(compressed) : PinnedBlock(block),
         [this](net::Connection&) { sem_.signal(); });
 
     if (is_last_block) {
@@ -118,6 +128,50 @@ void StreamSink::AppendPinnedBlock(PinnedBlock&& block, bool is_last_block) {
     return AppendPinnedBlock(block, is_last_block);
 }
 
+PinnedBlock StreamSink::CompressBlock(const PinnedBlock& block) {
+    if (!stream_.compress()) return PinnedBlock();
+
+    if (compress_skip_ != 0) {
+        // compression is paused due to a bad ratio, retry later.
+        --compress_skip_;
+        return PinnedBlock();
+    }
+
+    size_t capacity = static_cast<size_t>(
+        static_cast<double>(block.size()) * compress_max_ratio_);
+
+    PinnedByteBlockPtr bytes = AllocateByteBlock(
+        common::RoundUpToPowerOfTwo(
+            std::max<size_t>(capacity, THRILL_DEFAULT_ALIGN)));
+
+    size_t size = common::LzCompress(
+        block.data_begin(), block.size(), bytes->begin(), capacity);
+
+    ++compress_blocks_;
+    compress_in_ += block.size();
+    compress_out_ += (size != 0 ? size : block.size());
+
+    // periodically check the ratio of the last Blocks, and pause compression
+    // if the data is currently not compressible enough.
+    if (compress_blocks_ % compress_check_blocks_ == 0) {
+        double ratio =
+            static_cast<double>(compress_out_ - compress_check_out_)
+            / static_cast<double>(compress_in_ - compress_check_in_);
+        if (ratio > compress_disable_ratio_) {
+            LOG << "StreamSink::CompressBlock()"
+                << " pausing compression, ratio " << ratio;
+            compress_skip_ = compress_pause_blocks_;
+            ++compress_pauses_;
+        }
+        compress_check_in_ = compress_in_;
+        compress_check_out_ = compress_out_;
+    }
+
+    if (size == 0) return PinnedBlock();
+
+    return PinnedBlock(std::move(bytes), 0, size, 0, 0, false);
+}
+
 void StreamSink::Close() {
     if (closed_) return;
     closed_ = true;
@@ -164,11 +218,16 @@ void StreamSink::Finalize() {
         << "items" << item_counter_
         << "bytes" << byte_counter_
         << "blocks" << block_counter_
-        << "timespan" << timespan_;
+        << "timespan" << timespan_
+        << "compress_in" << compress_in_
+        << "compress_out" << compress_out_
+        << "compress_pauses" << compress_pauses_;
 
     stream_.tx_net_items_ += item_counter_;
     stream_.tx_net_bytes_ += byte_counter_;
     stream_.tx_net_blocks_ += block_counter_;
+    stream_.tx_net_compress_in_ += compress_in_;
+    stream_.tx_net_compress_out_ += compress_out_;
 }
 
 } // namespace data
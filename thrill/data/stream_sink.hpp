@@ -89,6 +89,10 @@ public:
 private:
     static constexpr bool debug = false;
 
+    //! Compress a Block for sending, if compression is enabled and worthwhile.
+    //! Returns the compressed Block or an invalid Block.
+    PinnedBlock CompressBlock(const PinnedBlock& block);
+
     Stream& stream_;
     net::Connection* connection_ = nullptr;
 
@@ -111,6 +115,39 @@ private:
     size_t byte_counter_ = 0;
     size_t block_counter_ = 0;
     common::StatsTimerStart timespan_;
+
+    //! \name Adaptive Compression
+    //! \{
+
+    //! a compressed Block must be smaller than this fraction of the original.
+    static constexpr double compress_max_ratio_ = 0.875;
+
+    //! number of compressed Blocks after which the ratio is checked again.
+    static constexpr size_t compress_check_blocks_ = 16;
+
+    //! pause compression if the ratio of the last Blocks is worse than this.
+    static constexpr double compress_disable_ratio_ = 0.8;
+
+    //! number of Blocks sent uncompressed before compression is retried.
+    static constexpr size_t compress_pause_blocks_ = 256;
+
+    //! number of Blocks still to send uncompressed due to a bad ratio
+    size_t compress_skip_ = 0;
+
+    //! number of times compression was paused due to a bad ratio
+    size_t compress_pauses_ = 0;
+
+    //! number of Blocks passed to the compressor
+    size_t compress_blocks_ = 0;
+
+    //! number of bytes before and after compression, unsent Blocks are
+    //! counted with their original size.
+    size_t compress_in_ = 0, compress_out_ = 0;
+
+    //! compress_in_ and compress_out_ at the last ratio check
+    size_t compress_check_in_ = 0, compress_check_out_ = 0;
+
+    //! \}
 };
 
 //! \}
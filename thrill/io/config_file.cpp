@@ -379,7 +379,7 @@ void DiskConfig::parse_fileio() {
         }
         else if (eq[0] == "queue")
         {
-            if (io_impl == "linuxaio") {
+            if (io_impl == "linuxaio" || io_impl == "iouring") {
                 THRILL_THROW(std::runtime_error, "Parameter '" << *p << "' invalid for fileio '" << io_impl << "' in disk configuration file.");
             }
 
@@ -392,9 +392,9 @@ void DiskConfig::parse_fileio() {
         }
         else if (eq[0] == "queue_length")
         {
-            if (io_impl != "linuxaio") {
+            if (io_impl != "linuxaio" && io_impl != "iouring") {
                 THRILL_THROW(std::runtime_error, "Parameter '" << *p << "' "
-                             "is only valid for fileio linuxaio "
+                             "is only valid for fileio linuxaio and iouring "
                              "in disk configuration file.");
             }
 
@@ -425,7 +425,8 @@ void DiskConfig::parse_fileio() {
         else if (*p == "unlink" || *p == "unlink_on_open")
         {
             if (!(io_impl == "syscall" || io_impl == "linuxaio" ||
-                  io_impl == "mmap" || io_impl == "wbtl"))
+                  io_impl == "iouring" || io_impl == "mmap" ||
+                  io_impl == "wbtl"))
             {
                 THRILL_THROW(std::runtime_error, "Parameter '" << *p << "' invalid for fileio '" << io_impl << "' in disk configuration file.");
             }
@@ -465,7 +466,9 @@ std::string DiskConfig::fileio_string() const {
     if (flash)
         oss << " flash";
 
-    if (queue != FileBase::DEFAULT_QUEUE && queue != FileBase::DEFAULT_LINUXAIO_QUEUE)
+    if (queue != FileBase::DEFAULT_QUEUE &&
+        queue != FileBase::DEFAULT_LINUXAIO_QUEUE &&
+        queue != FileBase::DEFAULT_IOURING_QUEUE)
         oss << " queue=" << queue;
 
     if (device_id != FileBase::DEFAULT_DEVICE_ID)
@@ -102,7 +102,7 @@ public:
     //! unlink file immediately after opening (available on most Unix)
     bool unlink_on_open;
 
-    //! desired queue length for linuxaio_file and linuxaio_queue
+    //! desired queue length for linuxaio and iouring files and queues
     int queue_length;
 
     //! \}
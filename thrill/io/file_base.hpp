@@ -95,6 +95,7 @@ public:
 
     static constexpr int DEFAULT_QUEUE = -1;
     static constexpr int DEFAULT_LINUXAIO_QUEUE = -2;
+    static constexpr int DEFAULT_IOURING_QUEUE = -3;
     static constexpr int NO_ALLOCATOR = -1;
     static constexpr unsigned int DEFAULT_DEVICE_ID = (unsigned int)(-1);
 
@@ -138,7 +139,8 @@ public:
 
     //! Returns the identifier of the file's queue number.
     //! \remark Files allocated on the same physical device usually share the
-    //! same queue, unless there is a common queue (e.g. with linuxaio).
+    //! same queue, unless there is a common queue (e.g. with linuxaio or
+    //! iouring).
     virtual int get_queue_id() const = 0;
 
     //! Returns the file's disk allocator number
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * thrill/io/iouring_file.cpp
+ *
+ * File implementation using the Linux io_uring interface.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <thrill/io/iouring_file.hpp>
+
+#if THRILL_HAVE_IOURING_FILE
+
+#include <thrill/io/disk_queues.hpp>
+#include <thrill/io/iouring_request.hpp>
+#include <thrill/mem/pool.hpp>
+
+namespace thrill {
+namespace io {
+
+RequestPtr IouringFile::aread(
+    void* buffer, offset_type offset, size_type bytes,
+    const CompletionHandler& on_cmpl) {
+
+    RequestPtr req(mem::GPool().make<IouringRequest>(
+                       on_cmpl, FileBasePtr(this),
+                       buffer, offset, bytes, Request::READ));
+
+    DiskQueues::GetInstance()->AddRequest(req, get_queue_id());
+
+    return req;
+}
+
+RequestPtr IouringFile::awrite(
+    void* buffer, offset_type offset, size_type bytes,
+    const CompletionHandler& on_cmpl) {
+
+    RequestPtr req(mem::GPool().make<IouringRequest>(
+                       on_cmpl, FileBasePtr(this),
+                       buffer, offset, bytes, Request::WRITE));
+
+    DiskQueues::GetInstance()->AddRequest(req, get_queue_id());
+
+    return req;
+}
+
+void IouringFile::serve(void* buffer, offset_type offset, size_type bytes,
+                        Request::ReadOrWriteType type) {
+    // req need not be an IouringRequest
+    if (type == Request::READ)
+        aread(buffer, offset, bytes)->wait();
+    else
+        awrite(buffer, offset, bytes)->wait();
+}
+
+const char* IouringFile::io_type() const {
+    return "iouring";
+}
+
+} // namespace io
+} // namespace thrill
+
+#endif // #if THRILL_HAVE_IOURING_FILE
+
+/******************************************************************************/
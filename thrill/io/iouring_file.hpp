@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * thrill/io/iouring_file.hpp
+ *
+ * File implementation using the Linux io_uring interface.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_IO_IOURING_FILE_HEADER
+#define THRILL_IO_IOURING_FILE_HEADER
+
+#include <thrill/common/config.hpp>
+
+#if THRILL_HAVE_IOURING_FILE
+
+#include <thrill/io/disk_queued_file.hpp>
+#include <thrill/io/iouring_queue.hpp>
+#include <thrill/io/ufs_file_base.hpp>
+
+#include <string>
+
+namespace thrill {
+namespace io {
+
+class IouringQueue;
+
+//! \addtogroup io_layer_fileimpl
+//! \{
+
+//! Implementation of \c file based on the Linux kernel's io_uring interface,
+//! which submits batches of requests with a single system call.
+class IouringFile final : public UfsFileBase, public DiskQueuedFile
+{
+    friend class IouringRequest;
+
+private:
+    int desired_queue_length_;
+
+public:
+    //! Constructs file object
+    //! \param filename path of file
+    //! \param mode open mode, see \c FileBase::OpenMode
+    //! \param queue_id disk queue identifier
+    //! \param allocator_id linked disk_allocator
+    //! \param device_id physical device identifier
+    //! \param desired_queue_length queue length requested from kernel
+    IouringFile(
+        const std::string& filename, int mode,
+        int queue_id = DEFAULT_IOURING_QUEUE,
+        int allocator_id = NO_ALLOCATOR,
+        unsigned int device_id = DEFAULT_DEVICE_ID,
+        int desired_queue_length = 0)
+        : FileBase(device_id),
+          UfsFileBase(filename, mode),
+          DiskQueuedFile(queue_id, allocator_id),
+          desired_queue_length_(desired_queue_length)
+    { }
+
+    void serve(void* buffer, offset_type offset, size_type bytes,
+               Request::ReadOrWriteType type) final;
+    RequestPtr aread(void* buffer, offset_type offset, size_type bytes,
+                     const CompletionHandler& on_cmpl = CompletionHandler()) final;
+    RequestPtr awrite(void* buffer, offset_type offset, size_type bytes,
+                      const CompletionHandler& on_cmpl = CompletionHandler()) final;
+    const char * io_type() const final;
+
+    int desired_queue_length() const {
+        return desired_queue_length_;
+    }
+};
+
+//! \}
+
+} // namespace io
+} // namespace thrill
+
+#endif // #if THRILL_HAVE_IOURING_FILE
+
+#endif // !THRILL_IO_IOURING_FILE_HEADER
+
+/******************************************************************************/
@@ -0,0 +1,277 @@
+/*******************************************************************************
+ * thrill/io/iouring_queue.cpp
+ *
+ * Request queue for IouringFile based on the Linux io_uring interface.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <thrill/io/file_base.hpp>
+#include <thrill/io/iouring_queue.hpp>
+
+#if THRILL_HAVE_IOURING_FILE
+
+#include <thrill/io/error_handling.hpp>
+#include <thrill/io/iouring_request.hpp>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace thrill {
+namespace io {
+
+IouringQueue::IouringQueue(int desired_queue_length)
+    : wait_thread_state_(NOT_RUNNING) {
+    if (desired_queue_length == 0) {
+        // default value, NVMe devices need a deeper queue than the 64 entries
+        // used by linuxaio to reach their full throughput.
+        max_events_ = 256;
+    }
+    else
+        max_events_ = desired_queue_length;
+
+    // the completion queue is twice as long as the submission queue, and at
+    // most max_events_ requests are in flight, hence it cannot overflow.
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = static_cast<int>(
+        syscall(__NR_io_uring_setup, max_events_, &params));
+    if (ring_fd_ < 0) {
+        THRILL_THROW_ERRNO(IoError, "IouringQueue::IouringQueue"
+                           " io_uring_setup() entries=" << max_events_);
+    }
+    // kernel rounds the number of entries up to a power of two
+    max_events_ = static_cast<int>(params.sq_entries);
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+    sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED)
+        THRILL_THROW_ERRNO(IoError, "IouringQueue::IouringQueue mmap() sq_ring");
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        cq_ring_ = sq_ring_;
+    }
+    else {
+        cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_ring_ == MAP_FAILED)
+            THRILL_THROW_ERRNO(IoError, "IouringQueue::IouringQueue mmap() cq_ring");
+    }
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(
+        mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES));
+    if (sqes_ == MAP_FAILED)
+        THRILL_THROW_ERRNO(IoError, "IouringQueue::IouringQueue mmap() sqes");
+
+    char* sq = static_cast<char*>(sq_ring_);
+    sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    char* cq = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    num_free_events_ = static_cast<unsigned>(max_events_);
+
+    LOG1 << "Set up an iouring queue with " << max_events_ << " entries.";
+
+    StartThread(WaitAsync, static_cast<void*>(this), wait_thread_, wait_thread_state_);
+}
+
+IouringQueue::~IouringQueue() {
+    StopThread(wait_thread_, wait_thread_state_, num_posted_requests_);
+
+    munmap(sqes_, sqes_size_);
+    if (cq_ring_ != sq_ring_)
+        munmap(cq_ring_, cq_ring_size_);
+    munmap(sq_ring_, sq_ring_size_);
+    ::close(ring_fd_);
+}
+
+int IouringQueue::Enter(
+    unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(
+        syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags,
+                nullptr, 0));
+}
+
+void IouringQueue::AddRequest(RequestPtr& req) {
+    if (req.empty())
+        THRILL_THROW_INVALID_ARGUMENT("Empty request submitted to disk_queue.");
+    if (wait_thread_state_() != RUNNING)
+        LOG1 << "Request submitted to stopped queue.";
+    if (!dynamic_cast<IouringRequest*>(req.get()))
+        LOG1 << "Non-Iouring request submitted to Iouring queue.";
+
+    std::unique_lock<std::mutex> lock(ring_mtx_);
+
+    waiting_requests_.push_back(req);
+    SubmitRequests();
+}
+
+bool IouringQueue::CancelRequest(Request* req) {
+    if (!req)
+        THRILL_THROW_INVALID_ARGUMENT("Empty request canceled disk_queue.");
+    if (wait_thread_state_() != RUNNING)
+        LOG1 << "Request canceled in stopped queue.";
+    if (!dynamic_cast<IouringRequest*>(req))
+        LOG1 << "Non-Iouring request submitted to Iouring queue.";
+
+    // only requests not yet submitted to the kernel can be canceled, reads
+    // and writes of regular files cannot be interrupted once they started.
+    std::unique_lock<std::mutex> lock(ring_mtx_);
+
+    Queue::iterator pos =
+        std::find(waiting_requests_.begin(), waiting_requests_.end(), req);
+    if (pos == waiting_requests_.end())
+        return false;
+
+    waiting_requests_.erase(pos);
+
+    // request is canceled, but was not yet posted.
+    dynamic_cast<IouringRequest*>(req)->completed(false, true);
+
+    return true;
+}
+
+void IouringQueue::SubmitRequests() {
+    if (waiting_requests_.empty() || num_free_events_ == 0)
+        return;
+
+    // fill submission queue entries for all waiting requests that fit into
+    // the free slots. The submission queue is empty, since all entries are
+    // consumed by io_uring_enter() below.
+    unsigned tail = *sq_tail_;
+    unsigned num_batch = 0;
+    while (!waiting_requests_.empty() && num_free_events_ > 0)
+    {
+        RequestPtr& req = waiting_requests_.front();
+        unsigned index = tail & *sq_mask_;
+        dynamic_cast<IouringRequest*>(req.get())->prepare_sqe(&sqes_[index]);
+        sq_array_[index] = index;
+        ++tail, ++num_batch, --num_free_events_;
+        // the submission queue entry holds its own reference
+        waiting_requests_.pop_front();
+    }
+    __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+
+    unsigned num_submitted = 0;
+    while (num_submitted < num_batch)
+    {
+        int r = Enter(num_batch - num_submitted, 0, 0);
+        if (r < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                // kernel is temporarily out of resources, try again
+                std::this_thread::yield();
+                continue;
+            }
+            THRILL_THROW_ERRNO(IoError, "IouringQueue::SubmitRequests"
+                               " io_uring_enter() to_submit="
+                               << num_batch - num_submitted);
+        }
+        num_submitted += static_cast<unsigned>(r);
+    }
+
+    LOG << "IouringQueue::SubmitRequests() submitted " << num_batch;
+
+    // requests are finally posted
+    num_posted_requests_.signal(num_batch);
+}
+
+void IouringQueue::HandleCompletions() {
+    const unsigned first = *cq_head_;
+    unsigned head = first;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+
+    // requests with a short read or write, the remainder is submitted again.
+    Queue resubmit;
+
+    for ( ; head != tail; ++head)
+    {
+        const io_uring_cqe* cqe = &cqes_[head & *cq_mask_];
+        RequestPtr* r = reinterpret_cast<RequestPtr*>(
+            static_cast<uintptr_t>(cqe->user_data));
+        int res = cqe->res;
+
+        // release completion queue entry
+        __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+
+        num_posted_requests_.wait(); // will never block
+
+        IouringRequest* ir = dynamic_cast<IouringRequest*>(r->get());
+        if (ir->handle_result(res))
+            ir->completed(false);
+        else
+            resubmit.push_back(*r);
+
+        delete r;                    // release counting_ptr reference
+    }
+
+    // release the slots and submit requests which waited for them
+    std::unique_lock<std::mutex> lock(ring_mtx_);
+    num_free_events_ += head - first;
+    waiting_requests_.splice(waiting_requests_.begin(), resubmit);
+    SubmitRequests();
+}
+
+// internal routines, run by the waiting thread
+void IouringQueue::WaitRequests() {
+    for ( ; ; ) // as long as thread is running
+    {
+        // might block until next request is posted or message comes in
+        size_t num_currently_posted_requests = num_posted_requests_.wait();
+
+        // terminate if termination has been requested
+        if (wait_thread_state_() == TERMINATING && num_currently_posted_requests == 0)
+            break;
+
+        // wait for at least one of them to finish
+        while (*cq_head_ == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE))
+        {
+            if (Enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                THRILL_THROW_ERRNO(IoError, "IouringQueue::WaitRequests"
+                                   " io_uring_enter()");
+            }
+        }
+
+        // compensate for the one eaten prematurely above
+        num_posted_requests_.signal();
+
+        HandleCompletions();
+    }
+}
+
+void* IouringQueue::WaitAsync(void* arg) {
+    (static_cast<IouringQueue*>(arg))->WaitRequests();
+
+    self_type* pthis = static_cast<self_type*>(arg);
+    pthis->wait_thread_state_.set_to(TERMINATED);
+
+    return nullptr;
+}
+
+} // namespace io
+} // namespace thrill
+
+#endif // #if THRILL_HAVE_IOURING_FILE
+
+/******************************************************************************/
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * thrill/io/iouring_queue.hpp
+ *
+ * Request queue for IouringFile based on the Linux io_uring interface.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_IO_IOURING_QUEUE_HEADER
+#define THRILL_IO_IOURING_QUEUE_HEADER
+
+#include <thrill/io/request_queue_impl_worker.hpp>
+
+#if THRILL_HAVE_IOURING_FILE
+
+#include <linux/io_uring.h>
+
+#include <list>
+#include <mutex>
+
+namespace thrill {
+namespace io {
+
+//! \addtogroup io_layer_req
+//! \{
+
+//! Queue for IouringFile(s)
+//!
+//! Only one queue exists in a program, i.e. it is a singleton. AddRequest()
+//! fills the submission queue entries directly on the calling thread, under the
+//! ring mutex, and submits all requests waiting at that moment with a single
+//! io_uring_enter() call. Requests only wait if all slots are in flight, they
+//! are then submitted by the thread reaping the completion queue.
+class IouringQueue final : public RequestQueueImplWorker
+{
+    static constexpr bool debug = false;
+
+    friend class IouringRequest;
+
+    using self_type = IouringQueue;
+
+private:
+    //! io_uring file descriptor
+    int ring_fd_ = -1;
+
+    //! mmapped submission and completion rings and submission entries
+    void* sq_ring_ = nullptr, * cq_ring_ = nullptr;
+    size_t sq_ring_size_ = 0, cq_ring_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+
+    //! pointers into the submission queue ring
+    unsigned* sq_head_, * sq_tail_, * sq_mask_, * sq_array_;
+    //! pointers into the completion queue ring
+    unsigned* cq_head_, * cq_tail_, * cq_mask_;
+    io_uring_cqe* cqes_;
+
+    //! storing IouringRequest* would drop ownership
+    using Queue = std::list<RequestPtr>;
+
+    //! mutex protecting the submission ring, waiting_requests_ and
+    //! num_free_events_
+    std::mutex ring_mtx_;
+
+    // "waiting" request have submitted to this queue, but not yet to the OS.
+    Queue waiting_requests_;
+
+    //! max number of requests in flight, which is the submission queue length
+    int max_events_;
+    //! number of free submission slots
+    unsigned num_free_events_;
+    //! number of posted requests, on which the reaping thread waits
+    common::Semaphore num_posted_requests_;
+
+    // thread reaping the completion queue
+    std::thread wait_thread_;
+    common::SharedState<ThreadState> wait_thread_state_;
+
+    static constexpr PriorityOp priority_op_ = WRITE;
+
+    static void * WaitAsync(void* arg);   // thread start callback
+    //! Submit waiting requests while there are free slots, requires a lock on
+    //! ring_mtx_.
+    void SubmitRequests();
+    void WaitRequests();
+    void HandleCompletions();
+
+    //! io_uring_enter() system call wrapper
+    int Enter(unsigned to_submit, unsigned min_complete, unsigned flags);
+
+
+public:
+    //! Construct queue. Requests max number of requests simultaneously
+    //! submitted to disk, 0 means the default.
+    explicit IouringQueue(int desired_queue_length = 0);
+
+    void AddRequest(RequestPtr& req) final;
+    bool CancelRequest(Request* req) final;
+    ~IouringQueue();
+
+};
+
+//! \}
+
+} // namespace io
+} // namespace thrill
+
+#endif // #if THRILL_HAVE_IOURING_FILE
+
+#endif // !THRILL_IO_IOURING_QUEUE_HEADER
+
+/******************************************************************************/
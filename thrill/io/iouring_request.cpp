@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * thrill/io/iouring_request.cpp
+ *
+ * Request for an IouringFile, which is submitted via an io_uring.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <thrill/io/iouring_request.hpp>
+
+#if THRILL_HAVE_IOURING_FILE
+
+#include <thrill/io/disk_queues.hpp>
+#include <thrill/io/error_handling.hpp>
+#include <thrill/io/iostats.hpp>
+#include <thrill/mem/pool.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace thrill {
+namespace io {
+
+void IouringRequest::completed(bool posted, bool canceled) {
+    LOG << "IouringRequest[" << this << "] completed("
+        << posted << "," << canceled << ")";
+
+    if (!canceled)
+    {
+        if (type_ == READ)
+            Stats::GetInstance()->read_finished();
+        else
+            Stats::GetInstance()->write_finished();
+    }
+    else if (posted)
+    {
+        if (type_ == READ)
+            Stats::GetInstance()->read_canceled(bytes_);
+        else
+            Stats::GetInstance()->write_canceled(bytes_);
+    }
+    Request::completed(canceled);
+}
+
+void IouringRequest::prepare_sqe(io_uring_sqe* sqe) {
+    LOG << "IouringRequest[" << this << "] prepare_sqe()"
+        << " done=" << done_;
+
+    IouringFile* af = dynamic_cast<IouringFile*>(file_.get());
+
+    if (done_ == 0) {
+        // remember the time before io_uring_enter(), which may take a while.
+        double now = timestamp();
+        if (type_ == READ)
+            Stats::GetInstance()->read_started(bytes_, now);
+        else
+            Stats::GetInstance()->write_started(bytes_, now);
+    }
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = (type_ == READ) ? IORING_OP_READ : IORING_OP_WRITE;
+    sqe->fd = af->file_des_;
+    sqe->off = offset_ + done_;
+    sqe->addr = reinterpret_cast<uintptr_t>(static_cast<char*>(buffer_) + done_);
+    // the length field has 32 bits, larger requests are split by handle_result
+    sqe->len = static_cast<__u32>(
+        std::min<size_type>(bytes_ - done_, size_type(1) << 30));
+    // indirection, so the I/O system retains a counting_ptr reference
+    sqe->user_data = reinterpret_cast<uintptr_t>(new RequestPtr(this));
+}
+
+bool IouringRequest::handle_result(int res) {
+    LOG << "IouringRequest[" << this << "] handle_result(" << res << ")";
+
+    if (res < 0) {
+        mem::safe_ostringstream msg;
+        msg << "IouringRequest " << (type_ == READ ? "read" : "write")
+            << " failed: offset=" << offset_ + done_
+            << " bytes=" << bytes_ - done_ << ": " << strerror(-res);
+        save_error(msg.str());
+        return true;
+    }
+
+    done_ += static_cast<size_type>(res);
+    if (done_ >= bytes_)
+        return true;
+
+    if (res == 0) {
+        if (type_ == READ) {
+            // read request extends past end-of-file, fill reminder with zeroes
+            memset(static_cast<char*>(buffer_) + done_, 0, bytes_ - done_);
+        }
+        else {
+            save_error("IouringRequest write failed: no bytes written");
+        }
+        return true;
+    }
+
+    return false;
+}
+
+//! Cancel the request
+//!
+//! Routine is called by user, as part of the request interface.
+bool IouringRequest::cancel() {
+    LOG << "IouringRequest[" << this << "] cancel()";
+
+    if (!file_) return false;
+
+    RequestPtr req(this);
+    IouringQueue* queue = dynamic_cast<IouringQueue*>(
+        DiskQueues::GetInstance()->GetQueue(file_->get_queue_id()));
+    return queue->CancelRequest(req.get());
+}
+
+} // namespace io
+} // namespace thrill
+
+#endif // #if THRILL_HAVE_IOURING_FILE
+
+/******************************************************************************/
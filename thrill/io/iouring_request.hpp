@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * thrill/io/iouring_request.hpp
+ *
+ * Request for an IouringFile, which is submitted via an io_uring.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_IO_IOURING_REQUEST_HEADER
+#define THRILL_IO_IOURING_REQUEST_HEADER
+
+#include <thrill/io/iouring_file.hpp>
+
+#if THRILL_HAVE_IOURING_FILE
+
+#include <linux/io_uring.h>
+#include <thrill/io/request.hpp>
+
+namespace thrill {
+namespace io {
+
+//! \addtogroup io_layer_req
+//! \{
+
+//! Request for an IouringFile.
+class IouringRequest final : public Request
+{
+    //! number of bytes transferred so far, the remainder of a short read or
+    //! write is submitted again.
+    size_type done_ = 0;
+
+public:
+    IouringRequest(
+        const CompletionHandler& on_complete,
+        const FileBasePtr& file,
+        void* buffer, offset_type offset, size_type bytes,
+        ReadOrWriteType type)
+        : Request(on_complete, file, buffer, offset, bytes, type) {
+        assert(dynamic_cast<IouringFile*>(file.get()));
+        LOG << "IouringRequest[" << this << "]" << " IouringRequest"
+            << "(file=" << file << " buffer=" << buffer
+            << " offset=" << offset << " bytes=" << bytes
+            << " type=" << type << ")";
+    }
+
+    //! Fill a submission queue entry for the remaining bytes.
+    void prepare_sqe(io_uring_sqe* sqe);
+
+    //! Process the result of a completion queue entry.
+    //! \returns false if the request must be submitted again.
+    bool handle_result(int res);
+
+    bool cancel() final;
+    void completed(bool posted, bool canceled);
+    void completed(bool canceled) final { completed(true, canceled); }
+};
+
+//! \}
+
+} // namespace io
+} // namespace thrill
+
+#endif // #if THRILL_HAVE_IOURING_FILE
+
+#endif // !THRILL_IO_IOURING_REQUEST_HEADER
+
+/******************************************************************************/
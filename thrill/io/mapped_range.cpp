@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * thrill/io/mapped_range.cpp
+ *
+ * Read-only memory mapping of a range of a file.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <thrill/io/mapped_range.hpp>
+
+#if THRILL_HAVE_MMAP_FILE
+
+#include <thrill/common/logger.hpp>
+#include <thrill/io/error_handling.hpp>
+#include <thrill/io/exceptions.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace thrill {
+namespace io {
+
+MappedRange::MappedRange(
+    const std::string& path, uint64_t offset, size_t size)
+    : addr_(nullptr), length_(0), data_(nullptr), size_(size) {
+
+    static const uint64_t page_size = sysconf(_SC_PAGESIZE);
+
+    // mmap() requires a page aligned file offset
+    uint64_t map_offset = offset / page_size * page_size;
+    length_ = offset - map_offset + size;
+
+    if (size_ == 0) return;
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        THRILL_THROW_ERRNO(IoError, "open() failed. path=" << path);
+    }
+
+    int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+    flags |= MAP_POPULATE;
+#endif
+
+    addr_ = mmap(nullptr, length_, PROT_READ, flags, fd, map_offset);
+    int mmap_errno = errno;
+    // the mapping keeps a reference to the file
+    ::close(fd);
+
+    if (addr_ == MAP_FAILED) {
+        addr_ = nullptr;
+        THRILL_THROW_ERRNO2(IoError,
+                            "mmap() failed. path=" << path <<
+                            " offset=" << offset << " size=" << size,
+                            mmap_errno);
+    }
+
+    if (madvise(addr_, length_, MADV_SEQUENTIAL) != 0) {
+        sLOG1 << "MappedRange: madvise() failed:" << strerror(errno);
+    }
+
+    data_ = reinterpret_cast<const uint8_t*>(addr_) + (offset - map_offset);
+}
+
+MappedRange::~MappedRange() {
+    if (addr_ && munmap(addr_, length_) != 0) {
+        sLOG1 << "MappedRange: munmap() failed:" << strerror(errno);
+    }
+}
+
+} // namespace io
+} // namespace thrill
+
+#endif // THRILL_HAVE_MMAP_FILE
+
+/******************************************************************************/
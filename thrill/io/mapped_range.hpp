@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * thrill/io/mapped_range.hpp
+ *
+ * Read-only memory mapping of a range of a file.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_IO_MAPPED_RANGE_HEADER
+#define THRILL_IO_MAPPED_RANGE_HEADER
+
+#include <thrill/common/config.hpp>
+#include <thrill/common/counting_ptr.hpp>
+
+#include <cstdint>
+#include <string>
+
+#if THRILL_HAVE_MMAP_FILE
+
+namespace thrill {
+namespace io {
+
+//! \addtogroup io_layer
+//! \{
+
+/*!
+ * A read-only memory mapping of a byte range of a file. The pages are
+ * prefaulted with MAP_POPULATE and advised for sequential access, such that the
+ * kernel's page cache serves the data directly without copying it. The
+ * mapping is reference counted and unmapped when the last reference is
+ * released, e.g. by the data::ByteBlocks pointing into it.
+ */
+class MappedRange : public common::ReferenceCount
+{
+public:
+    //! Map the bytes [offset, offset + size) of the file at path. Throws
+    //! IoError if the file cannot be opened or mapped.
+    MappedRange(const std::string& path, uint64_t offset, size_t size);
+
+    //! non-copyable: delete copy-constructor
+    MappedRange(const MappedRange&) = delete;
+    //! non-copyable: delete assignment operator
+    MappedRange& operator = (const MappedRange&) = delete;
+
+    //! unmap the range
+    ~MappedRange();
+
+    //! pointer to the mapped byte at offset
+    const uint8_t * data() const { return data_; }
+
+    //! size of the mapped range
+    size_t size() const { return size_; }
+
+private:
+    //! start of the page aligned mapping
+    void* addr_;
+
+    //! length of the page aligned mapping
+    size_t length_;
+
+    //! pointer to the mapped byte at offset
+    const uint8_t* data_;
+
+    //! size of the mapped range
+    size_t size_;
+};
+
+using MappedRangePtr = common::CountingPtr<MappedRange>;
+
+//! \}
+
+} // namespace io
+} // namespace thrill
+
+#endif // THRILL_HAVE_MMAP_FILE
+
+#endif // !THRILL_IO_MAPPED_RANGE_HEADER
+
+/******************************************************************************/
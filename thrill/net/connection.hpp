@@ -38,6 +38,14 @@ namespace net {
 //! \addtogroup net_layer
 //! \{
 
+//! A memory area passed to Connection::SendVec()
+struct IoVec {
+    //! begin of the memory area
+    const void* data;
+    //! size of the memory area
+    size_t      size;
+};
+
 /*!
  * A Connection represents a link to another peer in a network group. The link
  * need not be an actual stateful TCP connection, but may be reliable and
@@ -98,6 +106,26 @@ public:
     virtual ssize_t SendOne(const void* data, size_t size,
                             Flags flags = NoFlags) = 0;
 
+    //! Non-blocking send of a vector of memory areas, in order. returns number
+    //! of bytes possible to send, check errno for errors. The default
+    //! implementation sends only the first non-empty area.
+    virtual ssize_t SendVec(const IoVec* iov, size_t iovcnt,
+                            Flags flags = NoFlags) {
+        while (iovcnt && iov->size == 0) ++iov, --iovcnt;
+        if (iovcnt == 0) return 0;
+        return SendOne(iov->data, iov->size, flags);
+    }
+
+    //! Number of sends for which the network layer may still read the memory
+    //! areas after SendVec() returned (zero-copy sends). The memory passed to
+    //! SendVec() must remain valid until ZeroCopyCompleted() reaches the value
+    //! ZeroCopySent() had after the call.
+    virtual size_t ZeroCopySent() const { return 0; }
+
+    //! Number of zero-copy sends released by the network layer, see
+    //! ZeroCopySent().
+    virtual size_t ZeroCopyCompleted() { return 0; }
+
     //! Send any serializable POD item T. if sending fails, a net::Exception is
     //! thrown.
     template <typename T>
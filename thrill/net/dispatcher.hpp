@@ -22,6 +22,7 @@
 #include <thrill/net/buffer.hpp>
 #include <thrill/net/connection.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <ctime>
@@ -442,29 +443,59 @@ private:
 
 /******************************************************************************/
 
+/*!
+ * AsyncWriteBlock sends an optional header Buffer followed by an optional
+ * PinnedBlock. Writers queued on the same connection are chained, and the first
+ * unfinished writer sends the remaining data of up to max_batch writers with a
+ * single Connection::SendVec() call.
+ *
+ * If the connection uses zero-copy sends, the writer keeps the header and the
+ * pinned block until the network layer released them, even though the
+ * callback is called once all data was sent.
+ */
 class AsyncWriteBlock
 {
 public:
+    //! maximum number of writers sent by one SendVec() call
+    static constexpr size_t max_batch = 16;
+
     //! Construct block writer with callback
     AsyncWriteBlock(Connection& conn,
                     data::PinnedBlock&& block,
                     const AsyncWriteCallback& callback)
+        : AsyncWriteBlock(conn, Buffer(), std::move(block), callback) { }
+
+    //! Construct header and block writer with callback
+    AsyncWriteBlock(Connection& conn,
+                    Buffer&& header, data::PinnedBlock&& block,
+                    const AsyncWriteCallback& callback)
         : conn_(&conn),
+          header_(std::move(header)),
           block_(std::move(block)),
           callback_(callback)
     { }
 
     //! Should be called when the socket is writable
     bool operator () () {
-        ssize_t r = conn_->SendOne(
-            block_.data_begin() + written_size_,
-            block_.size() - written_size_);
+        // data may have been sent by the batch of a preceding writer.
+        if (IsComplete()) {
+            released_ = true;
+            return false;
+        }
+
+        IoVec iov[2 * max_batch];
+        size_t iovcnt = 0, n = 0;
+        for (AsyncWriteBlock* w = this; w && n < max_batch; w = w->next_, ++n)
+            iovcnt += w->FillIoVec(iov + iovcnt);
+
+        ssize_t r = conn_->SendVec(iov, iovcnt);
 
         if (r <= 0) {
             if (errno == EINTR || errno == EAGAIN) return true;
 
             // signal artificial IsDone, for clean up.
-            written_size_ = block_.size();
+            written_size_ = size();
+            released_ = true;
 
             if (errno == EPIPE) {
                 LOG1 << "AsyncWriteBlock() got SIGPIPE";
@@ -474,10 +505,14 @@ public:
             throw Exception("AsyncWriteBlock() error in send", errno);
         }
 
-        written_size_ += r;
+        // distribute the bytes sent over the writers in the batch
+        size_t zerocopy_seq = conn_->ZeroCopySent();
+        size_t bytes = r;
+        for (AsyncWriteBlock* w = this; bytes != 0; w = w->next_)
+            bytes -= w->Advance(bytes, zerocopy_seq);
 
-        if (written_size_ == block_.size()) {
-            DoCallback();
+        if (IsComplete()) {
+            released_ = true;
             return false;
         }
         else {
@@ -485,30 +520,82 @@ public:
         }
     }
 
-    bool IsDone() const { return written_size_ == block_.size(); }
+    //! whether all data was sent
+    bool IsComplete() const { return written_size_ == size(); }
+
+    //! whether the writer is no longer registered with the dispatcher
+    bool IsReleased() const { return released_; }
+
+    //! whether the writer can be destroyed: it is released, and the network
+    //! layer no longer reads its memory.
+    bool IsDone() {
+        return released_ && (zerocopy_seq_ == 0 ||
+                             conn_->ZeroCopyCompleted() >= zerocopy_seq_);
+    }
 
     void DoCallback() {
         if (callback_) callback_(*conn_);
     }
 
-    //! underlying buffer pointer
-    const uint8_t * data() const { return block_.data_begin(); }
+    //! connection written to
+    Connection * connection() const { return conn_; }
 
-    //! underlying buffer size
-    size_t size() const { return block_.size(); }
+    //! chain the next writer on the same connection to this one
+    void set_next(AsyncWriteBlock* next) { next_ = next; }
+
+    //! total size of header and block
+    size_t size() const { return header_.size() + block_.size(); }
 
 private:
     //! Connection reference
     Connection* conn_;
 
+    //! Send header (owned by this writer)
+    Buffer header_;
+
     //! Send block (holds a pin on the underlying ByteBlock)
     data::PinnedBlock block_;
 
     //! total size currently written
     size_t written_size_ = 0;
 
+    //! whether operator () returned false
+    bool released_ = false;
+
+    //! value of Connection::ZeroCopySent() after the last send of our data
+    size_t zerocopy_seq_ = 0;
+
+    //! next writer queued on the same connection
+    AsyncWriteBlock* next_ = nullptr;
+
     //! functional object to call once data is complete
     AsyncWriteCallback callback_;
+
+    //! Fill in the unsent parts of header and block, returns number of areas
+    size_t FillIoVec(IoVec* iov) const {
+        size_t k = 0, pos = written_size_;
+        if (pos < header_.size()) {
+            iov[k++] = IoVec { header_.data() + pos, header_.size() - pos };
+            pos = 0;
+        }
+        else {
+            pos -= header_.size();
+        }
+        if (pos < block_.size())
+            iov[k++] = IoVec { block_.data_begin() + pos, block_.size() - pos };
+        return k;
+    }
+
+    //! Account for bytes sent by a batch, returns bytes consumed by this writer
+    size_t Advance(size_t bytes, size_t zerocopy_seq) {
+        size_t n = std::min(bytes, size() - written_size_);
+        if (n == 0) return 0;
+        written_size_ += n;
+        zerocopy_seq_ = zerocopy_seq;
+        // callback for writers completed by the batch of a preceding writer
+        if (IsComplete()) DoCallback();
+        return n;
+    }
 };
 
 /******************************************************************************/
@@ -622,20 +709,7 @@ public:
     virtual void AsyncWrite(
         Connection& c, Buffer&& buffer,
         const AsyncWriteCallback& done_cb = AsyncWriteCallback()) {
-        assert(c.IsValid());
-
-        if (buffer.size() == 0) {
-            if (done_cb) done_cb(c);
-            return;
-        }
-
-        // add new async writer object
-        async_write_.emplace_back(c, std::move(buffer), done_cb);
-
-        // register write callback
-        AsyncWriteBuffer& awb = async_write_.back();
-        AddWrite(c, AsyncCallback::make<
-                     AsyncWriteBuffer, & AsyncWriteBuffer::operator ()>(&awb));
+        return AsyncWrite(c, std::move(buffer), data::PinnedBlock(), done_cb);
     }
 
     //! asynchronously write buffer and callback when delivered. The buffer is
@@ -643,18 +717,41 @@ public:
     virtual void AsyncWrite(
         Connection& c, data::PinnedBlock&& block,
         const AsyncWriteCallback& done_cb = AsyncWriteCallback()) {
+        return AsyncWrite(c, Buffer(), std::move(block), done_cb);
+    }
+
+    //! asynchronously write header buffer and block in order and callback when
+    //! both are delivered. Both are MOVED into the async writer. Successive
+    //! writes to the same connection are batched into vectored sends.
+    virtual void AsyncWrite(
+        Connection& c, Buffer&& buffer, data::PinnedBlock&& block,
+        const AsyncWriteCallback& done_cb = AsyncWriteCallback()) {
         assert(c.IsValid());
 
-        if (block.size() == 0) {
+        if (buffer.size() == 0 && block.size() == 0) {
             if (done_cb) done_cb(c);
             return;
         }
 
+        // find the last writer queued on the same connection, all writes go
+        // through async_write_block_ to keep them in order.
+        AsyncWriteBlock* prev = nullptr;
+        size_t scan = async_write_block_.size();
+        if (scan > batch_scan_) scan = batch_scan_;
+        for (auto it = async_write_block_.rbegin(); scan != 0; ++it, --scan) {
+            if (it->connection() == &c) {
+                if (!it->IsReleased()) prev = &(*it);
+                break;
+            }
+        }
+
         // add new async writer object
-        async_write_block_.emplace_back(c, std::move(block), done_cb);
+        async_write_block_.emplace_back(
+            c, std::move(buffer), std::move(block), done_cb);
 
-        // register write callback
+        // chain to previous writer for batching and register write callback
         AsyncWriteBlock& awb = async_write_block_.back();
+        if (prev) prev->set_next(&awb);
         AddWrite(c, AsyncCallback::make<
                      AsyncWriteBlock, & AsyncWriteBlock::operator ()>(&awb));
     }
@@ -700,16 +797,24 @@ public:
 
         if (terminate_) return;
 
+        // poll for the release of zero-copy sends, which only wake up the
+        // dispatcher while the connection is watched.
+        milliseconds max_wait(10000);
+        if (async_write_block_.size() && async_write_block_.front().IsReleased())
+            max_wait = milliseconds(1);
+
         // calculate time until next timer event
         if (timer_pq_.empty()) {
-            LOG << "Dispatch(): empty timer queue - selecting for 10s";
-            DispatchOne(milliseconds(10000));
+            LOG << "Dispatch(): empty timer queue - selecting for "
+                << max_wait.count() << "ms";
+            DispatchOne(max_wait);
         }
         else {
             auto diff = std::chrono::duration_cast<milliseconds>(
                 timer_pq_.top().next_timeout - now);
 
             if (diff < milliseconds(1)) diff = milliseconds(1);
+            if (diff > max_wait) diff = max_wait;
 
             sLOG << "Dispatch(): waiting" << diff.count() << "ms";
             DispatchOne(diff);
@@ -719,9 +824,6 @@ public:
         while (async_read_.size() && async_read_.front().IsDone()) {
             async_read_.pop_front();
         }
-        while (async_write_.size() && async_write_.front().IsDone()) {
-            async_write_.pop_front();
-        }
 
         while (async_read_block_.size() && async_read_block_.front().IsDone()) {
             async_read_block_.pop_front();
@@ -750,7 +852,7 @@ public:
 
     //! Check whether there are still AsyncWrite()s in the queue.
     bool HasAsyncWrites() const {
-        return (async_write_.size() != 0) || (async_write_block_.size() != 0);
+        return async_write_block_.size() != 0;
     }
 
     //! \}
@@ -865,18 +967,18 @@ protected:
     std::deque<AsyncReadBuffer,
                mem::GPoolAllocator<AsyncReadBuffer> > async_read_;
 
-    //! deque of asynchronous writers
-    std::deque<AsyncWriteBuffer,
-               mem::GPoolAllocator<AsyncWriteBuffer> > async_write_;
-
     //! deque of asynchronous readers
     std::deque<AsyncReadByteBlock,
                mem::GPoolAllocator<AsyncReadByteBlock> > async_read_block_;
 
-    //! deque of asynchronous writers
+    //! deque of asynchronous writers, of both Buffers and Blocks
     std::deque<AsyncWriteBlock,
                mem::GPoolAllocator<AsyncWriteBlock> > async_write_block_;
 
+    //! number of writers at the end of async_write_block_ scanned for one on
+    //! the same connection to batch with.
+    static constexpr size_t batch_scan_ = 64;
+
     //! Default exception handler
     static bool ExceptionCallback(Connection& c) {
         // exception on listen socket ?
@@ -126,8 +126,8 @@ void DispatcherThread::AsyncWrite(
     // the following captures the move-only buffer in a lambda.
     Enqueue([=, &c,
              b1 = std::move(buffer), b2 = std::move(block)]() mutable {
-                dispatcher_->AsyncWrite(c, std::move(b1));
-                dispatcher_->AsyncWrite(c, std::move(b2), done_cb);
+                dispatcher_->AsyncWrite(
+                    c, std::move(b1), std::move(b2), done_cb);
             });
     WakeUpThread();
 }
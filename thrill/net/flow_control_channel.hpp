@@ -420,6 +420,43 @@ public:
         return local;
     }
 
+    /*!
+     * Broadcasts a value of type T from one worker thread to all other worker
+     * threads on the same host. No network communication is performed, hence T
+     * need not be serializable and may be, e.g., a shared pointer to a
+     * host-global data structure.
+     *
+     * This method is blocking on all local workers.
+     *
+     * \param value The value to broadcast. This value is ignored for each
+     * worker except the origin.
+     *
+     * \param origin Local worker id to broadcast value from.
+     *
+     * \return The value sent by the origin worker.
+     */
+    template <typename T>
+    T THRILL_ATTRIBUTE_WARN_UNUSED_RESULT
+    LocalBroadcast(const T& value, size_t origin = 0) {
+
+        assert(origin < thread_count_);
+        T local = value;
+
+        size_t step = GetNextStep();
+        SetLocalShared(step, &local);
+
+        barrier_.Await(
+            [&]() {
+                // copy from origin worker to all others
+                T res = *GetLocalShared<T>(step, origin);
+                for (size_t i = 0; i < thread_count_; i++) {
+                    *GetLocalShared<T>(step, i) = res;
+                }
+            });
+
+        return local;
+    }
+
     /*!
      * Reduces a value of a serializable type T over all workers to the given
      * worker, provided a certain reduce function.
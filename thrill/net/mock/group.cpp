@@ -83,6 +83,18 @@ ssize_t Connection::SendOne(const void* data, size_t size, Flags flags) {
     return size;
 }
 
+ssize_t Connection::SendVec(const IoVec* iov, size_t iovcnt, Flags flags) {
+    // virtual sockets accept all data, hence the whole vector is sent at once
+    // and the dispatcher need not be notified again.
+    ssize_t total = 0;
+    for (size_t i = 0; i < iovcnt; ++i) {
+        if (iov[i].size == 0) continue;
+        SyncSend(iov[i].data, iov[i].size, flags);
+        total += iov[i].size;
+    }
+    return total;
+}
+
 net::Buffer Connection::RecvNext() {
     std::unique_lock<std::mutex> lock(d_->mutex_);
     d_->cv_.wait(lock, [=]() { return !d_->inbound_.empty(); });
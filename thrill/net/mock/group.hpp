@@ -67,6 +67,11 @@ public:
     ssize_t SendOne(
         const void* data, size_t size, Flags flags = NoFlags) final;
 
+    //! sends each memory area as a separate message, since receivers read
+    //! header and Block as separate messages.
+    ssize_t SendVec(
+        const IoVec* iov, size_t iovcnt, Flags flags = NoFlags) final;
+
     //! \}
 
     //! \name Receive Functions
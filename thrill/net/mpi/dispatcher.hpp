@@ -144,6 +144,14 @@ public:
         mpi_async_out_.emplace_back();
     }
 
+    void AsyncWrite(
+        net::Connection& c, Buffer&& buffer, data::PinnedBlock&& block,
+        const AsyncWriteCallback& done_cb = AsyncWriteCallback()) final {
+        // MPI has no vectored sends, issue the two Isends in order.
+        AsyncWrite(c, std::move(buffer));
+        AsyncWrite(c, std::move(block), done_cb);
+    }
+
     MPI_Request IRecv(Connection& c, void* data, size_t size);
 
     void AsyncRead(net::Connection& c, size_t size,
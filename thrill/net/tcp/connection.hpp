@@ -17,12 +17,15 @@
 
 #include <thrill/common/config.hpp>
 #include <thrill/net/connection.hpp>
+#include <thrill/net/tcp/shm_channel.hpp>
 #include <thrill/net/tcp/socket.hpp>
 
 #include <cassert>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
+#include <map>
+#include <memory>
 #include <string>
 
 namespace thrill {
@@ -50,6 +53,10 @@ enum ConnectionState : unsigned {
  * If any function fails to send or receive, then a NetException is thrown
  * instead of explicit error handling. If ever an error occurs, we probably have
  * to rebuild the whole network explicitly.
+ *
+ * If the peer runs on the same machine, a ShmChannel may be attached, which
+ * then carries all data instead of the socket. The socket stays open as handle
+ * of the connection.
  */
 class Connection final : public net::Connection
 {
@@ -77,6 +84,14 @@ public:
           state_(other.state_),
           group_id_(other.group_id_),
           peer_id_(other.peer_id_) {
+#if THRILL_HAVE_NET_SHM
+        shm_ = std::move(other.shm_);
+#endif
+        zerocopy_ = other.zerocopy_;
+        zerocopy_threshold_ = other.zerocopy_threshold_;
+        zerocopy_sent_ = other.zerocopy_sent_;
+        zerocopy_completed_ = other.zerocopy_completed_;
+        zerocopy_ranges_ = std::move(other.zerocopy_ranges_);
         other.state_ = ConnectionState::Invalid;
     }
 
@@ -90,6 +105,14 @@ public:
         state_ = other.state_;
         group_id_ = other.group_id_;
         peer_id_ = other.peer_id_;
+#if THRILL_HAVE_NET_SHM
+        shm_ = std::move(other.shm_);
+#endif
+        zerocopy_ = other.zerocopy_;
+        zerocopy_threshold_ = other.zerocopy_threshold_;
+        zerocopy_sent_ = other.zerocopy_sent_;
+        zerocopy_completed_ = other.zerocopy_completed_;
+        zerocopy_ranges_ = std::move(other.zerocopy_ranges_);
 
         other.state_ = ConnectionState::Invalid;
         return *this;
@@ -134,6 +157,41 @@ public:
     const Socket& GetSocket() const
     { return socket_; }
 
+#if THRILL_HAVE_NET_SHM
+    //! Attach a shared memory channel to the same peer, which carries all
+    //! further data of this connection.
+    void AttachShm(std::unique_ptr<ShmChannel> shm)
+    { shm_ = std::move(shm); }
+#endif
+
+    //! Whether data is exchanged via a shared memory channel
+    bool IsShm() const {
+#if THRILL_HAVE_NET_SHM
+        return shm_ != nullptr;
+#else
+        return false;
+#endif
+    }
+
+    //! File descriptor which is readable while data can be received: the
+    //! socket or the shared memory channel's notifier.
+    int GetReadFd() const {
+#if THRILL_HAVE_NET_SHM
+        if (shm_) return shm_->read_fd();
+#endif
+        return socket_.fd();
+    }
+
+    //! File descriptor which signals that data can be sent: the socket, which
+    //! becomes writable, or the shared memory channel's notifier, which becomes
+    //! readable.
+    int GetWriteFd() const {
+#if THRILL_HAVE_NET_SHM
+        if (shm_) return shm_->write_fd();
+#endif
+        return socket_.fd();
+    }
+
     //! Return the associated socket error
     int GetError() const
     { return socket_.GetError(); }
@@ -160,6 +218,14 @@ public:
     }
 
     void SyncSend(const void* data, size_t size, Flags flags) final {
+#if THRILL_HAVE_NET_SHM
+        if (shm_) {
+            if (shm_->SyncSend(data, size) != static_cast<ssize_t>(size))
+                throw Exception("Error during SyncSend", errno);
+            tx_bytes_ += size;
+            return;
+        }
+#endif
         SetNonBlocking(false);
         int f = 0;
         if (flags & MsgMore) f |= MSG_MORE;
@@ -169,6 +235,13 @@ public:
     }
 
     ssize_t SendOne(const void* data, size_t size, Flags flags) final {
+#if THRILL_HAVE_NET_SHM
+        if (shm_) {
+            ssize_t wb = shm_->SendOne(data, size);
+            if (wb > 0) tx_bytes_ += wb;
+            return wb;
+        }
+#endif
 #if __APPLE__
         // MacOSX has no MSG_DONTWAIT
         SetNonBlocking(true);
@@ -180,7 +253,99 @@ public:
         return wb;
     }
 
+    ssize_t SendVec(const IoVec* iov, size_t iovcnt, Flags flags) final {
+#if THRILL_HAVE_NET_SHM
+        if (shm_) {
+            // copy areas into the ring until it is full
+            ssize_t wb = 0;
+            for (size_t i = 0; i < iovcnt; ++i) {
+                if (iov[i].size == 0) continue;
+                ssize_t r = shm_->SendOne(iov[i].data, iov[i].size);
+                if (r < 0) {
+                    if (wb == 0) return r;
+                    break;
+                }
+                wb += r;
+                if (static_cast<size_t>(r) != iov[i].size) break;
+            }
+            tx_bytes_ += wb;
+            return wb;
+        }
+#endif
+#if __APPLE__
+        // MacOSX has no MSG_DONTWAIT
+        SetNonBlocking(true);
+#endif
+        struct iovec vec[max_iovcnt];
+        size_t n = 0, total = 0;
+        for ( ; n < iovcnt && n < max_iovcnt; ++n) {
+            vec[n].iov_base = const_cast<void*>(iov[n].data);
+            vec[n].iov_len = iov[n].size;
+            total += iov[n].size;
+        }
+
+        int f = MSG_DONTWAIT;
+        if (flags & MsgMore) f |= MSG_MORE;
+#if defined(MSG_ZEROCOPY)
+        bool zerocopy = zerocopy_ && total >= zerocopy_threshold_;
+        if (zerocopy) f |= MSG_ZEROCOPY;
+#else
+        bool zerocopy = false;
+#endif
+        ssize_t wb = socket_.sendmsg_one(vec, n, f);
+        if (wb > 0) {
+            tx_bytes_ += wb;
+            if (zerocopy) ++zerocopy_sent_;
+        }
+        return wb;
+    }
+
+    //! Enable MSG_ZEROCOPY for SendVec() calls of at least threshold bytes.
+    //! Returns false if the socket does not support it.
+    bool EnableZeroCopy(size_t threshold) {
+        zerocopy_ = !IsShm() && socket_.SetZeroCopy(true);
+        zerocopy_threshold_ = threshold;
+        return zerocopy_;
+    }
+
+    size_t ZeroCopySent() const final { return zerocopy_sent_; }
+
+    size_t ZeroCopyCompleted() final {
+        if (zerocopy_completed_ == zerocopy_sent_ || !IsValid())
+            return zerocopy_sent_;
+
+        uint32_t lo, hi;
+        bool copied;
+        while (socket_.RecvZeroCopyCompletion(&lo, &hi, &copied)) {
+            // extend the kernel's 32-bit send counters, ranges may arrive out
+            // of order but never before zerocopy_completed_.
+            size_t lo64 = zerocopy_completed_ + static_cast<uint32_t>(
+                lo - static_cast<uint32_t>(zerocopy_completed_));
+            zerocopy_ranges_[lo64] = lo64 + static_cast<uint32_t>(hi - lo) + 1;
+
+            // the kernel copied the data anyway, e.g. on loopback devices:
+            // stop paying for the notifications.
+            if (copied) zerocopy_ = false;
+        }
+
+        // advance over contiguous completed ranges
+        while (!zerocopy_ranges_.empty() &&
+               zerocopy_ranges_.begin()->first == zerocopy_completed_) {
+            zerocopy_completed_ = zerocopy_ranges_.begin()->second;
+            zerocopy_ranges_.erase(zerocopy_ranges_.begin());
+        }
+        return zerocopy_completed_;
+    }
+
     void SyncRecv(void* out_data, size_t size) final {
+#if THRILL_HAVE_NET_SHM
+        if (shm_) {
+            if (shm_->SyncRecv(out_data, size) != static_cast<ssize_t>(size))
+                throw Exception("Error during SyncRecv", errno);
+            rx_bytes_ += size;
+            return;
+        }
+#endif
         SetNonBlocking(false);
         if (socket_.recv(out_data, size) != static_cast<ssize_t>(size))
             throw Exception("Error during SyncRecv", errno);
@@ -188,6 +353,13 @@ public:
     }
 
     ssize_t RecvOne(void* out_data, size_t size) final {
+#if THRILL_HAVE_NET_SHM
+        if (shm_) {
+            ssize_t rb = shm_->RecvOne(out_data, size);
+            if (rb > 0) rx_bytes_ += rb;
+            return rb;
+        }
+#endif
 #if __APPLE__
         // MacOSX has no MSG_DONTWAIT
         SetNonBlocking(true);
@@ -205,6 +377,9 @@ public:
 
     //! Close this Connection
     void Close() {
+#if THRILL_HAVE_NET_SHM
+        shm_.reset();
+#endif
         socket_.close();
     }
 
@@ -215,6 +390,8 @@ public:
 
         if (IsValid())
             os << " peer=" << GetPeerAddress();
+        if (IsShm())
+            os << " shm";
 
         return os << "]";
     }
@@ -232,6 +409,26 @@ private:
 
     //! The id of the worker this connection is connected to.
     size_t peer_id_ = size_t(-1);
+
+#if THRILL_HAVE_NET_SHM
+    //! Shared memory channel replacing the socket's data path, if attached.
+    std::unique_ptr<ShmChannel> shm_;
+#endif
+
+    //! maximum number of memory areas sent by one SendVec() call
+    static constexpr size_t max_iovcnt = 64;
+
+    //! whether SendVec() uses MSG_ZEROCOPY for large sends
+    bool zerocopy_ = false;
+
+    //! minimum size of a SendVec() call to use MSG_ZEROCOPY
+    size_t zerocopy_threshold_ = 0;
+
+    //! number of MSG_ZEROCOPY sends, and number of sends released by the kernel
+    size_t zerocopy_sent_ = 0, zerocopy_completed_ = 0;
+
+    //! released ranges [first,second) of sends beyond zerocopy_completed_
+    std::map<size_t, size_t> zerocopy_ranges_;
 };
 
 // \}
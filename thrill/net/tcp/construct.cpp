@@ -14,8 +14,14 @@
 #include <thrill/net/tcp/construct.hpp>
 #include <thrill/net/tcp/group.hpp>
 #include <thrill/net/tcp/select_dispatcher.hpp>
+#include <thrill/net/tcp/shm_channel.hpp>
 
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
 #include <deque>
+#include <fstream>
 #include <map>
 #include <string>
 #include <utility>
@@ -105,6 +111,14 @@ public:
         // All connected, Dispose listener.
         listener_.Close();
 
+#if THRILL_HAVE_NET_SHM
+        // Switch connections to peers on the same machine to shared memory.
+        ConnectSharedMemory();
+#endif
+
+        // Optionally switch socket connections to zero-copy sends.
+        EnableZeroCopy();
+
         LOG << "Client " << my_rank_ << " done";
 
         for (size_t j = 0; j < group_count_; j++) {
@@ -220,6 +234,110 @@ private:
         return true;
     }
 
+#if THRILL_HAVE_NET_SHM
+    //! Return an identifier of this machine and its current boot, or an empty
+    //! string if it cannot be determined.
+    static std::string MachineId() {
+        char hostname[256];
+        if (gethostname(hostname, sizeof(hostname)) != 0) return std::string();
+        hostname[sizeof(hostname) - 1] = 0;
+
+        std::string boot_id;
+        std::ifstream in("/proc/sys/kernel/random/boot_id");
+        if (!(in >> boot_id)) return std::string();
+
+        return std::string(hostname) + "/" + boot_id;
+    }
+
+    //! Send a length-prefixed string synchronously
+    static void SyncSendString(Connection& c, const std::string& str) {
+        uint32_t size = static_cast<uint32_t>(str.size());
+        c.SyncSend(&size, sizeof(size), net::Connection::NoFlags);
+        if (size) c.SyncSend(str.data(), size, net::Connection::NoFlags);
+    }
+
+    //! Receive a length-prefixed string synchronously
+    static std::string SyncRecvString(Connection& c) {
+        uint32_t size;
+        c.SyncRecv(&size, sizeof(size));
+        std::string str(size, 0);
+        if (size) c.SyncRecv(&str[0], size);
+        return str;
+    }
+
+    /*!
+     * Exchanges machine identifiers with all peers and attaches a ShmChannel
+     * to each connection whose peer runs on the same machine. The lower rank
+     * creates the channel and sends its name, the higher rank opens it and
+     * confirms. If anything fails, the pair keeps using the socket.
+     *
+     * All hosts process their peers in increasing rank, which orders all pairs
+     * consistently. Hence, the synchronous exchange cannot deadlock.
+     */
+    void ConnectSharedMemory() {
+        const std::string machine_id =
+            ShmChannel::Enabled() ? MachineId() : std::string();
+
+        for (size_t g = 0; g < group_count_; g++) {
+            for (size_t id = 0; id < groups_[g]->num_hosts(); ++id) {
+                if (id == my_rank_) continue;
+                Connection& c = groups_[g]->tcp_connection(id);
+
+                SyncSendString(c, machine_id);
+                std::string peer_machine_id = SyncRecvString(c);
+
+                if (machine_id.empty() || peer_machine_id != machine_id)
+                    continue;
+
+                std::unique_ptr<ShmChannel> shm;
+                if (my_rank_ < id) {
+                    std::string name = ShmChannel::MakeName();
+                    shm = ShmChannel::Create(name);
+                    SyncSendString(c, shm ? name : std::string());
+
+                    uint8_t ok;
+                    c.SyncRecv(&ok, sizeof(ok));
+                    if (shm) ShmChannel::Unlink(name);
+                    if (!ok) shm.reset();
+                }
+                else {
+                    std::string name = SyncRecvString(c);
+                    if (!name.empty()) shm = ShmChannel::Open(name);
+
+                    uint8_t ok = (shm != nullptr);
+                    c.SyncSend(&ok, sizeof(ok), net::Connection::NoFlags);
+                }
+
+                LOG << "Client " << my_rank_ << " group " << g
+                    << " link to " << id << " via shared memory: " << !!shm;
+
+                if (shm) c.AttachShm(std::move(shm));
+            }
+        }
+    }
+#endif
+
+    //! minimum size of vectored sends to use zero-copy for
+    static constexpr size_t zerocopy_threshold_ = 16 * 1024;
+
+    //! Enables MSG_ZEROCOPY sends on all socket connections, if
+    //! THRILL_NET_ZEROCOPY is set and not 0.
+    void EnableZeroCopy() {
+        const char* env = getenv("THRILL_NET_ZEROCOPY");
+        if (!env || !*env || strcmp(env, "0") == 0) return;
+
+        for (size_t g = 0; g < group_count_; g++) {
+            for (size_t id = 0; id < groups_[g]->num_hosts(); ++id) {
+                if (id == my_rank_) continue;
+                Connection& c = groups_[g]->tcp_connection(id);
+                if (c.IsShm()) continue;
+                if (!c.EnableZeroCopy(zerocopy_threshold_))
+                    LOG << "Client " << my_rank_ << " group " << g
+                        << " link to " << id << " has no zero-copy sends";
+            }
+        }
+    }
+
     /*!
      * Starts connecting to the net connection specified. Starts connecting to
      * the endpoint specified by the parameters.  This method executes
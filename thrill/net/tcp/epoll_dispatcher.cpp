@@ -0,0 +1,182 @@
+/*******************************************************************************
+ * thrill/net/tcp/epoll_dispatcher.cpp
+ *
+ * Asynchronous callback wrapper around edge-triggered epoll()
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2015 Timo Bingmann <tb@panthema.net>
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <thrill/net/tcp/epoll_dispatcher.hpp>
+
+#if THRILL_HAVE_NET_EPOLL
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+
+namespace thrill {
+namespace net {
+namespace tcp {
+
+EpollDispatcher::EpollDispatcher(mem::Manager& mem_manager)
+    : net::Dispatcher(mem_manager) {
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0)
+        throw Exception("EpollDispatcher() could not create epoll fd", errno);
+
+    event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd_ < 0)
+        throw Exception("EpollDispatcher() could not create eventfd", errno);
+
+    // Ignore PIPE signals (received when writing to closed sockets)
+    signal(SIGPIPE, SIG_IGN);
+
+    // wait interrupts via eventfd.
+    AddRead(event_fd_,
+            Callback::make<EpollDispatcher,
+                           & EpollDispatcher::EventFdCallback>(this));
+}
+
+EpollDispatcher::~EpollDispatcher() {
+    ::close(event_fd_);
+    ::close(epoll_fd_);
+}
+
+void EpollDispatcher::Update(int fd) {
+    Watch& w = watch_[fd];
+
+    uint32_t events = 0;
+    if (w.read_cb.size()) events |= EPOLLIN | EPOLLRDHUP;
+    if (w.write_cb.size()) events |= EPOLLOUT;
+    if (events || w.except_cb) events |= EPOLLPRI | EPOLLET;
+
+    if (events == 0) {
+        // stop listening, also for the implicit EPOLLERR and EPOLLHUP events.
+        // the fd may already have been closed, which removed it from epoll.
+        if (w.events != 0)
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+        w.events = 0;
+        return;
+    }
+
+    struct epoll_event ev;
+    ev.events = events;
+    ev.data.fd = fd;
+
+    // modifying the registration rechecks readiness and generates a new edge
+    // if data is already available.
+    int r = epoll_ctl(
+        epoll_fd_, w.events != 0 ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &ev);
+
+    if (r != 0 && w.events != 0 && errno == ENOENT) {
+        // fd was closed and reused without Cancel()
+        r = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+    }
+    if (r != 0)
+        throw Exception("EpollDispatcher() epoll_ctl() failed", errno);
+
+    w.events = events;
+}
+
+void EpollDispatcher::RunCallbacks(int fd, mem::deque<Callback> Watch::* queue) {
+    // the watch_ table may regrow when callback handlers are called, hence we
+    // have to look up the Watch again after each callback. run callbacks until
+    // one returns true (in which case it wants to be called again at the next
+    // edge), or the queue is empty.
+    while ((watch_[fd].*queue).size() && (watch_[fd].*queue).front()() == false)
+        (watch_[fd].*queue).pop_front();
+
+    // if all callbacks are done, listen no longer.
+    if ((watch_[fd].*queue).size() == 0)
+        Update(fd);
+}
+
+//! Run one iteration of dispatching epoll_wait().
+void EpollDispatcher::DispatchOne(const std::chrono::milliseconds& timeout) {
+
+    int r = epoll_wait(epoll_fd_, events_.data(),
+                       static_cast<int>(events_.size()),
+                       static_cast<int>(timeout.count()));
+
+    if (r < 0) {
+        // if we caught a signal, this is intended to interrupt an epoll_wait().
+        if (errno == EINTR) {
+            LOG << "Dispatch(): epoll_wait() was interrupted due to a signal.";
+            return;
+        }
+
+        throw Exception("Dispatch::epoll_wait() failed!", errno);
+    }
+
+    LOG << "EpollDispatcher::DispatchOne() " << r << " events";
+
+    for (int i = 0; i < r; ++i)
+    {
+        int fd = events_[i].data.fd;
+        uint32_t ev = events_[i].events;
+
+        // fd may have been cancelled by a previous callback
+        if (watch_[fd].events == 0) continue;
+
+        // errors and hang-ups are passed on to the read and write callbacks,
+        // which detect them when calling recv() or send().
+        if (ev & (EPOLLIN | EPOLLRDHUP | EPOLLERR | EPOLLHUP)) {
+            if (watch_[fd].read_cb.size())
+                RunCallbacks(fd, &Watch::read_cb);
+        }
+
+        if (ev & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
+            if (watch_[fd].write_cb.size())
+                RunCallbacks(fd, &Watch::write_cb);
+        }
+
+        if ((ev & (EPOLLPRI | EPOLLERR)) && watch_[fd].except_cb)
+        {
+            if (!watch_[fd].except_cb()) {
+                // callback returned false: remove exception callback
+                watch_[fd].except_cb = Callback();
+                Update(fd);
+            }
+        }
+    }
+
+    // grow events buffer if it was filled completely
+    if (static_cast<size_t>(r) == events_.size())
+        events_.resize(2 * events_.size());
+}
+
+void EpollDispatcher::Interrupt() {
+    // increment the eventfd counter to wake up the epoll_wait() handler.
+    uint64_t one = 1;
+    ssize_t wb;
+    while ((wb = write(event_fd_, &one, sizeof(one))) < 0 && errno == EINTR) {
+        LOG1 << "WakeUp: error sending to eventfd: " << errno;
+    }
+    die_unless(wb == sizeof(one));
+}
+
+bool EpollDispatcher::EventFdCallback() {
+    // reading resets the counter, after which a new edge is generated by the
+    // next Interrupt().
+    uint64_t counter;
+    while (read(event_fd_, &counter, sizeof(counter)) > 0) {
+        /* repeat, until counter is zero */
+    }
+    return true;
+}
+
+} // namespace tcp
+} // namespace net
+} // namespace thrill
+
+#endif // THRILL_HAVE_NET_EPOLL
+
+/******************************************************************************/
@@ -0,0 +1,197 @@
+/*******************************************************************************
+ * thrill/net/tcp/epoll_dispatcher.hpp
+ *
+ * Asynchronous callback wrapper around edge-triggered epoll()
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2015 Timo Bingmann <tb@panthema.net>
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_NET_TCP_EPOLL_DISPATCHER_HEADER
+#define THRILL_NET_TCP_EPOLL_DISPATCHER_HEADER
+
+#include <thrill/common/config.hpp>
+
+#if THRILL_HAVE_NET_EPOLL
+
+#include <thrill/common/delegate.hpp>
+#include <thrill/common/die.hpp>
+#include <thrill/common/logger.hpp>
+#include <thrill/mem/allocator.hpp>
+#include <thrill/net/connection.hpp>
+#include <thrill/net/dispatcher.hpp>
+#include <thrill/net/exception.hpp>
+#include <thrill/net/tcp/connection.hpp>
+#include <thrill/net/tcp/socket.hpp>
+
+#include <sys/epoll.h>
+
+#include <chrono>
+#include <deque>
+#include <vector>
+
+namespace thrill {
+namespace net {
+namespace tcp {
+
+//! \addtogroup net_tcp TCP Socket API
+//! \{
+
+/*!
+ * EpollDispatcher is a drop-in replacement for SelectDispatcher on Linux which
+ * uses edge-triggered epoll() and an eventfd for interrupts. Unlike select(),
+ * the cost of one dispatch iteration depends only on the number of ready file
+ * descriptors, not on the number of registered ones.
+ *
+ * A file descriptor is watched for readability (writability) only while read
+ * (write) callbacks are queued. Callbacks are run until one returns true,
+ * which means it has read (written) all currently available data and waits
+ * for the next edge. Changing the interest set with epoll_ctl() rechecks the
+ * readiness, hence no edges are lost when callbacks are added later.
+ */
+class EpollDispatcher final : public net::Dispatcher
+{
+    static constexpr bool debug = false;
+
+public:
+    //! type for file descriptor readiness callbacks
+    using Callback = AsyncCallback;
+
+    //! constructor
+    explicit EpollDispatcher(mem::Manager& mem_manager);
+
+    //! destructor
+    ~EpollDispatcher();
+
+    //! Register a buffered read callback and a default exception callback.
+    void AddRead(int fd, const Callback& read_cb) {
+        CheckSize(fd);
+        Watch& w = watch_[fd];
+        w.read_cb.emplace_back(read_cb);
+        if (w.read_cb.size() == 1) Update(fd);
+    }
+
+    //! Register a buffered read callback and a default exception callback.
+    void AddRead(net::Connection& c, const Callback& read_cb) final {
+        assert(dynamic_cast<Connection*>(&c));
+        Connection& tc = static_cast<Connection&>(c);
+        return AddRead(tc.GetReadFd(), read_cb);
+    }
+
+    //! Register a buffered write callback and a default exception callback.
+    void AddWrite(net::Connection& c, const Callback& write_cb) final {
+        assert(dynamic_cast<Connection*>(&c));
+        Connection& tc = static_cast<Connection&>(c);
+        int fd = tc.GetWriteFd();
+        // a shared memory channel's notifier is readable if data can be sent
+        if (tc.IsShm()) return AddRead(fd, write_cb);
+        CheckSize(fd);
+        Watch& w = watch_[fd];
+        w.write_cb.emplace_back(write_cb);
+        if (w.write_cb.size() == 1) Update(fd);
+    }
+
+    //! Register an exception callback.
+    void SetExcept(net::Connection& c, const Callback& except_cb) {
+        assert(dynamic_cast<Connection*>(&c));
+        Connection& tc = static_cast<Connection&>(c);
+        int fd = tc.GetSocket().fd();
+        CheckSize(fd);
+        watch_[fd].except_cb = except_cb;
+        Update(fd);
+    }
+
+    //! Cancel all callbacks on a given connection.
+    void Cancel(net::Connection& c) final {
+        assert(dynamic_cast<Connection*>(&c));
+        Connection& tc = static_cast<Connection&>(c);
+        Cancel(tc.GetSocket().fd());
+        if (tc.IsShm()) {
+            Cancel(tc.GetReadFd());
+            Cancel(tc.GetWriteFd());
+        }
+    }
+
+    //! Cancel all callbacks on a given fd.
+    void Cancel(int fd) {
+        CheckSize(fd);
+
+        Watch& w = watch_[fd];
+        if (w.read_cb.size() == 0 && w.write_cb.size() == 0)
+            LOG << "EpollDispatcher::Cancel() fd=" << fd
+                << " called with no callbacks registered.";
+
+        w.read_cb.clear();
+        w.write_cb.clear();
+        w.except_cb = Callback();
+        Update(fd);
+    }
+
+    //! Run one iteration of dispatching epoll_wait().
+    void DispatchOne(const std::chrono::milliseconds& timeout) final;
+
+    //! Interrupt the current epoll_wait() via the eventfd
+    void Interrupt() final;
+
+private:
+    //! epoll file descriptor
+    int epoll_fd_;
+
+    //! eventfd to wake up epoll_wait().
+    int event_fd_;
+
+    //! callback vectors per watched file descriptor
+    struct Watch {
+        //! events currently registered with epoll, 0 if not registered
+        uint32_t             events = 0;
+        //! queue of callbacks for fd.
+        mem::deque<Callback> read_cb, write_cb;
+        //! only one exception callback for the fd.
+        Callback             except_cb;
+
+        explicit Watch(mem::Manager& mem_manager)
+            : read_cb(mem::Allocator<Callback>(mem_manager)),
+              write_cb(mem::Allocator<Callback>(mem_manager)) { }
+    };
+
+    //! handlers for all registered file descriptors.
+    mem::vector<Watch> watch_ { mem::Allocator<Watch>(mem_manager_) };
+
+    //! buffer for events returned by epoll_wait()
+    mem::vector<struct epoll_event> events_ {
+        64, mem::Allocator<struct epoll_event>(mem_manager_)
+    };
+
+    //! Grow table if needed
+    void CheckSize(int fd) {
+        assert(fd >= 0);
+        if (static_cast<size_t>(fd) >= watch_.size())
+            watch_.resize(fd + 1, Watch(mem_manager_));
+    }
+
+    //! Update the events registered with epoll to the queued callbacks.
+    void Update(int fd);
+
+    //! Run the queued callbacks in a queue until one returns true.
+    void RunCallbacks(int fd, mem::deque<Callback> Watch::* queue);
+
+    //! eventfd callback
+    bool EventFdCallback();
+};
+
+//! \}
+
+} // namespace tcp
+} // namespace net
+} // namespace thrill
+
+#endif // THRILL_HAVE_NET_EPOLL
+
+#endif // !THRILL_NET_TCP_EPOLL_DISPATCHER_HEADER
+
+/******************************************************************************/
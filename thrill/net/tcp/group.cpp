@@ -12,10 +12,13 @@
  * All rights reserved. Published under the BSD-2 license in the LICENSE file.
  ******************************************************************************/
 
+#include <thrill/common/defines.hpp>
 #include <thrill/common/logger.hpp>
 #include <thrill/net/tcp/construct.hpp>
+#include <thrill/net/tcp/epoll_dispatcher.hpp>
 #include <thrill/net/tcp/group.hpp>
 #include <thrill/net/tcp/select_dispatcher.hpp>
+#include <thrill/net/tcp/shm_channel.hpp>
 
 #include <random>
 #include <string>
@@ -29,12 +32,23 @@ namespace tcp {
 
 std::unique_ptr<Dispatcher>
 Group::ConstructDispatcher(mem::Manager& mem_manager) const {
+#if THRILL_HAVE_NET_EPOLL
+    // construct tcp::EpollDispatcher, which scales to many connections
+    return std::make_unique<EpollDispatcher>(mem_manager);
+#else
     // construct tcp::SelectDispatcher
     return std::make_unique<SelectDispatcher>(mem_manager);
+#endif
 }
 
 std::vector<std::unique_ptr<Group> > Group::ConstructLoopbackMesh(
-    size_t num_hosts) {
+    size_t num_hosts, bool shared_memory) {
+
+#if THRILL_HAVE_NET_SHM
+    shared_memory = shared_memory && ShmChannel::Enabled();
+#else
+    UNUSED(shared_memory);
+#endif
 
     // construct a group of num_hosts
     std::vector<std::unique_ptr<Group> > group(num_hosts);
@@ -55,6 +69,16 @@ std::vector<std::unique_ptr<Group> > Group::ConstructLoopbackMesh(
 
             group[i]->connections_[j].is_loopback_ = true;
             group[j]->connections_[i].is_loopback_ = true;
+
+#if THRILL_HAVE_NET_SHM
+            if (!shared_memory) continue;
+
+            auto shm = ShmChannel::CreatePair();
+            if (!shm.first) continue;
+
+            group[i]->connections_[j].AttachShm(std::move(shm.first));
+            group[j]->connections_[i].AttachShm(std::move(shm.second));
+#endif
         }
     }
 
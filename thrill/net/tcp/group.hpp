@@ -51,9 +51,12 @@ public:
      * stream sockets for testing. Returns vector of net::Group interfaces for
      * each virtual client. This is ideal for testing network communication
      * protocols.
+     *
+     * If shared_memory is set and shared memory channels are enabled, then
+     * each pair of connections additionally carries its data via a ShmChannel.
      */
     static std::vector<std::unique_ptr<Group> > ConstructLoopbackMesh(
-        size_t num_hosts);
+        size_t num_hosts, bool shared_memory = true);
 
     /*!
      * Construct a test network with an underlying full mesh of *REAL* tcp
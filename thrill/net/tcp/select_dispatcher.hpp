@@ -105,15 +105,16 @@ public:
     void AddRead(net::Connection& c, const Callback& read_cb) final {
         assert(dynamic_cast<Connection*>(&c));
         Connection& tc = static_cast<Connection&>(c);
-        int fd = tc.GetSocket().fd();
-        return AddRead(fd, read_cb);
+        return AddRead(tc.GetReadFd(), read_cb);
     }
 
     //! Register a buffered write callback and a default exception callback.
     void AddWrite(net::Connection& c, const Callback& write_cb) final {
         assert(dynamic_cast<Connection*>(&c));
         Connection& tc = static_cast<Connection&>(c);
-        int fd = tc.GetSocket().fd();
+        int fd = tc.GetWriteFd();
+        // a shared memory channel's notifier is readable if data can be sent
+        if (tc.IsShm()) return AddRead(fd, write_cb);
         CheckSize(fd);
         if (!watch_[fd].write_cb.size()) {
             select_.SetWrite(fd);
@@ -136,11 +137,19 @@ public:
         watch_[fd].except_cb = except_cb;
     }
 
-    //! Cancel all callbacks on a given fd.
+    //! Cancel all callbacks on a given connection.
     void Cancel(net::Connection& c) final {
         assert(dynamic_cast<Connection*>(&c));
         Connection& tc = static_cast<Connection&>(c);
-        int fd = tc.GetSocket().fd();
+        Cancel(tc.GetSocket().fd());
+        if (tc.IsShm()) {
+            Cancel(tc.GetReadFd());
+            Cancel(tc.GetWriteFd());
+        }
+    }
+
+    //! Cancel all callbacks on a given fd.
+    void Cancel(int fd) {
         CheckSize(fd);
 
         if (watch_[fd].read_cb.size() == 0 &&
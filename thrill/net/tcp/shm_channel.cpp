@@ -0,0 +1,432 @@
+/*******************************************************************************
+ * thrill/net/tcp/shm_channel.cpp
+ *
+ * Shared-memory byte stream between two hosts on the same machine.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#include <thrill/net/tcp/shm_channel.hpp>
+
+#if THRILL_HAVE_NET_SHM
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+
+namespace thrill {
+namespace net {
+namespace tcp {
+
+//! one direction of the channel, located in shared memory
+struct ShmChannel::Ring {
+    //! write position, only advanced by the producer
+    alignas(64) std::atomic<uint64_t> tail;
+    //! read position, only advanced by the consumer
+    alignas(64) std::atomic<uint64_t> head;
+    //! set by the producer when it closed the channel
+    alignas(64) std::atomic<uint32_t> closed;
+    //! set by the consumer when it closed the channel
+    std::atomic<uint32_t> reader_closed;
+};
+
+//! header at the beginning of the shared memory segment
+struct ShmChannel::Header {
+    //! magic value to detect broken segments
+    uint64_t magic;
+    //! size of each ring buffer
+    uint64_t ring_size;
+    //! the two rings, followed by their data areas at data_offset
+    ShmChannel::Ring ring[2];
+};
+
+//! process-local mapping of a shared memory segment
+struct ShmChannel::Segment {
+    static constexpr uint64_t magic = 0x54485348594E4331ull;
+    //! offset of ring data behind the header
+    static constexpr size_t data_offset = 4096;
+
+    void* base;
+    size_t size;
+
+    Segment(void* _base, size_t _size) : base(_base), size(_size) { }
+    ~Segment() { munmap(base, size); }
+
+    Header * header() { return static_cast<Header*>(base); }
+
+    uint8_t * data(unsigned i) {
+        return static_cast<uint8_t*>(base)
+               + data_offset + i * header()->ring_size;
+    }
+
+    static size_t Size(size_t ring_size) {
+        return data_offset + 2 * ring_size;
+    }
+
+    //! initialize header of a new segment
+    void Initialize(size_t ring_size) {
+        static_assert(sizeof(Header) <= data_offset, "header too large");
+        Header* h = new (base)Header();
+        h->magic = magic;
+        h->ring_size = ring_size;
+        for (size_t i = 0; i < 2; ++i) {
+            h->ring[i].tail = 0;
+            h->ring[i].head = 0;
+            h->ring[i].closed = 0;
+            h->ring[i].reader_closed = 0;
+        }
+    }
+};
+
+/******************************************************************************/
+// Notifier Helpers
+
+//! signal a notifier: eventfds need exactly eight bytes, FIFOs take them as a
+//! message. If a FIFO is full, the waiting side will wake up anyway.
+static void NotifySignal(int fd) {
+    uint64_t one = 1;
+    while (write(fd, &one, sizeof(one)) < 0 && errno == EINTR) { }
+}
+
+//! reset a notifier by reading it until it is empty
+static void NotifyReset(int fd) {
+    uint64_t buffer[8];
+    while (read(fd, buffer, sizeof(buffer)) > 0) { }
+}
+
+//! list of file name suffixes of a named channel
+static const char* g_shm_suffix[5] = { ".seg", ".d0", ".s0", ".d1", ".s1" };
+
+/******************************************************************************/
+// ShmChannel
+
+ShmChannel::ShmChannel(std::shared_ptr<Segment> segment, unsigned side,
+                       const Notify notify[2])
+    : segment_(std::move(segment)), side_(side) {
+    notify_[0] = notify[0];
+    notify_[1] = notify[1];
+}
+
+ShmChannel::~ShmChannel() {
+    Close();
+    for (size_t i = 0; i < 2; ++i) {
+        ::close(notify_[i].data);
+        ::close(notify_[i].space);
+    }
+}
+
+ShmChannel::Ring& ShmChannel::out_ring() {
+    return segment_->header()->ring[side_];
+}
+
+ShmChannel::Ring& ShmChannel::in_ring() {
+    return segment_->header()->ring[side_ ^ 1];
+}
+
+std::pair<std::unique_ptr<ShmChannel>, std::unique_ptr<ShmChannel> >
+ShmChannel::CreatePair(size_t ring_size) {
+    size_t size = Segment::Size(ring_size);
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+        return std::make_pair(nullptr, nullptr);
+
+    std::shared_ptr<Segment> segment = std::make_shared<Segment>(base, size);
+    segment->Initialize(ring_size);
+
+    // each side closes its own file descriptors
+    Notify n0[2], n1[2];
+    for (size_t i = 0; i < 2; ++i) {
+        n0[i].data = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        n0[i].space = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        n1[i].data = dup(n0[i].data);
+        n1[i].space = dup(n0[i].space);
+        // rings are empty, hence data can be sent, like on a new socket.
+        NotifySignal(n0[i].space);
+    }
+
+    return std::make_pair(
+        std::unique_ptr<ShmChannel>(new ShmChannel(segment, 0, n0)),
+        std::unique_ptr<ShmChannel>(new ShmChannel(segment, 1, n1)));
+}
+
+std::string ShmChannel::MakeName() {
+    static std::atomic<size_t> s_counter { 0 };
+    std::random_device rd;
+    return "/dev/shm/thrill-" + std::to_string(getpid())
+           + "-" + std::to_string(s_counter++) + "-" + std::to_string(rd());
+}
+
+bool ShmChannel::Enabled() {
+    const char* env = getenv("THRILL_NET_SHM");
+    return !env || strcmp(env, "0") != 0;
+}
+
+std::unique_ptr<ShmChannel> ShmChannel::Create(
+    const std::string& name, size_t ring_size) {
+
+    int fd = ::open((name + g_shm_suffix[0]).c_str(),
+                    O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        LOG << "ShmChannel::Create() could not create " << name;
+        return nullptr;
+    }
+
+    size_t size = Segment::Size(ring_size);
+    void* base = MAP_FAILED;
+    if (ftruncate(fd, size) == 0) {
+        base = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+
+    if (base == MAP_FAILED) {
+        Unlink(name);
+        return nullptr;
+    }
+
+    std::shared_ptr<Segment> segment = std::make_shared<Segment>(base, size);
+    segment->Initialize(ring_size);
+
+    for (size_t i = 1; i < 5; ++i) {
+        if (mkfifo((name + g_shm_suffix[i]).c_str(), 0600) != 0) {
+            LOG << "ShmChannel::Create() could not create fifo " << name;
+            Unlink(name);
+            return nullptr;
+        }
+    }
+
+    std::unique_ptr<ShmChannel> ch = Open(name);
+    if (!ch) {
+        Unlink(name);
+        return nullptr;
+    }
+    // Open() maps the segment a second time, keep that mapping.
+    ch->side_ = 0;
+    // rings are empty, hence data can be sent, like on a new socket.
+    NotifySignal(ch->notify_[0].space);
+    NotifySignal(ch->notify_[1].space);
+    return ch;
+}
+
+std::unique_ptr<ShmChannel> ShmChannel::Open(const std::string& name) {
+    int fd = ::open((name + g_shm_suffix[0]).c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    void* base = MAP_FAILED;
+    if (fstat(fd, &st) == 0 &&
+        static_cast<size_t>(st.st_size) > Segment::data_offset) {
+        base = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+
+    if (base == MAP_FAILED) return nullptr;
+
+    std::shared_ptr<Segment> segment =
+        std::make_shared<Segment>(base, st.st_size);
+
+    if (segment->header()->magic != Segment::magic ||
+        Segment::Size(segment->header()->ring_size) != segment->size) {
+        LOG << "ShmChannel::Open() invalid segment " << name;
+        return nullptr;
+    }
+
+    // FIFOs are opened for reading and writing, which does not block and
+    // never signals end-of-file.
+    int fds[4];
+    for (size_t i = 0; i < 4; ++i) {
+        fds[i] = ::open((name + g_shm_suffix[i + 1]).c_str(),
+                        O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if (fds[i] < 0) {
+            while (i > 0) ::close(fds[--i]);
+            return nullptr;
+        }
+    }
+
+    Notify notify[2];
+    notify[0].data = fds[0], notify[0].space = fds[1];
+    notify[1].data = fds[2], notify[1].space = fds[3];
+
+    return std::unique_ptr<ShmChannel>(new ShmChannel(segment, 1, notify));
+}
+
+void ShmChannel::Unlink(const std::string& name) {
+    for (size_t i = 0; i < 5; ++i)
+        ::unlink((name + g_shm_suffix[i]).c_str());
+}
+
+ssize_t ShmChannel::SendOne(const void* data, size_t size) {
+    Ring& r = out_ring();
+    const uint64_t ring_size = segment_->header()->ring_size;
+
+    if (r.reader_closed.load(std::memory_order_acquire)) {
+        errno = EPIPE;
+        return -1;
+    }
+
+    uint64_t tail = r.tail.load(std::memory_order_relaxed);
+    uint64_t free = ring_size - (tail - r.head.load(std::memory_order_acquire));
+
+    if (free == 0) {
+        // reset the space notifier, then check again, since the consumer may
+        // have freed space and signaled in between.
+        NotifyReset(notify_[side_].space);
+        free = ring_size - (tail - r.head.load(std::memory_order_seq_cst));
+        if (free == 0) {
+            errno = EAGAIN;
+            return -1;
+        }
+        NotifySignal(notify_[side_].space);
+    }
+
+    size_t n = std::min<uint64_t>(size, free);
+    size_t pos = tail % ring_size;
+    size_t first = std::min<size_t>(n, ring_size - pos);
+
+    const uint8_t* cdata = static_cast<const uint8_t*>(data);
+    uint8_t* ring_data = segment_->data(side_);
+    memcpy(ring_data + pos, cdata, first);
+    memcpy(ring_data, cdata + first, n - first);
+
+    r.tail.store(tail + n, std::memory_order_seq_cst);
+    // only signal if the ring was empty: otherwise the consumer has not yet
+    // observed an empty ring and reset the notifier, or it will see the new
+    // tail when checking again after the reset.
+    uint64_t head = r.head.load(std::memory_order_seq_cst);
+    if (head == tail)
+        NotifySignal(notify_[side_].data);
+
+    // if the ring is full now, the caller waits for the next edge of the
+    // space notifier. the consumer may have freed space before it saw our
+    // tail and hence not signaled, so generate the edge ourselves.
+    if (n == free && head != tail + n - ring_size)
+        NotifySignal(notify_[side_].space);
+
+    return static_cast<ssize_t>(n);
+}
+
+ssize_t ShmChannel::RecvOne(void* out_data, size_t size) {
+    Ring& r = in_ring();
+    const uint64_t ring_size = segment_->header()->ring_size;
+
+    uint64_t head = r.head.load(std::memory_order_relaxed);
+    uint64_t avail = r.tail.load(std::memory_order_acquire) - head;
+
+    if (avail == 0) {
+        // reset the data notifier, then check again, since the producer may
+        // have written data and signaled in between.
+        NotifyReset(notify_[side_ ^ 1].data);
+        avail = r.tail.load(std::memory_order_seq_cst) - head;
+        if (avail == 0) {
+            if (!r.closed.load(std::memory_order_seq_cst)) {
+                errno = EAGAIN;
+                return -1;
+            }
+            // the producer closed, all data written before is visible now.
+            avail = r.tail.load(std::memory_order_seq_cst) - head;
+            if (avail == 0) {
+                // keep notifier readable at end-of-stream, like a socket.
+                NotifySignal(notify_[side_ ^ 1].data);
+                errno = 0;
+                return 0;
+            }
+        }
+        NotifySignal(notify_[side_ ^ 1].data);
+    }
+
+    size_t n = std::min<uint64_t>(size, avail);
+    size_t pos = head % ring_size;
+    size_t first = std::min<size_t>(n, ring_size - pos);
+
+    uint8_t* cdata = static_cast<uint8_t*>(out_data);
+    const uint8_t* ring_data = segment_->data(side_ ^ 1);
+    memcpy(cdata, ring_data + pos, first);
+    memcpy(cdata + first, ring_data, n - first);
+
+    r.head.store(head + n, std::memory_order_seq_cst);
+    // only signal if the ring was full, see SendOne().
+    uint64_t tail = r.tail.load(std::memory_order_seq_cst);
+    if (tail - head == ring_size)
+        NotifySignal(notify_[side_ ^ 1].space);
+
+    // if the ring is empty now, the caller waits for the next edge of the data
+    // notifier, see SendOne().
+    if (n == avail && tail != head + n)
+        NotifySignal(notify_[side_ ^ 1].data);
+
+    return static_cast<ssize_t>(n);
+}
+
+void ShmChannel::WaitFd(int fd) {
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    while (poll(&pfd, 1, -1) < 0 && errno == EINTR) { }
+}
+
+ssize_t ShmChannel::SyncSend(const void* data, size_t size) {
+    const uint8_t* cdata = static_cast<const uint8_t*>(data);
+    size_t wb = 0;
+    while (wb < size) {
+        ssize_t r = SendOne(cdata + wb, size - wb);
+        if (r < 0) {
+            if (errno != EAGAIN) return -1;
+            WaitFd(write_fd());
+            continue;
+        }
+        wb += r;
+    }
+    return static_cast<ssize_t>(wb);
+}
+
+ssize_t ShmChannel::SyncRecv(void* out_data, size_t size) {
+    uint8_t* cdata = static_cast<uint8_t*>(out_data);
+    size_t rb = 0;
+    while (rb < size) {
+        ssize_t r = RecvOne(cdata + rb, size - rb);
+        if (r < 0) {
+            if (errno != EAGAIN) return -1;
+            WaitFd(read_fd());
+            continue;
+        }
+        if (r == 0) break;
+        rb += r;
+    }
+    return static_cast<ssize_t>(rb);
+}
+
+void ShmChannel::Close() {
+    if (closed_) return;
+    closed_ = true;
+
+    out_ring().closed.store(1, std::memory_order_seq_cst);
+    in_ring().reader_closed.store(1, std::memory_order_seq_cst);
+
+    // wake up the peer's reader and writer
+    NotifySignal(notify_[side_].data);
+    NotifySignal(notify_[side_ ^ 1].space);
+}
+
+} // namespace tcp
+} // namespace net
+} // namespace thrill
+
+#endif // THRILL_HAVE_NET_SHM
+
+/******************************************************************************/
@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * thrill/net/tcp/shm_channel.hpp
+ *
+ * Shared-memory byte stream between two hosts on the same machine.
+ *
+ * Part of Project Thrill - http://project-thrill.org
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * All rights reserved. Published under the BSD-2 license in the LICENSE file.
+ ******************************************************************************/
+
+#pragma once
+#ifndef THRILL_NET_TCP_SHM_CHANNEL_HEADER
+#define THRILL_NET_TCP_SHM_CHANNEL_HEADER
+
+#include <thrill/common/config.hpp>
+
+#if THRILL_HAVE_NET_SHM
+
+#include <thrill/common/logger.hpp>
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace thrill {
+namespace net {
+namespace tcp {
+
+//! \addtogroup net_tcp TCP Socket API
+//! \{
+
+/*!
+ * ShmChannel is a bidirectional byte stream between two hosts on the same
+ * machine, which replaces the data path of a tcp::Connection. It consists of
+ * two single-producer single-consumer ring buffers in a shared memory segment,
+ * one per direction, hence data is copied once into and once out of the ring
+ * instead of through the kernel's socket buffers.
+ *
+ * Readiness is signaled by four notifier file descriptors (eventfds within one
+ * process, FIFOs between processes), which the dispatchers watch for
+ * readability: read_fd() is readable while the incoming ring is not empty, and
+ * write_fd() is readable while the outgoing ring is not full. A notifier is
+ * only reset by its waiting side after observing an empty (full) ring, and
+ * rearmed if the ring changed during the reset, hence no wakeups are lost.
+ * Conversely, a notifier is only signaled on the transition from an empty
+ * (full) ring, which saves a system call per SendOne() and RecvOne() while
+ * both sides keep up. Since the dispatchers wait for edges, a side which
+ * drained (filled) the ring signals its own notifier if the peer changed the
+ * ring concurrently without seeing the transition.
+ */
+class ShmChannel
+{
+    static constexpr bool debug = false;
+
+public:
+    //! default size of each of the two ring buffers
+    static constexpr size_t default_ring_size = 1024 * 1024;
+
+    //! Create a connected pair of channels within this process, which use
+    //! anonymous shared memory and eventfds.
+    static std::pair<std::unique_ptr<ShmChannel>, std::unique_ptr<ShmChannel> >
+    CreatePair(size_t ring_size = default_ring_size);
+
+    //! Create the named shared memory segment and notifiers of a channel for a
+    //! peer process. Returns nullptr if this fails.
+    static std::unique_ptr<ShmChannel> Create(
+        const std::string& name, size_t ring_size = default_ring_size);
+
+    //! Open the other side of a channel created by a peer process with
+    //! Create(). Returns nullptr if this fails.
+    static std::unique_ptr<ShmChannel> Open(const std::string& name);
+
+    //! Remove the names of a channel from the file system, after both sides
+    //! have opened it.
+    static void Unlink(const std::string& name);
+
+    //! Construct a new unique name for Create().
+    static std::string MakeName();
+
+    //! Whether shared memory channels are used for peers on the same machine,
+    //! which can be disabled by setting THRILL_NET_SHM=0.
+    static bool Enabled();
+
+    //! close channel and unmap memory
+    ~ShmChannel();
+
+    //! non-copyable: delete copy-constructor
+    ShmChannel(const ShmChannel&) = delete;
+    //! non-copyable: delete assignment operator
+    ShmChannel& operator = (const ShmChannel&) = delete;
+
+    //! Copy up to size bytes into the outgoing ring. Returns -1 and sets errno
+    //! to EAGAIN if the ring is full, or to EPIPE if the peer closed.
+    ssize_t SendOne(const void* data, size_t size);
+
+    //! Copy up to size bytes from the incoming ring. Returns -1 and sets errno
+    //! to EAGAIN if the ring is empty, or 0 with errno = 0 if the peer closed.
+    ssize_t RecvOne(void* out_data, size_t size);
+
+    //! Send all bytes, blocking while the outgoing ring is full.
+    ssize_t SyncSend(const void* data, size_t size);
+
+    //! Receive exactly size bytes, blocking while the incoming ring is empty.
+    ssize_t SyncRecv(void* out_data, size_t size);
+
+    //! file descriptor which is readable while data can be received.
+    int read_fd() const { return notify_[side_ ^ 1].data; }
+
+    //! file descriptor which is readable while data can be sent.
+    int write_fd() const { return notify_[side_].space; }
+
+    //! Mark both directions as closed and wake up the peer.
+    void Close();
+
+private:
+    struct Ring;
+    struct Header;
+    struct Segment;
+
+    //! notifier file descriptors of one ring
+    struct Notify {
+        //! readable while the ring is not empty
+        int data = -1;
+        //! readable while the ring is not full
+        int space = -1;
+    };
+
+    ShmChannel(std::shared_ptr<Segment> segment, unsigned side,
+               const Notify notify[2]);
+
+    //! shared memory segment, shared by both channels of a CreatePair().
+    std::shared_ptr<Segment> segment_;
+
+    //! side of the channel: sends via ring[side_], receives via ring[side_^1]
+    unsigned side_;
+
+    //! notifiers of the two rings
+    Notify notify_[2];
+
+    //! whether Close() was called
+    bool closed_ = false;
+
+    //! outgoing and incoming ring
+    Ring& out_ring();
+    Ring& in_ring();
+
+    //! Wait until the notifier fd is readable.
+    static void WaitFd(int fd);
+};
+
+//! \}
+
+} // namespace tcp
+} // namespace net
+} // namespace thrill
+
+#endif // THRILL_HAVE_NET_SHM
+
+#endif // !THRILL_NET_TCP_SHM_CHANNEL_HEADER
+
+/******************************************************************************/
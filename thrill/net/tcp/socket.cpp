@@ -10,12 +10,17 @@
  * All rights reserved. Published under the BSD-2 license in the LICENSE file.
  ******************************************************************************/
 
+#include <thrill/common/defines.hpp>
 #include <thrill/net/tcp/socket.hpp>
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 
+#if __linux__
+#include <linux/errqueue.h>
+#endif
+
 namespace thrill {
 namespace net {
 namespace tcp {
@@ -128,6 +133,66 @@ void Socket::SetRcvBuf(size_t size) {
 #endif
 }
 
+bool Socket::SetZeroCopy(bool activate) {
+    assert(IsValid());
+
+#if __linux__ && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    int sockoptflag = (activate ? 1 : 0);
+
+    /* SO_ZEROCOPY allows send() and sendmsg() with MSG_ZEROCOPY, which pin the
+       user pages instead of copying them into the socket buffer. The pages
+       must not be modified until the kernel posts a completion notification
+       on the socket's error queue. */
+    if (::setsockopt(fd_, SOL_SOCKET, SO_ZEROCOPY,
+                     &sockoptflag, sizeof(sockoptflag)) != 0)
+    {
+        LOG << "Cannot set SO_ZEROCOPY on socket fd " << fd_
+            << ": " << strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    return !activate;
+#endif
+}
+
+bool Socket::RecvZeroCopyCompletion(uint32_t* lo, uint32_t* hi, bool* copied) {
+    assert(IsValid());
+
+#if __linux__ && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    char control[128];
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    if (::recvmsg(fd_, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+        return false;
+
+    for (struct cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm != nullptr;
+         cm = CMSG_NXTHDR(&msg, cm))
+    {
+        if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+              (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR)))
+            continue;
+
+        const struct sock_extended_err* serr =
+            reinterpret_cast<const struct sock_extended_err*>(CMSG_DATA(cm));
+        if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+            continue;
+
+        *lo = serr->ee_info;
+        *hi = serr->ee_data;
+        *copied = (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+        return true;
+    }
+    return false;
+#else
+    UNUSED(lo), UNUSED(hi), UNUSED(copied);
+    return false;
+#endif
+}
+
 } // namespace tcp
 } // namespace net
 } // namespace thrill
@@ -22,6 +22,7 @@
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <cassert>
@@ -369,6 +370,30 @@ public:
         return r;
     }
 
+    //! Send a vector of memory areas to socket (BSD sendmsg() wrapper), which
+    //! returns the total number of bytes sent.
+    ssize_t sendmsg_one(const struct iovec* iov, size_t iovcnt, int flags = 0) {
+        assert(IsValid());
+
+        LOG << "Socket::sendmsg_one()"
+            << " fd_=" << fd_
+            << " iovcnt=" << iovcnt
+            << " flags=" << flags;
+
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = const_cast<struct iovec*>(iov);
+        msg.msg_iovlen = iovcnt;
+
+        ssize_t r = ::sendmsg(fd_, &msg, flags);
+
+        LOG << "done Socket::sendmsg_one()"
+            << " fd_=" << fd_
+            << " return=" << r;
+
+        return r;
+    }
+
     //! Send (data,size) to socket, retry sends if short-sends occur.
     ssize_t send(const void* data, size_t size, int flags = 0) {
         assert(IsValid());
@@ -594,6 +619,15 @@ public:
     //! Set SO_RCVBUF socket option.
     void SetRcvBuf(size_t size);
 
+    //! Enable SO_ZEROCOPY, which allows sending with MSG_ZEROCOPY. Returns
+    //! false if the kernel does not support it.
+    bool SetZeroCopy(bool activate = true);
+
+    //! Receive one zero-copy completion notification from the error queue,
+    //! which releases the sends [lo,hi]. copied is set if the kernel copied the
+    //! data anyway. Returns false if no notification is queued.
+    bool RecvZeroCopyCompletion(uint32_t* lo, uint32_t* hi, bool* copied);
+
     //! \}
 
 private: